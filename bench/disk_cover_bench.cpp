@@ -0,0 +1,190 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "disk_cover.hpp"
+
+namespace {
+    using ivarp::IDouble;
+
+    struct Options {
+        std::size_t iterations = 2000;
+    };
+
+    struct Scenario {
+        std::string name;
+        std::vector<Point> polygon;
+        std::vector<Circle> disks;
+        bool expect_covered;
+    };
+
+    void usage(const char* program) {
+        std::cerr << "Usage: " << program << " [--iterations N]" << std::endl;
+    }
+
+    bool parse_options(int argc, char** argv, Options& options) {
+        for(int i = 1; i < argc; ++i) {
+            if(std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+                options.iterations = std::strtoull(argv[++i], nullptr, 10);
+            } else {
+                return false;
+            }
+        }
+        return options.iterations > 0;
+    }
+
+    /// The circumcenter of the triangle (0,0), (1,0), (x,y).
+    Point circumcenter(IDouble x, IDouble y) {
+        return Point{IDouble(0.5), (square(x) + square(y) - x) / (2.0 * y)};
+    }
+
+    /**
+     * The acute triangle (0,0), (1,0), (x,y) with the three disks on the segments
+     * from the vertices to the circumcenter as diameters, radii scaled by factor;
+     * the disks cover the triangle exactly for factor 1.
+     */
+    Scenario thales_triangle(const char* name, IDouble x, IDouble y, double factor, bool expect_covered) {
+        Scenario s;
+        s.name = name;
+        s.polygon = {Point{IDouble(0.0), IDouble(0.0)}, Point{IDouble(1.0), IDouble(0.0)}, Point{x, y}};
+        Point center = circumcenter(x, y);
+        for(const Point& v : s.polygon) {
+            IDouble r = 0.5 * sqrt(squared_distance(v, center));
+            s.disks.push_back(Circle{center_of(v, center), factor * r});
+        }
+        s.expect_covered = expect_covered;
+        return s;
+    }
+
+    /**
+     * The rectangle [0,2] x [0,1] with two disks of radius r through points slightly
+     * beyond the corners of its short sides; they cover the rectangle iff r >= 0.7214 (approximately).
+     */
+    Scenario rectangle_pair(const char* name, IDouble r, bool expect_covered) {
+        Scenario s;
+        s.name = name;
+        s.polygon = {Point{IDouble(0.0), IDouble(0.0)}, Point{IDouble(2.0), IDouble(0.0)},
+                     Point{IDouble(2.0), IDouble(1.0)}, Point{IDouble(0.0), IDouble(1.0)}};
+        Point l0{IDouble(-0.02), IDouble(-0.02)}, l1{IDouble(-0.02), IDouble(1.02)};
+        Point r0{IDouble(2.02), IDouble(-0.02)}, r1{IDouble(2.02), IDouble(1.02)};
+        s.disks = {disk_through(l0, l1, r), disk_through(r1, r0, r)};
+        s.expect_covered = expect_covered;
+        return s;
+    }
+
+    /**
+     * The unit equilateral triangle with disks of radius r around its vertices;
+     * for 1/2 < r < 1/sqrt(3), they cover the edges but not the centroid.
+     */
+    Scenario vertex_disks(const char* name, IDouble r) {
+        Scenario s;
+        s.name = name;
+        s.polygon = {Point{IDouble(0.0), IDouble(0.0)}, Point{IDouble(1.0), IDouble(0.0)},
+                     Point{IDouble(0.5), 0.5 * sqrt(IDouble(3.0))}};
+        for(const Point& v : s.polygon) {
+            s.disks.push_back(Circle{v, r});
+        }
+        s.expect_covered = false;
+        return s;
+    }
+
+    DiskCoverProblem problem_of(const Scenario& s) {
+        return DiskCoverProblem{s.polygon.data(), s.polygon.size(), s.disks.data(), s.disks.size()};
+    }
+
+    const char* result_name(ivarp::IBool b) {
+        return definitely(b) ? "covered" : (!possibly(b) ? "not covered" : "indeterminate");
+    }
+
+    template<typename Callable> double ns_per_call(std::size_t iterations, Callable&& callable) {
+        auto before = std::chrono::steady_clock::now();
+        for(std::size_t i = 0; i < iterations; ++i) {
+            callable();
+        }
+        auto after = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(after - before).count() / double(iterations);
+    }
+}
+
+/**
+ * Time the disk cover engine on placements with known coverage
+ * and on a batch of perturbed placements.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    if(!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    ivarp::setup_floating_point_environment();
+
+    std::vector<Scenario> scenarios;
+    scenarios.push_back(thales_triangle("thales", IDouble(0.4), IDouble(0.8), 1.05, true));
+    scenarios.push_back(thales_triangle("thales_shrunk", IDouble(0.4), IDouble(0.8), 0.97, false));
+    scenarios.push_back(thales_triangle("thales_interval", IDouble(0.399, 0.401), IDouble(0.799, 0.801), 1.05, true));
+    scenarios.push_back(rectangle_pair("rectangle_pair", IDouble(0.75, 0.7501), true));
+    scenarios.push_back(rectangle_pair("rectangle_pair_small", IDouble(0.70, 0.7001), false));
+    scenarios.push_back(vertex_disks("vertex_disks", IDouble(0.55, 0.5501)));
+
+    DiskCoverEngine engine;
+    bool ok = true;
+    for(const Scenario& s : scenarios) {
+        DiskCoverProblem problem = problem_of(s);
+        ivarp::IBool result = engine.covers(problem);
+        DiskCoverStats stats = engine.last_stats();
+        double ns = ns_per_call(options.iterations, [&] () { engine.covers(problem); });
+        bool expected = s.expect_covered ? definitely(result) : !possibly(result);
+        ok = ok && expected;
+        std::cout << std::left << std::setw(22) << s.name << std::right << std::setw(14) << result_name(result)
+                  << std::fixed << std::setprecision(0) << std::setw(10) << ns << " ns/call, "
+                  << stats.cells << " cells, depth " << stats.max_depth << (stats.edge_gap ? ", edge gap" : "")
+                  << (expected ? "" : ", UNEXPECTED") << std::defaultfloat << std::endl;
+    }
+
+    // a batch of boxes around the apex with slightly enlarged disks
+    std::vector<Scenario> batch;
+    for(int i = 0; i < 16; ++i) {
+        for(int j = 0; j < 16; ++j) {
+            double x = 0.3 + 0.025 * i, y = 0.6 + 0.025 * j;
+            batch.push_back(thales_triangle("batch", IDouble(x, x + 0.002), IDouble(y, y + 0.002), 1.05, true));
+        }
+    }
+    std::vector<DiskCoverProblem> problems;
+    for(const Scenario& s : batch) {
+        problems.push_back(problem_of(s));
+    }
+    std::vector<ivarp::IBool> results(problems.size());
+    std::size_t batch_iterations = (options.iterations + problems.size() - 1) / problems.size();
+    double ns = ns_per_call(batch_iterations, [&] () { engine.covers(problems.data(), results.data(), problems.size()); });
+    std::size_t covered = 0, uncovered = 0;
+    for(ivarp::IBool r : results) {
+        covered += definitely(r);
+        uncovered += !possibly(r);
+    }
+    std::cout << std::left << std::setw(22) << "batch" << std::right << std::fixed << std::setprecision(0)
+              << std::setw(24) << ns / double(problems.size()) << " ns/problem, " << covered << " covered, "
+              << uncovered << " not covered, " << (problems.size() - covered - uncovered) << " indeterminate of "
+              << problems.size() << std::defaultfloat << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <fcntl.h>
+#include <functional>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * A child process started by start_isolated.
+ */
+struct IsolatedRun {
+    pid_t pid = -1;
+    int read_fd = -1;
+};
+
+/**
+ * Fork a child that runs body with its standard output and error redirected to /dev/null,
+ * and sends the string returned by body back to the parent.
+ * Running each proof in its own process gives every run the same initial state
+ * and lets the parent measure its peak RSS.
+ */
+inline IsolatedRun start_isolated(const std::function<std::string()>& body) {
+    IsolatedRun run;
+    int pipe_fds[2];
+    if(::pipe(pipe_fds) != 0) {
+        return run;
+    }
+    pid_t pid = ::fork();
+    if(pid < 0) {
+        ::close(pipe_fds[0]);
+        ::close(pipe_fds[1]);
+        return run;
+    }
+    if(pid == 0) {
+        ::close(pipe_fds[0]);
+        // the proofs print their results, statistics and counterexample boxes; keep them out of the tool's output
+        int null_fd = ::open("/dev/null", O_WRONLY);
+        if(null_fd >= 0) {
+            ::dup2(null_fd, STDOUT_FILENO);
+            ::dup2(null_fd, STDERR_FILENO);
+        }
+        std::string message = body();
+        ssize_t written = ::write(pipe_fds[1], message.data(), message.size());
+        ::_exit(written == ssize_t(message.size()) ? 0 : 1);
+    }
+    ::close(pipe_fds[1]);
+    run.pid = pid;
+    run.read_fd = pipe_fds[0];
+    return run;
+}
+
+/**
+ * Wait for a child started by start_isolated; returns false if it could not be
+ * started or did not exit normally. The resource usage of the child
+ * (CPU time, peak RSS) is stored in usage.
+ */
+inline bool finish_isolated(const IsolatedRun& run, std::string& message, struct rusage& usage) {
+    if(run.pid < 0) {
+        return false;
+    }
+    message.clear();
+    char buffer[4096];
+    ssize_t r;
+    while((r = ::read(run.read_fd, buffer, sizeof(buffer))) > 0) {
+        message.append(buffer, std::size_t(r));
+    }
+    ::close(run.read_fd);
+    int status;
+    if(::wait4(run.pid, &status, 0, &usage) != run.pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return false;
+    }
+    return true;
+}
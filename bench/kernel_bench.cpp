@@ -0,0 +1,243 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "generated/below_45_isoceles_derivatives_kernels.hpp"
+#include "generated/r1_in_center_kernels.hpp"
+#include "generated/two_large_disks_kernels.hpp"
+
+namespace {
+    using ivarp::IDouble;
+
+    struct Options {
+        std::size_t boxes = 4096;
+        std::size_t repetitions = 50;
+    };
+
+    void usage(const char* program) {
+        std::cerr << "Usage: " << program << " [--boxes N] [--repetitions N]" << std::endl;
+    }
+
+    bool parse_options(int argc, char** argv, Options& options) {
+        for(int i = 1; i < argc; ++i) {
+            if(std::strcmp(argv[i], "--boxes") == 0 && i + 1 < argc) {
+                options.boxes = std::strtoull(argv[++i], nullptr, 10);
+            } else if(std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc) {
+                options.repetitions = std::strtoull(argv[++i], nullptr, 10);
+            } else {
+                return false;
+            }
+        }
+        return options.boxes > 0 && options.repetitions > 0;
+    }
+
+    /// Random intervals of relative width about 2^-10 in [lb, ub].
+    std::vector<IDouble> random_intervals(std::mt19937_64& rng, double lb, double ub, std::size_t n) {
+        std::uniform_real_distribution<double> dist(lb, ub);
+        std::vector<IDouble> result;
+        for(std::size_t i = 0; i < n; ++i) {
+            double x = dist(rng), w = (ub - lb) * 0.0009765625;
+            result.emplace_back((std::max)(lb, x - w), (std::min)(ub, x + w));
+        }
+        return result;
+    }
+
+    template<typename Callable> double ns_per_box(const Options& options, Callable&& callable) {
+        auto before = std::chrono::steady_clock::now();
+        for(std::size_t r = 0; r < options.repetitions; ++r) {
+            callable();
+        }
+        auto after = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(after - before).count() /
+               double(options.repetitions * options.boxes);
+    }
+
+    double width(IDouble x) {
+        return x.ub() - x.lb();
+    }
+
+    struct Comparison {
+        double width_ratio = 0.0;   //< mean width of the generated result relative to the reference
+        bool consistent = true;     //< whether all pairs of results intersect
+    };
+
+    void compare(Comparison& c, IDouble generated, IDouble reference, std::size_t n) {
+        if(possibly_undefined(generated) || possibly_undefined(reference)) {
+            return;
+        }
+        if(generated.ub() < reference.lb() || reference.ub() < generated.lb()) {
+            c.consistent = false;
+        }
+        if(width(reference) > 0.0) {
+            c.width_ratio += width(generated) / width(reference) / double(n);
+        }
+    }
+
+    bool report(const char* name, double generated_ns, double reference_ns, const Comparison& c) {
+        std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(8) << generated_ns << " ns";
+        if(reference_ns > 0.0) {
+            std::cout << " (reference " << reference_ns << " ns), width " << std::setprecision(3)
+                      << c.width_ratio << " of reference";
+        }
+        std::cout << (c.consistent ? "" : ", INCONSISTENT") << std::defaultfloat << std::endl;
+        return c.consistent;
+    }
+}
+
+/**
+ * Time the generated interval kernels against their plain translations
+ * (namespace reference_kernels) on random boxes, and compare the result widths.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    if(!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    ivarp::setup_floating_point_environment();
+    const std::size_t n = options.boxes;
+    std::mt19937_64 rng(20221018);
+    std::vector<IDouble> alpha_deriv = random_intervals(rng, 0.7679448708775049, 0.7853981633974483, n);
+    std::vector<IDouble> r1_deriv = random_intervals(rng, 0.48, 0.5, n);
+    std::vector<IDouble> r2_deriv = random_intervals(rng, 0.48, 0.5, n);
+    std::vector<IDouble> alpha = random_intervals(rng, 0.345, 0.785, n);
+    std::vector<IDouble> r1 = random_intervals(rng, 0.3, 0.5, n);
+    std::vector<IDouble> out(n), ref(n);
+    volatile double sink = 0.0;
+    bool ok = true;
+
+    {
+        Comparison c;
+        double g = ns_per_box(options, [&] () {
+            diff_restweight_by_r1(alpha_deriv.data(), r1_deriv.data(), r2_deriv.data(), out.data(), n);
+        });
+        double r = ns_per_box(options, [&] () {
+            for(std::size_t i = 0; i < n; ++i) {
+                ref[i] = reference_kernels::diff_restweight_by_r1(alpha_deriv[i], r1_deriv[i], r2_deriv[i]);
+            }
+        });
+        for(std::size_t i = 0; i < n; ++i) {
+            compare(c, out[i], ref[i], n);
+        }
+        ok = report("diff_restweight_by_r1", g, r, c) && ok;
+    }
+    {
+        Comparison c;
+        double g = ns_per_box(options, [&] () {
+            diff_restweight_by_r2(alpha_deriv.data(), r2_deriv.data(), out.data(), n);
+        });
+        double r = ns_per_box(options, [&] () {
+            for(std::size_t i = 0; i < n; ++i) {
+                ref[i] = reference_kernels::diff_restweight_by_r2(alpha_deriv[i], r2_deriv[i]);
+            }
+        });
+        for(std::size_t i = 0; i < n; ++i) {
+            compare(c, out[i], ref[i], n);
+        }
+        ok = report("diff_restweight_by_r2", g, r, c) && ok;
+    }
+    {
+        Comparison c;
+        double g = ns_per_box(options, [&] () {
+            diff_restweight_by_alpha(alpha_deriv.data(), out.data(), n);
+        });
+        double r = ns_per_box(options, [&] () {
+            for(std::size_t i = 0; i < n; ++i) {
+                ref[i] = reference_kernels::diff_restweight_by_alpha(alpha_deriv[i]);
+            }
+        });
+        for(std::size_t i = 0; i < n; ++i) {
+            compare(c, out[i], ref[i], n);
+        }
+        ok = report("diff_restweight_by_alpha", g, r, c) && ok;
+    }
+    {
+        // the difference quotient over a box lies in the derivative's enclosure on the box
+        Comparison c;
+        double g = ns_per_box(options, [&] () {
+            for(std::size_t i = 0; i < n; ++i) {
+                sink = sink + diff_restweight_by_alpha_with_derivatives(alpha_deriv[i]).d_value_d_alpha.lb();
+            }
+        });
+        for(std::size_t i = 0; i < n; ++i) {
+            IDouble a = alpha_deriv[i];
+            IDouble quotient = (diff_restweight_by_alpha(IDouble(a.ub())) - diff_restweight_by_alpha(IDouble(a.lb()))) /
+                               (IDouble(a.ub()) - IDouble(a.lb()));
+            compare(c, diff_restweight_by_alpha_with_derivatives(a).d_value_d_alpha, quotient, n);
+        }
+        ok = report("diff_restweight_by_alpha (derivative)", g, 0.0, c) && ok;
+    }
+    {
+        Comparison c;
+        double g = ns_per_box(options, [&] () {
+            for(std::size_t i = 0; i < n; ++i) {
+                R1InCenterChi1 chi = r1_in_center_chi1(alpha[i], r1[i]);
+                out[i] = r1_in_center_remaining_sizes(chi.sin_half_alpha, chi.cos_half_alpha,
+                                                      ivarp::tan(0.5 * alpha[i]), ivarp::cos(alpha[i]),
+                                                      r1[i]).remaining_pocket_height;
+            }
+        });
+        double r = ns_per_box(options, [&] () {
+            for(std::size_t i = 0; i < n; ++i) {
+                R1InCenterChi1 chi = reference_kernels::r1_in_center_chi1(alpha[i], r1[i]);
+                ref[i] = reference_kernels::r1_in_center_remaining_sizes(
+                    chi.sin_half_alpha, chi.cos_half_alpha, ivarp::tan(0.5 * alpha[i]), ivarp::cos(alpha[i]), r1[i]
+                ).remaining_pocket_height;
+            }
+        });
+        for(std::size_t i = 0; i < n; ++i) {
+            compare(c, out[i], ref[i], n);
+        }
+        ok = report("r1_in_center", g, r, c) && ok;
+    }
+    {
+        Comparison c;
+        auto run = [&] (std::vector<IDouble>& result, bool reference) {
+            for(std::size_t i = 0; i < n; ++i) {
+                IDouble tan_half = ivarp::tan(0.5 * alpha[i]);
+                IDouble r1sq = ivarp::square(r1[i]);
+                IDouble r1w = 0.25 / tan_half - 0.25 * (1.0 + ivarp::cos(alpha[i]));
+                IDouble r1wsq = ivarp::square(r1w);
+                IDouble r1hsq = r1sq - r1wsq;
+                r1hsq.restrict_lb(0.0);
+                IDouble r1h = ivarp::sqrt(r1hsq);
+                IDouble d = reference ?
+                    reference_kernels::two_large_disks_top_discriminant(r1sq, r1hsq, r1wsq, r1w, r1h, tan_half) :
+                    two_large_disks_top_discriminant(r1sq, r1hsq, r1wsq, r1w, r1h, tan_half);
+                d = IDouble(d.lb() < 0.0 ? 0.0 : d.lb(), d.ub() < 0.0 ? 0.0 : d.ub());
+                result[i] = reference ?
+                    reference_kernels::two_large_disks_top_intersections(alpha[i], r1w, r1h, tan_half, d).left_x_u :
+                    two_large_disks_top_intersections(alpha[i], r1w, r1h, tan_half, d).left_x_u;
+            }
+        };
+        double g = ns_per_box(options, [&] () { run(out, false); });
+        double r = ns_per_box(options, [&] () { run(ref, true); });
+        for(std::size_t i = 0; i < n; ++i) {
+            compare(c, out[i], ref[i], n);
+        }
+        ok = report("two_large_disks", g, r, c) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ablation.hpp"
+#include "isolated_run.hpp"
+#include "proof_registry.hpp"
+#include "proof_stats.hpp"
+#include "progress.hpp"
+
+namespace {
+    struct Options {
+        std::string proof;
+        std::size_t jobs = 0;
+        std::uint64_t max_nodes = 0;
+        double max_seconds = 0.0;
+        double node_budget_factor = 10.0;
+    };
+
+    struct AblationRun {
+        std::vector<std::size_t> disabled;
+        bool ok = false;
+        bool proved = false;
+        bool budget_exceeded = false;
+        std::uint64_t nodes = 0;
+        double cpu_seconds = 0.0;
+        std::vector<ConstraintStats> constraints;
+    };
+
+    void usage(const char* program) {
+        std::cerr << "Usage: " << program << " --proof NAME [--jobs J] [--max-nodes N | --budget-factor F]"
+                  << " [--max-seconds SECONDS]" << std::endl;
+    }
+
+    IsolatedRun start_run(const ProofEntry& proof, const AblationRun& run, std::uint64_t max_nodes, double max_seconds) {
+        return start_isolated([&] () {
+            AblationOptions& ablation = default_ablation_options();
+            ablation.proof = proof.name;
+            ablation.disabled_constraints = run.disabled;
+            ablation.max_nodes = max_nodes;
+            ablation.max_seconds = max_seconds;
+            default_progress_options().print_progress = false;
+            ivarp::setup_floating_point_environment();
+            proof.run();
+            const std::vector<ProofRunRecord>& records = proof_run_records();
+            auto record = std::find_if(records.rbegin(), records.rend(),
+                                       [&] (const ProofRunRecord& r) { return r.name == proof.name; });
+            std::ostringstream message;
+            if(record == records.rend()) {
+                return std::string{};
+            }
+            // one line per constraint, with the name last because it may contain spaces
+            message << (record->proved ? 1 : 0) << ' ' << (record->budget_exceeded ? 1 : 0) << ' '
+                    << record->nodes << ' ' << record->constraints.size() << '\n';
+            for(const ConstraintStats& c : record->constraints) {
+                message << c.evaluations << ' ' << c.cost << ' ' << c.name << '\n';
+            }
+            return message.str();
+        });
+    }
+
+    bool finish_run(const IsolatedRun& child, AblationRun& run) {
+        std::string message;
+        struct rusage usage;
+        if(!finish_isolated(child, message, usage)) {
+            return false;
+        }
+        std::istringstream input(message);
+        int proved, budget_exceeded;
+        std::size_t num_constraints;
+        if(!(input >> proved >> budget_exceeded >> run.nodes >> num_constraints)) {
+            return false;
+        }
+        for(std::size_t i = 0; i < num_constraints; ++i) {
+            ConstraintStats c;
+            if(!(input >> c.evaluations >> c.cost)) {
+                return false;
+            }
+            input.get();
+            std::getline(input, c.name);
+            run.constraints.push_back(c);
+        }
+        run.ok = true;
+        run.proved = (proved != 0);
+        run.budget_exceeded = (budget_exceeded != 0);
+        run.cpu_seconds = double(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+                          1.0e-6 * double(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+        return true;
+    }
+
+    /**
+     * Run the given ablations with at most jobs child processes at a time.
+     */
+    void run_all(const ProofEntry& proof, std::vector<AblationRun>& runs, std::size_t jobs,
+                 std::uint64_t max_nodes, double max_seconds)
+    {
+        std::deque<std::pair<std::size_t, IsolatedRun>> running;
+        std::size_t next = 0;
+        while(next < runs.size() || !running.empty()) {
+            while(next < runs.size() && running.size() < jobs) {
+                running.emplace_back(next, start_run(proof, runs[next], max_nodes, max_seconds));
+                ++next;
+            }
+            // waiting for the oldest child is good enough: the runs are of similar length
+            auto oldest = running.front();
+            running.pop_front();
+            if(!finish_run(oldest.second, runs[oldest.first])) {
+                std::cerr << "Ablation run " << oldest.first << " failed to report" << std::endl;
+            }
+        }
+    }
+
+    bool parse_options(int argc, char** argv, Options& options) {
+        for(int i = 1; i + 1 < argc; i += 2) {
+            if(std::strcmp(argv[i], "--proof") == 0) {
+                options.proof = argv[i + 1];
+            } else if(std::strcmp(argv[i], "--jobs") == 0) {
+                options.jobs = std::strtoull(argv[i + 1], nullptr, 10);
+            } else if(std::strcmp(argv[i], "--max-nodes") == 0) {
+                options.max_nodes = std::strtoull(argv[i + 1], nullptr, 10);
+            } else if(std::strcmp(argv[i], "--budget-factor") == 0) {
+                options.node_budget_factor = std::atof(argv[i + 1]);
+            } else if(std::strcmp(argv[i], "--max-seconds") == 0) {
+                options.max_seconds = std::atof(argv[i + 1]);
+            } else {
+                return false;
+            }
+        }
+        return argc % 2 == 1 && !options.proof.empty();
+    }
+}
+
+/**
+ * Rerun a proof once with each of its constraints left out, under a node budget,
+ * and report which constraints are required and what each one contributes.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    if(!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    const ProofEntry* proof = nullptr;
+    for(const ProofEntry& p : proof_registry()) {
+        if(p.name == options.proof) {
+            proof = &p;
+        }
+    }
+    if(!proof) {
+        std::cerr << "Unknown proof '" << options.proof << "'" << std::endl;
+        return 2;
+    }
+    std::size_t jobs = options.jobs ? options.jobs : (std::max)(std::thread::hardware_concurrency(), 1u);
+
+    std::vector<AblationRun> baseline(1);
+    run_all(*proof, baseline, 1, 0, 0.0);
+    const AblationRun& base = baseline.front();
+    if(!base.ok || !base.proved) {
+        std::cerr << "The proof '" << proof->name << "' does not succeed with all constraints" << std::endl;
+        return 1;
+    }
+    std::uint64_t max_nodes = options.max_nodes ? options.max_nodes
+                                                : std::uint64_t(options.node_budget_factor * double(base.nodes));
+    std::cout << "Baseline: " << base.nodes << " nodes, " << std::fixed << std::setprecision(2)
+              << base.cpu_seconds << "s CPU; budget " << max_nodes << " nodes";
+    if(options.max_seconds != 0.0) {
+        std::cout << ", " << options.max_seconds << 's';
+    }
+    std::cout << std::endl;
+
+    std::vector<AblationRun> runs(base.constraints.size());
+    for(std::size_t i = 0; i < runs.size(); ++i) {
+        runs[i].disabled.push_back(i);
+    }
+    run_all(*proof, runs, jobs, max_nodes, options.max_seconds);
+
+    std::uint64_t total_cost = 0;
+    for(const ConstraintStats& c : base.constraints) {
+        total_cost += c.cost;
+    }
+    for(std::size_t i = 0; i < runs.size(); ++i) {
+        const ConstraintStats& c = base.constraints[i];
+        const AblationRun& r = runs[i];
+        std::cout << '[' << i << "] " << c.name << ":\n    " << c.evaluations << " evaluations, "
+                  << std::setprecision(1) << 1.0e-6 * double(c.cost) << "M ticks ("
+                  << (total_cost ? 100.0 * double(c.cost) / double(total_cost) : 0.0) << "% of constraint cost)\n"
+                  << "    without it: ";
+        if(!r.ok) {
+            std::cout << "run failed\n";
+        } else if(r.budget_exceeded) {
+            std::cout << "budget exceeded -> required (within budget)\n";
+        } else if(!r.proved) {
+            std::cout << "proof fails after " << r.nodes << " nodes -> required\n";
+        } else {
+            double node_change = 100.0 * (double(r.nodes) - double(base.nodes)) / double(base.nodes);
+            std::cout << r.nodes << " nodes (" << std::showpos << node_change << "%" << std::noshowpos << "), "
+                      << std::setprecision(2) << r.cpu_seconds << "s CPU -> "
+                      << (r.cpu_seconds < base.cpu_seconds ? "does not pay for itself" : "pays for itself") << '\n';
+        }
+    }
+    std::cout << std::flush;
+    return 0;
+}
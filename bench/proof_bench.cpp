@@ -0,0 +1,298 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "isolated_run.hpp"
+#include "proof_registry.hpp"
+#include "proof_stats.hpp"
+#include "progress.hpp"
+
+namespace {
+    struct Options {
+        std::vector<std::string> proofs;
+        std::size_t runs = 3;
+        std::size_t warmup = 1;
+        std::string json_file;
+        std::string baseline_file;
+        double tolerance = 0.1;
+    };
+
+    struct RunResult {
+        bool ok;
+        bool proved;
+        std::uint64_t nodes;
+        std::uint64_t peak_open_boxes;
+        double seconds;
+        long peak_rss_kb;
+    };
+
+    struct BenchResult {
+        std::string name;
+        bool proved = true;
+        double median_seconds = 0.0;
+        double min_seconds = 0.0;
+        std::uint64_t nodes = 0;
+        double nodes_per_second = 0.0;
+        std::uint64_t peak_open_boxes = 0;
+        long peak_rss_kb = 0;
+    };
+
+    void usage(const char* program) {
+        std::cerr << "Usage: " << program << " [--list] [--proof NAME]... [--runs N] [--warmup N] [--json FILE]"
+                  << " [--baseline FILE [--tolerance FRACTION]]" << std::endl;
+    }
+
+    RunResult run_isolated(const ProofEntry& proof) {
+        RunResult result{false, false, 0, 0, 0.0, 0};
+        IsolatedRun run = start_isolated([&] () {
+            default_progress_options().print_progress = false;
+            ivarp::setup_floating_point_environment();
+            bool proved = proof.run();
+            const std::vector<ProofRunRecord>& records = proof_run_records();
+            auto record = std::find_if(records.rbegin(), records.rend(),
+                                       [&] (const ProofRunRecord& r) { return r.name == proof.name; });
+            std::ostringstream message;
+            message << std::setprecision(17) << (proved ? 1 : 0) << ' ';
+            if(record != records.rend()) {
+                message << record->nodes << ' ' << record->peak_open_boxes << ' ' << record->seconds;
+            } else {
+                message << "0 0 0";
+            }
+            return message.str();
+        });
+        std::string message;
+        struct rusage usage;
+        if(!finish_isolated(run, message, usage)) {
+            return result;
+        }
+        result.peak_rss_kb = usage.ru_maxrss;
+        int proved;
+        std::istringstream input(message);
+        if(input >> proved >> result.nodes >> result.peak_open_boxes >> result.seconds) {
+            result.ok = true;
+            result.proved = (proved != 0);
+        }
+        return result;
+    }
+
+    bool bench_proof(const ProofEntry& proof, const Options& options, BenchResult& bench) {
+        bench.name = proof.name;
+        for(std::size_t i = 0; i < options.warmup; ++i) {
+            run_isolated(proof);
+        }
+        std::vector<double> times;
+        for(std::size_t i = 0; i < options.runs; ++i) {
+            RunResult r = run_isolated(proof);
+            if(!r.ok) {
+                std::cerr << "Run " << i << " of proof '" << proof.name << "' failed to report" << std::endl;
+                return false;
+            }
+            bench.proved = bench.proved && r.proved;
+            bench.nodes = r.nodes;
+            bench.peak_open_boxes = (std::max)(bench.peak_open_boxes, r.peak_open_boxes);
+            bench.peak_rss_kb = (std::max)(bench.peak_rss_kb, r.peak_rss_kb);
+            times.push_back(r.seconds);
+        }
+        std::sort(times.begin(), times.end());
+        bench.min_seconds = times.front();
+        bench.median_seconds = (times.size() % 2) ? times[times.size() / 2]
+                                                  : 0.5 * (times[times.size() / 2 - 1] + times[times.size() / 2]);
+        bench.nodes_per_second = bench.median_seconds > 0.0 ? double(bench.nodes) / bench.median_seconds : 0.0;
+        return true;
+    }
+
+    double json_number(const std::string& line, const char* key) {
+        std::string pattern = std::string("\"") + key + "\":";
+        std::size_t pos = line.find(pattern);
+        if(pos == std::string::npos) {
+            return -1.0;
+        }
+        return std::strtod(line.c_str() + pos + pattern.size(), nullptr);
+    }
+
+    /**
+     * Read a file written with --json; it contains one proof per line.
+     */
+    std::map<std::string, BenchResult> read_baseline(const std::string& filename) {
+        std::ifstream input(filename);
+        std::map<std::string, BenchResult> result;
+        if(!input) {
+            throw std::runtime_error("Could not open baseline file '" + filename + "'");
+        }
+        std::string line;
+        const std::string name_key = "\"name\": \"";
+        while(std::getline(input, line)) {
+            std::size_t pos = line.find(name_key);
+            if(pos == std::string::npos) {
+                continue;
+            }
+            pos += name_key.size();
+            BenchResult r;
+            r.name = line.substr(pos, line.find('"', pos) - pos);
+            r.median_seconds = json_number(line, "median_seconds");
+            r.nodes = std::uint64_t(json_number(line, "nodes"));
+            r.peak_rss_kb = long(json_number(line, "peak_rss_kb"));
+            result[r.name] = r;
+        }
+        return result;
+    }
+
+    void write_json(const std::string& filename, const std::vector<BenchResult>& results) {
+        std::ofstream output(filename);
+        output << std::setprecision(6) << "{\n  \"proofs\": [\n";
+        for(std::size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            output << "    {\"name\": \"" << r.name << "\", \"proved\": " << (r.proved ? "true" : "false")
+                   << ", \"median_seconds\": " << r.median_seconds << ", \"min_seconds\": " << r.min_seconds
+                   << ", \"nodes\": " << r.nodes << ", \"nodes_per_second\": " << r.nodes_per_second
+                   << ", \"peak_open_boxes\": " << r.peak_open_boxes << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}"
+                   << (i + 1 < results.size() ? "," : "") << '\n';
+        }
+        output << "  ]\n}\n";
+    }
+
+    /**
+     * Compare a result to its baseline; returns false on a regression beyond the tolerance.
+     */
+    bool compare(const BenchResult& r, const BenchResult& base, double tolerance) {
+        bool ok = true;
+        if(base.median_seconds > 0.0) {
+            double change = (r.median_seconds - base.median_seconds) / base.median_seconds;
+            std::cout << "  time " << std::showpos << std::fixed << std::setprecision(1) << 100.0 * change << '%'
+                      << std::noshowpos;
+            // differences below timer and scheduling noise are never flagged
+            if(change > tolerance && r.median_seconds - base.median_seconds > 0.01) {
+                std::cout << " REGRESSION";
+                ok = false;
+            }
+        }
+        if(base.peak_rss_kb > 0) {
+            double change = double(r.peak_rss_kb - base.peak_rss_kb) / double(base.peak_rss_kb);
+            std::cout << ", RSS " << std::showpos << std::fixed << std::setprecision(1) << 100.0 * change << '%'
+                      << std::noshowpos;
+            if(change > tolerance) {
+                std::cout << " REGRESSION";
+                ok = false;
+            }
+        }
+        if(r.nodes != base.nodes) {
+            // not a performance regression by itself, but the search tree changed
+            std::cout << ", nodes changed from " << base.nodes;
+        }
+        std::cout << std::defaultfloat << '\n';
+        return ok;
+    }
+
+    bool parse_options(int argc, char** argv, Options& options) {
+        for(int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if(arg == "--list") {
+                for(const ProofEntry& p : proof_registry()) {
+                    std::cout << p.name << '\n';
+                }
+                std::exit(0);
+            }
+            if(i + 1 >= argc) {
+                return false;
+            }
+            if(arg == "--proof") {
+                options.proofs.push_back(argv[++i]);
+            } else if(arg == "--runs") {
+                options.runs = (std::max)(std::size_t(std::strtoull(argv[++i], nullptr, 10)), std::size_t(1));
+            } else if(arg == "--warmup") {
+                options.warmup = std::strtoull(argv[++i], nullptr, 10);
+            } else if(arg == "--json") {
+                options.json_file = argv[++i];
+            } else if(arg == "--baseline") {
+                options.baseline_file = argv[++i];
+            } else if(arg == "--tolerance") {
+                options.tolerance = std::atof(argv[++i]);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/**
+ * Run each proof (or the selected ones) repeatedly in isolation and
+ * report time, node count, throughput and memory, optionally against a baseline.
+ */
+int main(int argc, char** argv) {
+    Options options;
+    if(!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    std::vector<const ProofEntry*> selected;
+    for(const ProofEntry& p : proof_registry()) {
+        if(options.proofs.empty() || std::find(options.proofs.begin(), options.proofs.end(), p.name) != options.proofs.end()) {
+            selected.push_back(&p);
+        }
+    }
+    if(selected.size() != options.proofs.size() && !options.proofs.empty()) {
+        std::cerr << "Unknown proof name; use --list to show the available proofs" << std::endl;
+        return 2;
+    }
+    std::map<std::string, BenchResult> baseline;
+    if(!options.baseline_file.empty()) {
+        try {
+            baseline = read_baseline(options.baseline_file);
+        } catch(const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<BenchResult> results;
+    bool ok = true;
+    for(const ProofEntry* p : selected) {
+        BenchResult r;
+        if(!bench_proof(*p, options, r)) {
+            ok = false;
+            continue;
+        }
+        results.push_back(r);
+        std::cout << std::left << std::setw(20) << r.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << r.median_seconds << "s (min " << r.min_seconds << "s), "
+                  << r.nodes << " nodes, " << std::setprecision(0) << r.nodes_per_second << " nodes/s, "
+                  << r.peak_open_boxes << " peak open boxes, " << r.peak_rss_kb << " KiB peak RSS"
+                  << (r.proved ? "" : ", NOT PROVED") << std::defaultfloat << std::endl;
+        ok = ok && r.proved;
+        auto base = baseline.find(r.name);
+        if(base != baseline.end()) {
+            ok = compare(r, base->second, options.tolerance) && ok;
+        }
+    }
+    if(!options.json_file.empty()) {
+        write_json(options.json_file, results);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "bench.hpp"
+
+using namespace ivarp;
+using namespace ivarp_bench;
+
+static const bool arithmetic_registered =
+    register_binary("add_intervald", [] (IDouble x, IDouble y) { return x + y; }) &&
+    register_binary("sub_intervald", [] (IDouble x, IDouble y) { return x - y; }) &&
+    register_binary("mul_intervald", [] (IDouble x, IDouble y) { return x * y; }) &&
+    register_binary("div_intervald", [] (IDouble x, IDouble y) { return x / y; }) &&
+    register_binary("mul_nonneg", [] (IDouble x, IDouble y) { return mul_nonneg(x, y); }) &&
+    register_binary("div_pos", [] (IDouble x, IDouble y) { return div_pos(x, y); }) &&
+    register_unary("mul_point_interval", [] (IDouble x) { return x * IDouble(0.3); }) &&
+    register_unary("mul_scalar", [] (IDouble x) { return x * 0.3; }) &&
+    register_unary("mul_scalar_pow2", [] (IDouble x) { return 0.25 * x; }) &&
+    register_unary("div_point_interval", [] (IDouble x) { return x / IDouble(3.0); }) &&
+    register_unary("div_scalar", [] (IDouble x) { return x / 3.0; }) &&
+    register_unary("div_scalar_pow2", [] (IDouble x) { return x / 2; }) &&
+    register_binary("mul_add", [] (IDouble x, IDouble y) { return x * y + x; }) &&
+    register_binary("fma", [] (IDouble x, IDouble y) { return fma(x, y, x); }) &&
+    register_unary("horner_naive", [] (IDouble x) { return ((0.25 * x + 1.5) * x - 2.0) * x + 0.75; }) &&
+    register_unary("horner", [] (IDouble x) { return horner(x, 0.25, 1.5, -2.0, 0.75); }) &&
+    register_unary("sqrt_intervald", [] (IDouble x) { return sqrt(x); }) &&
+    register_unary("fixed_pow<2>", [] (IDouble x) { return fixed_pow<2>(x); }) &&
+    register_unary("fixed_pow<3>", [] (IDouble x) { return fixed_pow<3>(x); }) &&
+    register_binary("less_intervald", [] (IDouble x, IDouble y) { return x < y; }) &&
+    register_unary("less_scalar", [] (IDouble x) { return x < 0.5; }) &&
+    register_binary("greater_equal_intervald", [] (IDouble x, IDouble y) { return x >= y; });
+
+static Result bench_i64_to_intervald(double min_time, bool exact) {
+    std::mt19937_64 rng(3);
+    // below 2^53, all integers are exactly representable; above, the result has to be rounded
+    std::uniform_int_distribution<std::int64_t> values(exact ? -(std::int64_t(1) << 52) : (std::int64_t(1) << 60),
+                                                       exact ? (std::int64_t(1) << 52) : (std::int64_t(1) << 62));
+    std::vector<std::int64_t> x(input_count);
+    for(std::int64_t& v : x) {
+        v = values(rng);
+    }
+    return measure([&] (std::size_t i) { return IDouble(x[i]); }, min_time);
+}
+
+static const bool conversion_registered = [] () {
+    registry().push_back(Benchmark{"i64_to_intervald/exact", [] (double t) { return bench_i64_to_intervald(t, true); }});
+    registry().push_back(Benchmark{"i64_to_intervald/rounded", [] (double t) { return bench_i64_to_intervald(t, false); }});
+    return true;
+}();
+
+static Result bench_dot(double min_time, bool fused) {
+    constexpr std::size_t n = 8;
+    std::vector<IDouble> x = make_inputs(Distribution::POSITIVE, input_count + n, 1);
+    std::vector<IDouble> y = make_inputs(Distribution::SIGN_MIXED, input_count + n, 2);
+    return measure([&] (std::size_t i) {
+        if(fused) {
+            return dot(&x[i], &y[i], n);
+        }
+        IDouble result(0.0);
+        for(std::size_t j = 0; j < n; ++j) {
+            result += x[i + j] * y[i + j];
+        }
+        return result;
+    }, min_time);
+}
+
+static const bool dot_registered = [] () {
+    registry().push_back(Benchmark{"dot_naive/8", [] (double t) { return bench_dot(t, false); }});
+    registry().push_back(Benchmark{"dot/8", [] (double t) { return bench_dot(t, true); }});
+    return true;
+}();
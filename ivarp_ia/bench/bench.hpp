@@ -0,0 +1,222 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ivarp_bench {
+    /**
+     * Result of a single benchmark: the average time per operation when
+     * operations are independent (throughput) and when each operation depends
+     * on the result of the previous one (latency, including one dependent L1 load).
+     */
+    struct Result {
+        double throughput_ns;
+        double latency_ns;
+    };
+
+    struct Benchmark {
+        std::string name;
+        std::function<Result(double)> run;   //< called with the minimum measurement time in seconds
+    };
+
+    inline std::vector<Benchmark>& registry() {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    /**
+     * Keep the compiler from optimizing away the computation of value.
+     */
+    template<typename T> inline void do_not_optimize(const T& value) noexcept {
+        asm volatile("" : : "m"(value) : "memory");
+    }
+
+    /**
+     * A zero the compiler cannot see through; used to make
+     * the input of the next operation depend on the previous result.
+     */
+    inline std::uint64_t opaque_zero() noexcept {
+        static volatile std::uint64_t zero = 0;
+        return zero;
+    }
+
+    inline std::uint64_t dependency_bits(double x) noexcept {
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        return bits;
+    }
+
+    // both bounds have to be used; otherwise, the computation of the unused one may be optimized out
+    inline std::uint64_t dependency_bits(ivarp::IDouble x) noexcept {
+        return dependency_bits(x.lb()) ^ dependency_bits(x.ub());
+    }
+
+    template<typename T1, typename T2> inline std::uint64_t dependency_bits(const std::pair<T1, T2>& x) noexcept {
+        return dependency_bits(x.first) ^ dependency_bits(x.second);
+    }
+
+    inline std::uint64_t dependency_bits(ivarp::IBool x) noexcept {
+        return static_cast<std::uint64_t>(possibly(x)) ^ (static_cast<std::uint64_t>(definitely(x)) << 1);
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Input distributions: sign-mixed intervals (lb < 0 < ub), positive-only intervals
+     * and tiny intervals (a few ulp wide, as produced deep in a proof).
+     */
+    enum class Distribution { SIGN_MIXED, POSITIVE, TINY };
+
+    inline const char* distribution_name(Distribution d) noexcept {
+        switch(d) {
+            case Distribution::SIGN_MIXED: return "sign_mixed";
+            case Distribution::POSITIVE: return "positive";
+            case Distribution::TINY: return "tiny";
+        }
+        return "unknown";
+    }
+
+    inline std::vector<ivarp::IDouble> make_inputs(Distribution dist, std::size_t count, std::uint64_t seed) {
+        std::mt19937_64 rng(seed);
+        std::uniform_real_distribution<double> magnitude(0.01, 100.0);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        std::uniform_int_distribution<int> ulps(0, 8);
+        std::vector<ivarp::IDouble> result;
+        result.reserve(count);
+        for(std::size_t i = 0; i < count; ++i) {
+            switch(dist) {
+                case Distribution::SIGN_MIXED:
+                    result.emplace_back(-magnitude(rng), magnitude(rng));
+                    break;
+                case Distribution::POSITIVE: {
+                    double l = magnitude(rng);
+                    result.emplace_back(l, l + l * unit(rng));
+                    break;
+                }
+                case Distribution::TINY: {
+                    double l = magnitude(rng) * (unit(rng) < 0.5 ? -1.0 : 1.0);
+                    double u = l;
+                    for(int k = ulps(rng); k > 0; --k) {
+                        u = std::nextafter(u, std::numeric_limits<double>::infinity());
+                    }
+                    result.emplace_back(l, u);
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    constexpr std::size_t input_count = 4096;
+
+    /**
+     * Measure op applied to the given inputs once; op takes an input index and
+     * returns the result of the operation, which is used to build the dependency chain.
+     */
+    template<typename Op> Result measure_once(Op& op, double min_time) {
+        Result result;
+        // throughput: independent operations on all inputs
+        {
+            std::uint64_t iterations = 0;
+            Clock::time_point begin = Clock::now(), end;
+            do {
+                for(std::size_t i = 0; i < input_count; ++i) {
+                    auto r = op(i);
+                    do_not_optimize(r);
+                }
+                iterations += input_count;
+                end = Clock::now();
+            } while(std::chrono::duration<double>(end - begin).count() < min_time);
+            result.throughput_ns = std::chrono::duration<double, std::nano>(end - begin).count() / double(iterations);
+        }
+        // latency: the index of the next input depends on the previous result
+        {
+            std::uint64_t zero = opaque_zero();
+            std::uint64_t iterations = 0;
+            std::size_t index = 0;
+            Clock::time_point begin = Clock::now(), end;
+            do {
+                for(std::size_t i = 0; i < input_count; ++i) {
+                    auto r = op(index);
+                    index = (i + 1 + (dependency_bits(r) & zero)) & (input_count - 1);
+                }
+                iterations += input_count;
+                end = Clock::now();
+            } while(std::chrono::duration<double>(end - begin).count() < min_time);
+            do_not_optimize(index);
+            result.latency_ns = std::chrono::duration<double, std::nano>(end - begin).count() / double(iterations);
+        }
+        return result;
+    }
+
+    inline std::size_t& repetitions() noexcept {
+        static std::size_t r = 5;
+        return r;
+    }
+
+    /**
+     * Measure repeatedly and report the minimum, which is least affected by interference.
+     */
+    template<typename Op> Result measure(Op&& op, double min_time) {
+        Result best = measure_once(op, min_time);
+        for(std::size_t i = 1; i < repetitions(); ++i) {
+            Result r = measure_once(op, min_time);
+            best.throughput_ns = (std::min)(best.throughput_ns, r.throughput_ns);
+            best.latency_ns = (std::min)(best.latency_ns, r.latency_ns);
+        }
+        return best;
+    }
+
+    constexpr Distribution all_distributions[] = {Distribution::SIGN_MIXED, Distribution::POSITIVE, Distribution::TINY};
+
+    /**
+     * Register a binary operation on intervals for all input distributions.
+     */
+    template<typename Op> bool register_binary(const std::string& kernel, Op op) {
+        for(Distribution d : all_distributions) {
+            registry().push_back(Benchmark{kernel + "/" + distribution_name(d), [d, op] (double min_time) {
+                std::vector<ivarp::IDouble> x = make_inputs(d, input_count, 1), y = make_inputs(d, input_count, 2);
+                return measure([&] (std::size_t i) { return op(x[i], y[i]); }, min_time);
+            }});
+        }
+        return true;
+    }
+
+    /**
+     * Register a unary operation on intervals for all input distributions.
+     */
+    template<typename Op> bool register_unary(const std::string& kernel, Op op) {
+        for(Distribution d : all_distributions) {
+            registry().push_back(Benchmark{kernel + "/" + distribution_name(d), [d, op] (double min_time) {
+                std::vector<ivarp::IDouble> x = make_inputs(d, input_count, 1);
+                return measure([&] (std::size_t i) { return op(x[i]); }, min_time);
+            }});
+        }
+        return true;
+    }
+}
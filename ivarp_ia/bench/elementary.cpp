@@ -0,0 +1,46 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bench.hpp"
+
+using namespace ivarp;
+using namespace ivarp_bench;
+
+/**
+ * Register a unary operation defined on [-1, 1] for all input distributions,
+ * scaled from the usual magnitude range [0.01, 100] into [-1, 1].
+ */
+template<typename Op> static bool register_unary_unit(const std::string& kernel, Op op) {
+    for(Distribution d : all_distributions) {
+        registry().push_back(Benchmark{kernel + "/" + distribution_name(d), [d, op] (double min_time) {
+            std::vector<IDouble> x = make_inputs(d, input_count, 1);
+            for(IDouble& xi : x) {
+                xi = IDouble(0.01 * lb(xi), 0.01 * ub(xi));
+            }
+            return measure([&] (std::size_t i) { return op(x[i]); }, min_time);
+        }});
+    }
+    return true;
+}
+
+static const bool elementary_registered =
+    register_unary("exp", [] (IDouble x) { return exp(x); }) &&
+    register_unary("ln", [] (IDouble x) { return ln(x); }) &&
+    register_unary("log2", [] (IDouble x) { return log2(x); }) &&
+    register_unary("atan", [] (IDouble x) { return atan(x); }) &&
+    register_unary_unit("asin", [] (IDouble x) { return asin(x); }) &&
+    register_unary_unit("acos", [] (IDouble x) { return acos(x); });
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "bench.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+using namespace ivarp_bench;
+
+namespace {
+    struct Options {
+        std::string filter;
+        std::string json_file;
+        std::string baseline_file;
+        double min_time = 0.05;
+        double tolerance = 0.1;
+    };
+
+    void usage(const char* program) {
+        std::cerr << "Usage: " << program << " [--filter SUBSTRING] [--min-time SECONDS] [--repetitions N] [--json FILE]"
+                  << " [--baseline FILE [--tolerance FRACTION]]" << std::endl;
+    }
+
+    bool parse_options(int argc, char** argv, Options& options) {
+        for(int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if(i + 1 >= argc) {
+                return false;
+            }
+            if(arg == "--filter") {
+                options.filter = argv[++i];
+            } else if(arg == "--min-time") {
+                options.min_time = std::atof(argv[++i]);
+            } else if(arg == "--repetitions") {
+                repetitions() = (std::max)(std::size_t(std::strtoull(argv[++i], nullptr, 10)), std::size_t(1));
+            } else if(arg == "--json") {
+                options.json_file = argv[++i];
+            } else if(arg == "--baseline") {
+                options.baseline_file = argv[++i];
+            } else if(arg == "--tolerance") {
+                options.tolerance = std::atof(argv[++i]);
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    double json_number(const std::string& line, const char* key) {
+        std::string pattern = std::string("\"") + key + "\":";
+        std::size_t pos = line.find(pattern);
+        if(pos == std::string::npos) {
+            return -1.0;
+        }
+        return std::strtod(line.c_str() + pos + pattern.size(), nullptr);
+    }
+
+    /**
+     * Read a file written with --json; it contains one benchmark per line.
+     */
+    std::map<std::string, Result> read_baseline(const std::string& filename) {
+        std::ifstream input(filename);
+        if(!input) {
+            throw std::runtime_error("Could not open baseline file '" + filename + "'");
+        }
+        std::map<std::string, Result> result;
+        std::string line;
+        const std::string name_key = "\"name\": \"";
+        while(std::getline(input, line)) {
+            std::size_t pos = line.find(name_key);
+            if(pos == std::string::npos) {
+                continue;
+            }
+            pos += name_key.size();
+            std::string name = line.substr(pos, line.find('"', pos) - pos);
+            result[name] = Result{json_number(line, "throughput_ns"), json_number(line, "latency_ns")};
+        }
+        return result;
+    }
+
+    void write_json(const std::string& filename, const std::vector<std::pair<std::string, Result>>& results) {
+        std::ofstream output(filename);
+        output << std::setprecision(6) << "{\n  \"benchmarks\": [\n";
+        for(std::size_t i = 0; i < results.size(); ++i) {
+            output << "    {\"name\": \"" << results[i].first << "\", \"throughput_ns\": " << results[i].second.throughput_ns
+                   << ", \"latency_ns\": " << results[i].second.latency_ns << "}"
+                   << (i + 1 < results.size() ? "," : "") << '\n';
+        }
+        output << "  ]\n}\n";
+    }
+
+    /**
+     * Relative change of value compared to base, as a string; sets regression if it exceeds the tolerance.
+     */
+    std::string compare(double value, double base, double tolerance, bool& regression) {
+        if(base <= 0.0) {
+            return "new";
+        }
+        double change = (value - base) / base;
+        std::ostringstream output;
+        output << std::showpos << std::fixed << std::setprecision(1) << 100.0 * change << '%';
+        if(change > tolerance) {
+            regression = true;
+            output << " REGRESSION";
+        }
+        return output.str();
+    }
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if(!parse_options(argc, argv, options)) {
+        usage(argv[0]);
+        return 2;
+    }
+    ivarp::setup_floating_point_environment();
+
+    std::map<std::string, Result> baseline;
+    if(!options.baseline_file.empty()) {
+        try {
+            baseline = read_baseline(options.baseline_file);
+        } catch(const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<std::pair<std::string, Result>> results;
+    bool regression = false;
+    std::cout << std::left << std::setw(36) << "benchmark" << std::right << std::setw(16) << "throughput [ns]"
+              << std::setw(14) << "latency [ns]" << '\n';
+    for(const Benchmark& b : registry()) {
+        if(b.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        Result r = b.run(options.min_time);
+        results.emplace_back(b.name, r);
+        std::cout << std::left << std::setw(36) << b.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(16) << r.throughput_ns << std::setw(14) << r.latency_ns;
+        auto base = baseline.find(b.name);
+        if(base != baseline.end()) {
+            std::cout << "   throughput " << compare(r.throughput_ns, base->second.throughput_ns, options.tolerance, regression)
+                      << ", latency " << compare(r.latency_ns, base->second.latency_ns, options.tolerance, regression);
+        }
+        std::cout << std::endl;
+    }
+    if(!options.json_file.empty()) {
+        write_json(options.json_file, results);
+    }
+    return regression ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "bench.hpp"
+
+using namespace ivarp;
+using namespace ivarp_bench;
+
+static const bool trigonometric_registered =
+    register_unary("sin", [] (IDouble x) { return sin(x); }) &&
+    register_unary("cos", [] (IDouble x) { return cos(x); }) &&
+    register_unary("sin+cos", [] (IDouble x) { return std::make_pair(sin(x), cos(x)); }) &&
+    register_unary("sincos", [] (IDouble x) { return sincos(x); }) &&
+    register_unary("tan", [] (IDouble x) { return tan(x); });
+
+static Result bench_sincos_batch(double min_time, bool batched) {
+    constexpr std::size_t n = 8;
+    std::vector<IDouble> x = make_inputs(Distribution::TINY, input_count + n, 1);
+    return measure([&] (std::size_t i) {
+        IDouble s[n], c[n];
+        if(batched) {
+            sincos(&x[i], s, c, n);
+        } else {
+            for(std::size_t j = 0; j < n; ++j) {
+                s[j] = sin(x[i + j]);
+                c[j] = cos(x[i + j]);
+            }
+        }
+        do_not_optimize(s);
+        do_not_optimize(c);
+        return std::make_pair(s[n-1], c[0]);
+    }, min_time);
+}
+
+static const bool sincos_batch_registered = [] () {
+    registry().push_back(Benchmark{"sin+cos_batch/8", [] (double t) { return bench_sincos_batch(t, false); }});
+    registry().push_back(Benchmark{"sincos_batch/8", [] (double t) { return bench_sincos_batch(t, true); }});
+    return true;
+}();
@@ -51,7 +51,7 @@ if(NOT TARGET util::use_sse)
 
 	# MSVC uses SSE2 by default
 	if("${CMAKE_CXX_COMPILER_ID}" MATCHES "[Gg][Nn][Uu]" OR "${CMAKE_CXX_COMPILER_ID}" MATCHES "[Cc][Ll][Aa][Nn][Gg]")
-		target_compile_options(__util_use_sse INTERFACE "-mfpmath=sse" "-mavx2")
+		target_compile_options(__util_use_sse INTERFACE "-mfpmath=sse")
 	else()
 		message(WARNING "C++ compiler (ID ${CMAKE_CXX_COMPILER_ID}) not recognized; we do not know how to change to a floating-point engine that allows proper rounding support!")
 	endif()
@@ -59,3 +59,18 @@ if(NOT TARGET util::use_sse)
 	util_make_flags_cuda_compatible(__util_use_sse)
 endif()
 
+# the instruction set levels code can be compiled for (see ivarp_ia/isa.hpp): util::isa_sse42, util::isa_avx2, util::isa_avx512
+if(NOT TARGET util::isa_avx2)
+	set(__util_isa_sse42_flags "-msse4.2" "-mpopcnt")
+	set(__util_isa_avx2_flags ${__util_isa_sse42_flags} "-mavx2" "-mfma" "-mbmi" "-mbmi2")
+	set(__util_isa_avx512_flags ${__util_isa_avx2_flags} "-mavx512f" "-mavx512vl" "-mavx512dq" "-mavx512bw" "-mavx512cd")
+	foreach(level sse42 avx2 avx512)
+		add_library(__util_isa_${level} INTERFACE)
+		add_library(util::isa_${level} ALIAS __util_isa_${level})
+		if("${CMAKE_CXX_COMPILER_ID}" MATCHES "[Gg][Nn][Uu]" OR "${CMAKE_CXX_COMPILER_ID}" MATCHES "[Cc][Ll][Aa][Nn][Gg]")
+			target_compile_options(__util_isa_${level} INTERFACE ${__util_isa_${level}_flags})
+		endif()
+		util_make_flags_cuda_compatible(__util_isa_${level})
+	endforeach()
+endif()
+
@@ -25,6 +25,7 @@
 #include "impl/mul_interval.hpp"
 #include "impl/sqrt_interval.hpp"
 #include "impl/div_interval.hpp"
+#include "impl/fma_interval.hpp"
 #include "impl/interval_setops.hpp"
 #include "impl/compare_interval.hpp"
 
@@ -150,6 +151,45 @@ namespace ivarp {
             return *this;
         }
 
+        /**
+         * Multiplication for factors known to be non-negative (such as radii, weights or squares);
+         * needs only two products. The result is correct (but not faster) for other factors.
+         */
+        IDouble mul_nonneg(IDouble other) const noexcept {
+            return IDouble(impl::mul_intervald_nonneg(m_data, other.m_data));
+        }
+
+        /**
+         * Division by a denominator known to be positive; needs only two quotients.
+         * The result is correct (but not faster) for other denominators.
+         */
+        IDouble div_pos(IDouble den) const noexcept {
+            return IDouble(impl::div_intervald_pos(m_data, den.m_data));
+        }
+
+        /**
+         * Multiplication and division by a scalar; used by the mixed scalar-interval operators.
+         * Needs two products or quotients, and no rounding for most powers of two.
+         */
+        IDouble mul_scalar(double s) const noexcept {
+            return IDouble(impl::mul_scalar_intervald(m_data, s));
+        }
+
+        IDouble div_scalar(double s) const noexcept {
+            return IDouble(impl::div_scalar_intervald(m_data, s));
+        }
+
+        /**
+         * The fused multiply-add *this * factor + addend, rounding each bound once.
+         */
+        IDouble fma(IDouble factor, IDouble addend) const noexcept {
+            return IDouble(impl::fma_intervald(m_data, factor.m_data, addend.m_data));
+        }
+
+        IDouble fma(double factor, IDouble addend) const noexcept {
+            return IDouble(impl::fma_scalar_intervald(m_data, factor, addend.m_data));
+        }
+
         IDouble operator-() const noexcept {
             return IDouble(impl::negate_intervald(m_data));
         }
@@ -279,22 +319,58 @@ namespace ivarp {
         return x;
     }
 
+    namespace impl {
+        /**
+         * Scalar types whose values are exactly representable as double;
+         * for other types (such as 64-bit integers), IDouble(s) may not be a point interval.
+         */
+        template<typename T> struct ExactlyRepresentableAsDouble :
+            std::integral_constant<bool,
+                std::is_same<T, double>::value || std::is_same<T, float>::value ||
+                (std::is_integral<T>::value && sizeof(T) * CHAR_BIT < 53)
+            >
+        {};
+
+        template<typename IntOrFloatType>
+            inline IDouble mul_by_scalar(IDouble x, const IntOrFloatType& s, std::true_type) noexcept
+        {
+            return x.mul_scalar(static_cast<double>(s));
+        }
+
+        template<typename IntOrFloatType>
+            inline IDouble mul_by_scalar(IDouble x, const IntOrFloatType& s, std::false_type) noexcept
+        {
+            x *= IDouble(s);
+            return x;
+        }
+
+        template<typename IntOrFloatType>
+            inline IDouble div_by_scalar(IDouble x, const IntOrFloatType& s, std::true_type) noexcept
+        {
+            return x.div_scalar(static_cast<double>(s));
+        }
+
+        template<typename IntOrFloatType>
+            inline IDouble div_by_scalar(IDouble x, const IntOrFloatType& s, std::false_type) noexcept
+        {
+            x /= IDouble(s);
+            return x;
+        }
+    }
+
     template<typename IntOrFloatType, Enabler<IsBuiltinNumber<IntOrFloatType>::value> = 0>
     inline IDouble operator*(IDouble x, const IntOrFloatType& y) noexcept {
-        x *= IDouble(y);
-        return x;
+        return impl::mul_by_scalar(x, y, impl::ExactlyRepresentableAsDouble<IntOrFloatType>{});
     }
 
     template<typename IntOrFloatType, Enabler<IsBuiltinNumber<IntOrFloatType>::value> = 0>
     inline IDouble operator*(const IntOrFloatType& x, IDouble y) noexcept {
-        y *= IDouble(x);
-        return y;
+        return impl::mul_by_scalar(y, x, impl::ExactlyRepresentableAsDouble<IntOrFloatType>{});
     }
 
     template<typename IntOrFloatType, Enabler<IsBuiltinNumber<IntOrFloatType>::value> = 0>
     inline IDouble operator/(IDouble x, const IntOrFloatType& y) noexcept {
-        x /= IDouble(y);
-        return x;
+        return impl::div_by_scalar(x, y, impl::ExactlyRepresentableAsDouble<IntOrFloatType>{});
     }
 
     template<typename IntOrFloatType, Enabler<IsBuiltinNumber<IntOrFloatType>::value> = 0>
@@ -304,6 +380,71 @@ namespace ivarp {
         return xx;
     }
 
+    /**
+     * Fused multiply-add x * y + z; each bound is rounded only once
+     * (the round-to-nearest backend rounds the product and the sum separately).
+     */
+    inline IDouble fma(IDouble x, IDouble y, IDouble z) noexcept {
+        return x.fma(y, z);
+    }
+
+    template<typename IntOrFloatType, Enabler<impl::ExactlyRepresentableAsDouble<IntOrFloatType>::value> = 0>
+    inline IDouble fma(IDouble x, const IntOrFloatType& s, IDouble z) noexcept {
+        return x.fma(static_cast<double>(s), z);
+    }
+
+    template<typename IntOrFloatType, Enabler<impl::ExactlyRepresentableAsDouble<IntOrFloatType>::value> = 0>
+    inline IDouble fma(const IntOrFloatType& s, IDouble x, IDouble z) noexcept {
+        return x.fma(static_cast<double>(s), z);
+    }
+
+    namespace impl {
+        inline IDouble to_interval(IDouble x) noexcept {
+            return x;
+        }
+
+        template<typename IntOrFloatType, Enabler<IsBuiltinNumber<IntOrFloatType>::value> = 0>
+            inline IDouble to_interval(const IntOrFloatType& x) noexcept
+        {
+            return IDouble(x);
+        }
+    }
+
+    /**
+     * Evaluate the polynomial with the given coefficients (highest degree first;
+     * intervals or scalars) at x using Horner's scheme with fused multiply-adds.
+     */
+    template<typename Coeff> inline IDouble horner(IDouble, const Coeff& c) noexcept {
+        return impl::to_interval(c);
+    }
+
+    template<typename Coeff1, typename Coeff2, typename... Coeffs>
+        inline IDouble horner(IDouble x, const Coeff1& c1, const Coeff2& c2, const Coeffs&... rest) noexcept
+    {
+        return horner(x, fma(x, c1, impl::to_interval(c2)), rest...);
+    }
+
+    /**
+     * The dot product of x[0..n) and y[0..n), accumulated with fused multiply-adds
+     * into two independent partial sums (halving the length of the dependency chain).
+     */
+    inline IDouble dot(const IDouble* x, const IDouble* y, std::size_t n) noexcept {
+        IDouble even(0.0), odd(0.0);
+        std::size_t i = 0;
+        for(; i + 1 < n; i += 2) {
+            even = fma(x[i], y[i], even);
+            odd = fma(x[i+1], y[i+1], odd);
+        }
+        if(i < n) {
+            even = fma(x[i], y[i], even);
+        }
+        return even + odd;
+    }
+
+    template<std::size_t N> inline IDouble dot(const IDouble (&x)[N], const IDouble (&y)[N]) noexcept {
+        return dot(x, y, N);
+    }
+
     template<typename IntOrFloatType, Enabler<IsBuiltinNumber<IntOrFloatType>::value> = 0>
     inline IBool operator<(IntOrFloatType x, IDouble y) noexcept {
         return IDouble(x) < y;
@@ -352,6 +493,14 @@ namespace ivarp {
         return x.sqrt();
     }
 
+    inline IDouble mul_nonneg(IDouble x, IDouble y) noexcept {
+        return x.mul_nonneg(y);
+    }
+
+    inline IDouble div_pos(IDouble num, IDouble den) noexcept {
+        return num.div_pos(den);
+    }
+
     template<unsigned N>
     inline IDouble fixed_pow(IDouble x) noexcept
     {
@@ -388,6 +537,18 @@ namespace ivarp {
 
     IDouble sin(IDouble x) noexcept IVARP_FN_PURE IVARP_FN_VISIBLE;
     IDouble cos(IDouble x) noexcept IVARP_FN_PURE IVARP_FN_VISIBLE;
+
+    /**
+     * Compute (sin(x), cos(x)) with a single period reduction;
+     * the results are identical to those of sin(x) and cos(x).
+     */
+    std::pair<IDouble, IDouble> sincos(IDouble x) noexcept IVARP_FN_PURE IVARP_FN_VISIBLE;
+
+    /**
+     * Compute sin_out[i] = sin(x[i]) and cos_out[i] = cos(x[i]) for i < n.
+     */
+    void sincos(const IDouble* x, IDouble* sin_out, IDouble* cos_out, std::size_t n) noexcept IVARP_FN_VISIBLE;
+
     IDouble tan(IDouble x) noexcept IVARP_FN_PURE IVARP_FN_VISIBLE;
     IDouble asin(IDouble x) noexcept IVARP_FN_PURE IVARP_FN_VISIBLE;
     IDouble acos(IDouble x) noexcept IVARP_FN_PURE IVARP_FN_VISIBLE;
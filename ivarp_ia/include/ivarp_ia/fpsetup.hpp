@@ -22,11 +22,17 @@ namespace ivarp {
     static inline void setup_floating_point_environment() {
         std::cout << std::setprecision(19);
         std::cerr << std::setprecision(19);
-        std::fesetround(FE_DOWNWARD);
         std::uint32_t fpmode;
         asm("stmxcsr %0" : "=m"(fpmode) :: "memory");
         fpmode &= 0xffff0000u; // clear flags
+#if IVARP_IA_ROUND_TO_NEAREST
+        // the default mode; the error-free transformations only require that subnormals are not flushed
+        std::fesetround(FE_TONEAREST);
+        fpmode |= 0x00001f80u; // mask exceptions, no flush-to-zero, no denormals-are-zero, round to nearest
+#else
+        std::fesetround(FE_DOWNWARD);
         fpmode |= 0x00003f80u; // mask exceptions, no flush-to-zero, no denormals-are-zero, round down
+#endif
         asm volatile("ldmxcsr %0" :: "m"(fpmode) : "memory");
     }
 }
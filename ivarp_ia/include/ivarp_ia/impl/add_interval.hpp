@@ -19,6 +19,7 @@
 #pragma once
 
 #include "i64_to_interval.hpp"
+#include "round_nearest.hpp"
 
 namespace ivarp {
 namespace impl {
@@ -32,6 +33,23 @@ namespace impl {
     }
 
     inline __m128d add_intervald(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
+#if IVARP_IA_ROUND_TO_NEAREST
+    __m128d add_intervald(__m128d a, __m128d b) noexcept {
+        a = _mm_xor_pd(a, SWITCH_UPPER_SIGN128);
+        b = _mm_xor_pd(b, SWITCH_UPPER_SIGN128);
+        return _mm_xor_pd(add_down_pd(a, b), SWITCH_UPPER_SIGN128);
+    }
+
+    inline double add_rd(double x, double y) noexcept IVARP_FN_PURE;
+    double add_rd(double x, double y) noexcept {
+        return add_down_rn(x, y);
+    }
+
+    inline __m128d sub_intervald(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
+    __m128d sub_intervald(__m128d a, __m128d b) noexcept {
+        return add_intervald(a, negate_intervald(b));
+    }
+#else
     __m128d add_intervald(__m128d a, __m128d b) noexcept {
         /* As for int-to-double conversion, we need to defeat over-eager constant propagation (for GCC)
          * (and other rouding-mode-breaking optimizations for Clang) using inline asm.
@@ -40,13 +58,13 @@ namespace impl {
          * there are multiple inlined interval additions after each other. */
         a = _mm_xor_pd(a, SWITCH_UPPER_SIGN128);
         b = _mm_xor_pd(b, SWITCH_UPPER_SIGN128);
-        asm("vaddpd %0, %1, %0" : "+x"(a) : "x"(b));
+        asm(IVARP_IA_VEX("vaddpd %0, %1, %0", "addpd %1, %0") : "+x"(a) : "x"(b));
         return _mm_xor_pd(a, SWITCH_UPPER_SIGN128);
     }
 
     inline double add_rd(double x, double y) noexcept IVARP_FN_PURE;
     double add_rd(double x, double y) noexcept {
-        asm("vaddsd %0, %1, %0" : "+x"(x) : "x"(y));
+        asm(IVARP_IA_VEX("vaddsd %0, %1, %0", "addsd %1, %0") : "+x"(x) : "x"(y));
         return x;
     }
 
@@ -59,8 +77,9 @@ namespace impl {
          * there are multiple inlined interval additions after each other. */
         __m128d lhs = _mm_set_pd(b[0], a[0]);
         __m128d rhs = _mm_set_pd(a[1], b[1]);
-        asm("vsubpd %1, %0, %0" : "+x"(lhs) : "x"(rhs));
+        asm(IVARP_IA_VEX("vsubpd %1, %0, %0", "subpd %1, %0") : "+x"(lhs) : "x"(rhs));
         return _mm_xor_pd(lhs, SWITCH_UPPER_SIGN128);
     }
+#endif
 }
 }
@@ -30,3 +30,13 @@
 #define IVARP_FN_PURE
 #define IVARP_FN_VISIBLE
 #endif
+
+/*
+ * Select the VEX-encoded (AVX) or the legacy SSE form of an inline assembly instruction sequence,
+ * depending on the instruction set level the code is compiled for.
+ */
+#if defined(__AVX__)
+#define IVARP_IA_VEX(avx, sse) avx
+#else
+#define IVARP_IA_VEX(avx, sse) sse
+#endif
@@ -24,7 +24,7 @@ namespace impl {
     // if one of the entries is NaN, make both entries NaN
     static inline __m128d broadcast_nan_intervald(__m128d a) noexcept {
         __m128d nanmask = _mm_cmpunord_pd(a, a);
-        __m128d fnanmask = _mm_permute_pd(nanmask, 1);
+        __m128d fnanmask = _mm_shuffle_pd(nanmask, nanmask, 1);
         a = _mm_or_pd(a, nanmask);
         a = _mm_or_pd(a, fnanmask);
         return a;
@@ -25,6 +25,23 @@ namespace impl {
     static const __m128d POSITIVE_INF128 = _mm_set1_pd(std::numeric_limits<double>::infinity()); // NOLINT
 
     __m128d div_intervald_with_infinities(__m128d num, __m128d den) noexcept IVARP_FN_PURE IVARP_FN_VISIBLE;
+
+    /**
+     * The quotient of the finite interval num and the finite, positive interval den (den_lb > 0).
+     * Each endpoint of num is divided by the endpoint of den selected by its sign,
+     * so only two quotients are needed.
+     */
+    inline __m128d div_intervald_pos_den(__m128d num, __m128d den) noexcept IVARP_FN_PURE;
+    __m128d div_intervald_pos_den(__m128d num, __m128d den) noexcept {
+        /* lower bound: num_lb / (num_lb < 0 ? den_lb : den_ub), upper bound: num_ub / (num_ub < 0 ? den_ub : den_lb) */
+        __m128d swapped = _mm_shuffle_pd(den, den, 1);
+        return div_lb_ub_pd(num, _mm_blendv_pd(swapped, den, num));
+    }
+
+    /**
+     * Interval division; the denominator cannot contain zero, so after handling
+     * NaNs and infinities, it is either positive or negative and two quotients suffice.
+     */
     inline __m128d div_intervald(__m128d num, __m128d den) noexcept IVARP_FN_PURE;
     __m128d div_intervald(__m128d num, __m128d den) noexcept {
         __m128d smask_num = _mm_andnot_pd(SWITCH_BOTH_SIGNS128, num);
@@ -41,22 +58,46 @@ namespace impl {
         if(__builtin_expect(num_inf | den_inf, 0)) {
             return div_intervald_with_infinities(num, den);
         }
-        /* num_rd = [a_lb, a_lb, a_ub, a_ub] */
-        __m256d num_rd = _mm256_permute4x64_pd(_mm256_castpd128_pd256(num), 0x50);
-        /* num_ru = [-a_lb, -a_lb, -a_ub, -a_ub] */
-        __m256d num_ru = _mm256_xor_pd(num_rd, SWITCH_ALL_SIGNS256);
-        /* rhs = [b_lb, b_ub, b_lb, b_ub] (= 2*[b_lb,b_ub]) */
-        __m256d den_both =  _mm256_insertf128_pd(_mm256_castpd128_pd256(den), den, 1);
-        /* divide; use inline asm to hide the rounding instructions
-         * from the compiler (prevent compiler bugs - see addition). */
-        asm("vdivpd %1, %0, %0" : "+x"(num_rd) : "x"(den_both));
-        asm("vdivpd %1, %0, %0" : "+x"(num_ru) : "x"(den_both));
-        /* compute minimum entry in the vectors */
-        __m128d rdmin = horizontal_min(num_rd);
-        __m128d rumin = horizontal_min(num_ru);
-        /* switch sign of upper bound and extract result */
-        __m128d rumax = _mm_xor_pd(rumin, SWITCH_LOWER_SIGN128);
-        return _mm_set_pd(rumax[0], rdmin[0]);
+        if(den[0] > 0.0) {
+            return div_intervald_pos_den(num, den);
+        }
+        /* num / den = -(num / (-den)); negation is exact */
+        return negate_intervald(div_intervald_pos_den(num, negate_intervald(den)));
+    }
+
+    /**
+     * Division by an interval that is expected to be positive (den_lb > 0), with a finite numerator.
+     * Falls back to div_intervald if that expectation does not hold.
+     */
+    inline __m128d div_intervald_pos(__m128d num, __m128d den) noexcept IVARP_FN_PURE;
+    __m128d div_intervald_pos(__m128d num, __m128d den) noexcept {
+        /* the comparisons are false for NaN and infinite bounds */
+        __m128d finite = _mm_and_pd(_mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, num), POSITIVE_INF128),
+                                    _mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, den), POSITIVE_INF128));
+        if(__builtin_expect(den[0] > 0.0 && _mm_movemask_pd(finite) == 3, 1)) {
+            return div_intervald_pos_den(num, den);
+        }
+        return div_intervald(num, den);
+    }
+    /**
+     * Division of an interval by a scalar; needs two quotients, or only
+     * a multiplication by the exact reciprocal if the scalar is a power of two.
+     */
+    inline __m128d div_scalar_intervald(__m128d x, double s) noexcept IVARP_FN_PURE;
+    __m128d div_scalar_intervald(__m128d x, double s) noexcept {
+        if(is_power_of_two(s)) {
+            return mul_scalar_intervald(x, 1.0 / s);
+        }
+        /* the comparisons are false for NaN and infinite bounds */
+        __m128d finite = _mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, x), POSITIVE_INF128);
+        if(__builtin_expect(s == 0.0 || !(std::fabs(s) < std::numeric_limits<double>::infinity()) ||
+                            _mm_movemask_pd(finite) != 3, 0))
+        {
+            return div_intervald(x, _mm_set1_pd(s));
+        }
+        /* x / s = (-x) / |s| for negative s */
+        __m128d xs = (s < 0.0) ? negate_intervald(x) : x;
+        return div_lb_ub_pd(xs, _mm_set1_pd(std::fabs(s)));
     }
 }
 }
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "add_interval.hpp"
+#include "mul_interval.hpp"
+#include "interval_setops.hpp"
+
+namespace ivarp {
+namespace impl {
+    inline __m128d fma_intervald(__m128d a, __m128d b, __m128d c) noexcept IVARP_FN_PURE;
+    inline __m128d fma_scalar_intervald(__m128d x, double s, __m128d c) noexcept IVARP_FN_PURE;
+#if IVARP_IA_ROUND_TO_NEAREST || !defined(__FMA__)
+    /*
+     * Without directed rounding, the error of a fused multiply-add is not cheaply available;
+     * without FMA instructions, there is no fused operation. In both cases,
+     * the product and the sum are rounded separately.
+     */
+    __m128d fma_intervald(__m128d a, __m128d b, __m128d c) noexcept {
+        return add_intervald(mul_intervald(a, b), c);
+    }
+
+    __m128d fma_scalar_intervald(__m128d x, double s, __m128d c) noexcept {
+        return add_intervald(mul_scalar_intervald(x, s), c);
+    }
+#else
+    /**
+     * a[0] * b[0] + c[0] rounded down and a[1] * b[1] + c[1] rounded up for finite a, b, c,
+     * with a single rounding per bound.
+     */
+    inline __m128d fma_lb_ub_pd(__m128d a, __m128d b, __m128d c) noexcept IVARP_FN_PURE;
+    __m128d fma_lb_ub_pd(__m128d a, __m128d b, __m128d c) noexcept {
+        /* [a_lb * b_lb + c_lb, -(-a_ub * b_ub - c_ub)] */
+        __m128d lhs = _mm_xor_pd(a, SWITCH_UPPER_SIGN128);
+        __m128d add = _mm_xor_pd(c, SWITCH_UPPER_SIGN128);
+        /* lhs = b * lhs + add; inline asm hides the rounding from the compiler (see addition) */
+        asm("vfmadd213pd %2, %1, %0" : "+x"(lhs) : "x"(b), "x"(add));
+        return _mm_xor_pd(lhs, SWITCH_UPPER_SIGN128);
+    }
+
+    /**
+     * a * b + c for finite a and c and finite, non-negative b;
+     * each endpoint of a is paired with the endpoint of b selected by its sign.
+     */
+    inline __m128d fma_intervald_nonneg_rhs(__m128d a, __m128d b, __m128d c) noexcept IVARP_FN_PURE;
+    __m128d fma_intervald_nonneg_rhs(__m128d a, __m128d b, __m128d c) noexcept {
+        __m128d swapped = _mm_shuffle_pd(b, b, 1);
+        return fma_lb_ub_pd(a, _mm_blendv_pd(b, swapped, a), c);
+    }
+
+    /**
+     * a * b + c for finite a, b, c that both contain zero in their interior.
+     */
+    inline __m128d fma_intervald_mixed(__m128d a, __m128d b, __m128d c) noexcept IVARP_FN_PURE;
+    __m128d fma_intervald_mixed(__m128d a, __m128d b, __m128d c) noexcept {
+        /* lower bound: min(a_lb * b_ub, a_ub * b_lb) + c_lb, upper bound: max(a_lb * b_lb, a_ub * b_ub) + c_ub */
+        __m128d alb = _mm_unpacklo_pd(a, a);
+        __m128d aub = _mm_unpackhi_pd(a, a);
+        __m128d first = fma_lb_ub_pd(alb, _mm_shuffle_pd(b, b, 1), c);
+        __m128d second = fma_lb_ub_pd(aub, b, c);
+        return join_intervald(first, second);
+    }
+
+    /**
+     * The fused interval multiply-add a * b + c. For finite inputs, each bound is rounded once;
+     * otherwise, this is a * b + c.
+     */
+    __m128d fma_intervald(__m128d a, __m128d b, __m128d c) noexcept {
+        /* the comparisons are false for NaN and infinite bounds */
+        __m128d inf = _mm_set1_pd(std::numeric_limits<double>::infinity());
+        __m128d finite = _mm_and_pd(_mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, a), inf),
+                                    _mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, b), inf));
+        finite = _mm_and_pd(finite, _mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, c), inf));
+        if(__builtin_expect(_mm_movemask_pd(finite) != 3, 0)) {
+            return add_intervald(mul_intervald(a, b), c);
+        }
+        int sa = _mm_movemask_pd(a), sb = _mm_movemask_pd(b);
+        if(sb == 0) {
+            return fma_intervald_nonneg_rhs(a, b, c);
+        }
+        if(sa == 0) {
+            return fma_intervald_nonneg_rhs(b, a, c);
+        }
+        if((sa & sb) == 1) {
+            return fma_intervald_mixed(a, b, c);
+        }
+        /* one factor is non-positive; a * b + c = -(a * (-b) - c) and negation is exact */
+        if(sb == 3) {
+            return negate_intervald(fma_intervald_nonneg_rhs(a, negate_intervald(b), negate_intervald(c)));
+        }
+        return negate_intervald(fma_intervald_nonneg_rhs(b, negate_intervald(a), negate_intervald(c)));
+    }
+
+    /**
+     * The fused multiply-add x * s + c with a scalar factor s.
+     */
+    __m128d fma_scalar_intervald(__m128d x, double s, __m128d c) noexcept {
+        __m128d inf = _mm_set1_pd(std::numeric_limits<double>::infinity());
+        __m128d finite = _mm_and_pd(_mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, x), inf),
+                                    _mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, c), inf));
+        if(__builtin_expect(_mm_movemask_pd(finite) != 3 || !(std::fabs(s) < std::numeric_limits<double>::infinity()), 0)) {
+            return add_intervald(mul_scalar_intervald(x, s), c);
+        }
+        /* multiplying by a negative scalar swaps the bounds */
+        __m128d xs = (s < 0.0) ? _mm_shuffle_pd(x, x, 1) : x;
+        return fma_lb_ub_pd(xs, _mm_set1_pd(s), c);
+    }
+#endif
+}
+}
@@ -23,6 +23,7 @@
 #include <limits>
 #include <cfenv>
 #include "attributes.hpp"
+#include "round_nearest.hpp"
 
 namespace ivarp {
 namespace impl {
@@ -37,19 +38,28 @@ namespace impl {
          * This inline asm should result in exactly the same output the compiler produces if
          * everything works correctly. */
         __m128i x, tmp;
-        asm("vmovq %2, %0\n"
-            "negq %2\n"
-            "vmovq %2, %1\n"
-            "vpunpcklqdq %1, %0, %0\n" : "=x"(x), "=x"(tmp), "+r"(i));
+        asm(IVARP_IA_VEX("vmovq %2, %0\n"
+                         "negq %2\n"
+                         "vmovq %2, %1\n"
+                         "vpunpcklqdq %1, %0, %0\n",
+                         "movq %2, %0\n"
+                         "negq %2\n"
+                         "movq %2, %1\n"
+                         "punpcklqdq %1, %0\n") : "=x"(x), "=x"(tmp), "+r"(i));
         // x should now contain [i,-i]
         __m128i xH = _mm_srai_epi32(x, 16);
         xH = _mm_blend_epi16(xH, _mm_setzero_si128(), 0x33);
         xH = _mm_add_epi64(xH, _mm_castpd_si128(_mm_set1_pd(442721857769029238784.)));
         __m128i xL = _mm_blend_epi16(x, _mm_castpd_si128(_mm_set1_pd(0x0010000000000000)), 0x88);
         __m128d f = _mm_sub_pd(_mm_castsi128_pd(xH), _mm_set1_pd(442726361368656609280.));
+#if IVARP_IA_ROUND_TO_NEAREST
+        f = add_down_pd(f, _mm_castsi128_pd(xL));
+        return _mm_xor_pd(f, SWITCH_UPPER_SIGN128);
+#else
         f = _mm_add_pd(f, _mm_castsi128_pd(xL));
-        asm("vxorpd %1, %0, %0" : "+x"(f) : "m"(SWITCH_UPPER_SIGN128));
+        asm(IVARP_IA_VEX("vxorpd %1, %0, %0", "xorpd %1, %0") : "+x"(f) : "m"(SWITCH_UPPER_SIGN128));
         return f;
+#endif
     }
 
     inline __m128d u64_to_intervald(std::uint64_t i) IVARP_FN_PURE;
@@ -63,15 +73,22 @@ namespace impl {
         const __m128i two84 = _mm_castpd_si128(_mm_set_pd(-19342813113834066795298816., 19342813113834066795298816.));
         const __m128d sum8452 = _mm_set_pd(-19342813118337666422669312., 19342813118337666422669312.);
         __m128i x;
-        asm("vmovq %1, %0\n"
-            "vpshufd $68, %0, %0\n" : "=x"(x) : "r"(i));
+        asm(IVARP_IA_VEX("vmovq %1, %0\n"
+                         "vpshufd $68, %0, %0\n",
+                         "movq %1, %0\n"
+                         "pshufd $68, %0, %0\n") : "=x"(x) : "r"(i));
         __m128i xH = _mm_srli_epi64(x, 32);
         xH = _mm_or_si128(xH, two84);
         __m128i xL = _mm_blend_epi16(x, two52, 0xcc);
         __m128d f = _mm_sub_pd(_mm_castsi128_pd(xH), sum8452);
+#if IVARP_IA_ROUND_TO_NEAREST
+        f = add_down_pd(f, _mm_castsi128_pd(xL));
+        return _mm_xor_pd(f, SWITCH_UPPER_SIGN128);
+#else
         f = _mm_add_pd(f, _mm_castsi128_pd(xL));
-        asm("vxorpd %1, %0, %0" : "+x"(f) : "m"(SWITCH_UPPER_SIGN128));
+        asm(IVARP_IA_VEX("vxorpd %1, %0, %0", "xorpd %1, %0") : "+x"(f) : "m"(SWITCH_UPPER_SIGN128));
         return f;
+#endif
     }
 }
 }
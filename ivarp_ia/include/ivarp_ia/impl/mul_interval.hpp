@@ -26,18 +26,23 @@ namespace impl {
     static const __m128d SWITCH_LOWER_SIGN128 = _mm_castsi128_pd( // NOLINT
         _mm_set_epi64x(0, std::numeric_limits<std::int64_t>::min())
     );
+    inline __m128d horizontal_min(__m128d vlow, __m128d vhigh) noexcept IVARP_FN_PURE;
+    __m128d horizontal_min(__m128d vlow, __m128d vhigh) noexcept {
+        vlow = _mm_min_pd(vlow, vhigh);
+        __m128d high64 = _mm_unpackhi_pd(vlow, vlow);
+        return _mm_min_sd(vlow, high64);
+    }
+
+#if defined(__AVX__)
     static const __m256d SWITCH_ALL_SIGNS256 = _mm256_castsi256_pd( // NOLINT
         _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::min())
     );
 
     inline __m128d horizontal_min(__m256d x) noexcept IVARP_FN_PURE;
     __m128d horizontal_min(__m256d x) noexcept {
-        __m128d vlow  = _mm256_castpd256_pd128(x);
-        __m128d vhigh = _mm256_extractf128_pd(x, 1);
-        vlow = _mm_min_pd(vlow, vhigh);
-        __m128d high64 = _mm_unpackhi_pd(vlow, vlow);
-        return _mm_min_sd(vlow, high64);
+        return horizontal_min(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
     }
+#endif
 
     inline __m128d horizontal_max128(__m128d x) noexcept IVARP_FN_PURE;
     __m128d horizontal_max128(__m128d x) noexcept {
@@ -55,11 +60,100 @@ namespace impl {
         return _mm_set_pd(mx[0], mn[0]);
     }
 
-    inline __m128d mul_intervald(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
-    __m128d mul_intervald(__m128d a, __m128d b) noexcept {
-        if(__builtin_expect(_mm_movemask_pd(_mm_cmpunord_pd(a, b)), 0)) {
-            return NAN_INTERVAL;
+    /**
+     * The general product of non-NaN intervals from all four endpoint products;
+     * mul_intervald only uses this if both factors contain zero in their interior.
+     */
+    inline __m128d mul_intervald_mixed(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
+
+    /**
+     * The products a[0] * b[0] rounded down and a[1] * b[1] rounded up for non-NaN a and b;
+     * products 0 * infinity are replaced by 0.
+     */
+    inline __m128d mul_lb_ub_pd(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
+
+    /**
+     * The quotients num[0] / den[0] rounded down and num[1] / den[1] rounded up
+     * for finite num and finite, positive den.
+     */
+    inline __m128d div_lb_ub_pd(__m128d num, __m128d den) noexcept IVARP_FN_PURE;
+#if IVARP_IA_ROUND_TO_NEAREST
+    /// The product of non-NaN intervals with an endpoint product close to the subnormal range.
+    inline __m128d mul_intervald_tiny(__m128d a, __m128d b) noexcept {
+        double lbs[4] = {mul_down_rn(a[0], b[0]), mul_down_rn(a[0], b[1]),
+                         mul_down_rn(a[1], b[0]), mul_down_rn(a[1], b[1])};
+        double ubs[4] = {mul_up_rn(a[0], b[0]), mul_up_rn(a[0], b[1]),
+                         mul_up_rn(a[1], b[0]), mul_up_rn(a[1], b[1])};
+        return _mm_set_pd(*std::max_element(ubs, ubs + 4), *std::min_element(lbs, lbs + 4));
+    }
+
+    __m128d mul_intervald_mixed(__m128d a, __m128d b) noexcept {
+        /* lhs = [a_lb, a_lb, a_ub, a_ub], rhs = [b_lb, b_ub, b_lb, b_ub] */
+        __m256d lhs = _mm256_permute4x64_pd(_mm256_castpd128_pd256(a), 0x50);
+        __m256d rhs = _mm256_insertf128_pd(_mm256_castpd128_pd256(b), b, 1);
+        __m256d zero = _mm256_setzero_pd();
+        /* products rounded to nearest; NaNs from 0*infinity are replaced by 0 */
+        __m256d p = _mm256_mul_pd(lhs, rhs);
+        __m256d nanmask = _mm256_cmp_pd(p, zero, _CMP_ORD_Q);
+        p = _mm256_and_pd(p, nanmask);
+        /* products of non-zero factors close to the subnormal range have inexact error terms */
+        __m256d tiny = _mm256_cmp_pd(_mm256_andnot_pd(SWITCH_ALL_SIGNS256, p), _mm256_set1_pd(RN_TINY), _CMP_LT_OQ);
+        tiny = _mm256_and_pd(tiny, _mm256_cmp_pd(lhs, zero, _CMP_NEQ_OQ));
+        tiny = _mm256_and_pd(tiny, _mm256_cmp_pd(rhs, zero, _CMP_NEQ_OQ));
+        if(__builtin_expect(_mm256_movemask_pd(tiny), 0)) {
+            return mul_intervald_tiny(a, b);
+        }
+        /* the exact product is p + err; err is NaN for infinite or replaced products */
+        __m256d err = _mm256_fmsub_pd(lhs, rhs, p);
+        __m256d down = _mm256_blendv_pd(p, next_down_pd(p), _mm256_cmp_pd(err, zero, _CMP_LT_OQ));
+        __m256d up = _mm256_blendv_pd(p, next_up_pd(p), _mm256_cmp_pd(err, zero, _CMP_GT_OQ));
+        __m128d rdmin = horizontal_min(down);
+        __m128d rumin = horizontal_min(_mm256_xor_pd(up, SWITCH_ALL_SIGNS256));
+        __m128d rumax = _mm_xor_pd(rumin, SWITCH_LOWER_SIGN128);
+        return _mm_set_pd(rumax[0], rdmin[0]);
+    }
+
+    /// Round v[0] down and v[1] up, where the exact values are v + err (NaN in err: no known error).
+    inline __m128d round_lb_ub_pd(__m128d v, __m128d err) noexcept IVARP_FN_PURE;
+    __m128d round_lb_ub_pd(__m128d v, __m128d err) noexcept {
+        /* negating the upper lane turns rounding it up into rounding down */
+        v = _mm_xor_pd(v, SWITCH_UPPER_SIGN128);
+        err = _mm_xor_pd(err, SWITCH_UPPER_SIGN128);
+        __m128d r = _mm_blendv_pd(v, next_down_pd(v), _mm_cmplt_pd(err, _mm_setzero_pd()));
+        return _mm_xor_pd(r, SWITCH_UPPER_SIGN128);
+    }
+
+    __m128d mul_lb_ub_pd(__m128d a, __m128d b) noexcept {
+        __m128d zero = _mm_setzero_pd();
+        __m128d p = _mm_mul_pd(a, b);
+        __m128d tiny = _mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, p), _mm_set1_pd(RN_TINY));
+        tiny = _mm_and_pd(tiny, _mm_and_pd(_mm_cmpneq_pd(a, zero), _mm_cmpneq_pd(b, zero)));
+        if(__builtin_expect(_mm_movemask_pd(tiny), 0)) {
+            p = _mm_set_pd(mul_up_rn(a[1], b[1]), mul_down_rn(a[0], b[0]));
+            return _mm_and_pd(p, _mm_cmpord_pd(p, zero));
+        }
+        /* the error term is NaN for infinite products and for 0 * infinity, which is replaced by 0 */
+        __m128d err = _mm_fmsub_pd(a, b, p);
+        p = _mm_and_pd(p, _mm_cmpord_pd(p, zero));
+        return round_lb_ub_pd(p, err);
+    }
+
+    __m128d div_lb_ub_pd(__m128d num, __m128d den) noexcept {
+        __m128d q = _mm_div_pd(num, den);
+        /* the remainder is inexact for tiny numerators or quotients */
+        __m128d limit = _mm_set1_pd(RN_TINY);
+        __m128d tiny = _mm_or_pd(_mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, q), limit),
+                                 _mm_cmplt_pd(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, num), limit));
+        tiny = _mm_and_pd(tiny, _mm_cmpneq_pd(num, _mm_setzero_pd()));
+        if(__builtin_expect(_mm_movemask_pd(tiny), 0)) {
+            return _mm_set_pd(div_up_rn(num[1], den[1]), div_down_rn(num[0], den[0]));
         }
+        /* den > 0, so the exact quotient q + r / den is above q iff r > 0 */
+        return round_lb_ub_pd(q, _mm_fnmadd_pd(q, den, num));
+    }
+#else
+#if defined(__AVX2__)
+    __m128d mul_intervald_mixed(__m128d a, __m128d b) noexcept {
         /* lhs_rd = [a_lb, a_lb, a_ub, a_ub] */
         __m256d lhs_rd = _mm256_permute4x64_pd(_mm256_castpd128_pd256(a), 0x50);
         /* lhs_ru = [-a_lb, -a_lb, -a_ub, -a_ub] */
@@ -81,20 +175,230 @@ namespace impl {
         __m128d rumax = _mm_xor_pd(rumin, SWITCH_LOWER_SIGN128);
         return _mm_set_pd(rumax[0], rdmin[0]);
     }
+#else
+    __m128d mul_intervald_mixed(__m128d a, __m128d b) noexcept {
+        /* the same products as above, in two halves: [a_lb, a_lb] * b and [a_ub, a_ub] * b */
+        __m128d rd_lo = _mm_unpacklo_pd(a, a);
+        __m128d rd_hi = _mm_unpackhi_pd(a, a);
+        __m128d ru_lo = _mm_xor_pd(rd_lo, SWITCH_BOTH_SIGNS128);
+        __m128d ru_hi = _mm_xor_pd(rd_hi, SWITCH_BOTH_SIGNS128);
+        asm(IVARP_IA_VEX("vmulpd %0, %1, %0", "mulpd %1, %0") : "+x"(rd_lo) : "x"(b));
+        asm(IVARP_IA_VEX("vmulpd %0, %1, %0", "mulpd %1, %0") : "+x"(rd_hi) : "x"(b));
+        asm(IVARP_IA_VEX("vmulpd %0, %1, %0", "mulpd %1, %0") : "+x"(ru_lo) : "x"(b));
+        asm(IVARP_IA_VEX("vmulpd %0, %1, %0", "mulpd %1, %0") : "+x"(ru_hi) : "x"(b));
+        __m128d nanmask_lo = _mm_cmpord_pd(rd_lo, rd_lo);
+        __m128d nanmask_hi = _mm_cmpord_pd(rd_hi, rd_hi);
+        __m128d rdmin = horizontal_min(_mm_and_pd(rd_lo, nanmask_lo), _mm_and_pd(rd_hi, nanmask_hi));
+        __m128d rumin = horizontal_min(_mm_and_pd(ru_lo, nanmask_lo), _mm_and_pd(ru_hi, nanmask_hi));
+        __m128d rumax = _mm_xor_pd(rumin, SWITCH_LOWER_SIGN128);
+        return _mm_set_pd(rumax[0], rdmin[0]);
+    }
+#endif
+
+    __m128d mul_lb_ub_pd(__m128d a, __m128d b) noexcept {
+        /* [a_lb * b_lb, -(-a_ub * b_ub)] */
+        __m128d lhs = _mm_xor_pd(a, SWITCH_UPPER_SIGN128);
+        asm(IVARP_IA_VEX("vmulpd %0, %1, %0", "mulpd %1, %0") : "+x"(lhs) : "x"(b));
+        lhs = _mm_and_pd(lhs, _mm_cmpord_pd(lhs, lhs));
+        return _mm_xor_pd(lhs, SWITCH_UPPER_SIGN128);
+    }
+
+    __m128d div_lb_ub_pd(__m128d num, __m128d den) noexcept {
+        /* [num_lb / den_lb, -(-num_ub / den_ub)] */
+        __m128d lhs = _mm_xor_pd(num, SWITCH_UPPER_SIGN128);
+        asm(IVARP_IA_VEX("vdivpd %1, %0, %0", "divpd %1, %0") : "+x"(lhs) : "x"(den));
+        return _mm_xor_pd(lhs, SWITCH_UPPER_SIGN128);
+    }
+#endif
+
+    /**
+     * The product of the non-NaN interval a and the non-negative interval b (b_lb >= 0).
+     * Each endpoint of a is multiplied by the endpoint of b selected by its sign,
+     * so only two products are needed.
+     */
+    inline __m128d mul_intervald_nonneg_rhs(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
+    __m128d mul_intervald_nonneg_rhs(__m128d a, __m128d b) noexcept {
+        /* lower bound: a_lb * (a_lb < 0 ? b_ub : b_lb), upper bound: a_ub * (a_ub < 0 ? b_lb : b_ub) */
+        __m128d swapped = _mm_shuffle_pd(b, b, 1);
+        return mul_lb_ub_pd(a, _mm_blendv_pd(b, swapped, a));
+    }
+
+    /**
+     * Interval multiplication; the signs of the bounds are classified at runtime
+     * and only products of two intervals that both contain zero in their interior use four products.
+     */
+    inline __m128d mul_intervald(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
+    __m128d mul_intervald(__m128d a, __m128d b) noexcept {
+        if(__builtin_expect(_mm_movemask_pd(_mm_cmpunord_pd(a, b)), 0)) {
+            return NAN_INTERVAL;
+        }
+        /* classify by sign bits; a clear sign bit implies >= 0, a set sign bit implies <= 0 */
+        int sa = _mm_movemask_pd(a), sb = _mm_movemask_pd(b);
+        if(sb == 0) {
+            return mul_intervald_nonneg_rhs(a, b);
+        }
+        if(sa == 0) {
+            return mul_intervald_nonneg_rhs(b, a);
+        }
+        if((sa & sb) == 1) {
+            return mul_intervald_mixed(a, b);
+        }
+        /* one factor is non-positive; a * b = -(a * (-b)) and negation is exact */
+        if(sb == 3) {
+            return negate_intervald(mul_intervald_nonneg_rhs(a, negate_intervald(b)));
+        }
+        return negate_intervald(mul_intervald_nonneg_rhs(b, negate_intervald(a)));
+    }
+
+    /**
+     * Multiplication of intervals that are expected to be non-negative: [a_lb * b_lb, a_ub * b_ub].
+     * Falls back to mul_intervald if that expectation does not hold.
+     */
+    inline __m128d mul_intervald_nonneg(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
+    __m128d mul_intervald_nonneg(__m128d a, __m128d b) noexcept {
+        if(__builtin_expect(a[0] >= 0.0 && b[0] >= 0.0 && !_mm_movemask_pd(_mm_cmpunord_pd(a, b)), 1)) {
+            return mul_lb_ub_pd(a, b);
+        }
+        return mul_intervald(a, b);
+    }
 
+    /**
+     * Whether s is a normal power of two (of either sign); multiplying by s (or 1/s)
+     * is exact unless the result leaves the range of normal numbers.
+     */
+    inline bool is_power_of_two(double s) noexcept IVARP_FN_PURE;
+    bool is_power_of_two(double s) noexcept {
+        std::uint64_t bits;
+        std::memcpy(&bits, &s, sizeof(bits));
+        std::uint64_t exponent = (bits >> 52) & 0x7ffu;
+        return (bits & ((std::uint64_t(1) << 52) - 1)) == 0 && exponent != 0 && exponent != 0x7ffu;
+    }
+
+    /**
+     * Whether p = x * s for a power of two s was computed exactly, i.e., no entry of p
+     * underflowed or overflowed. Depending on the rounding mode, an underflowing or
+     * overflowing product may be rounded to the smallest or largest normal number,
+     * so these are treated as inexact as well.
+     */
+    inline bool scaling_exact(__m128d x, __m128d p) noexcept IVARP_FN_PURE;
+    bool scaling_exact(__m128d x, __m128d p) noexcept {
+        __m128d ax = _mm_andnot_pd(SWITCH_BOTH_SIGNS128, x);
+        __m128d ap = _mm_andnot_pd(SWITCH_BOTH_SIGNS128, p);
+        __m128d inf = _mm_set1_pd(std::numeric_limits<double>::infinity());
+        __m128d no_underflow = _mm_or_pd(_mm_cmpgt_pd(ap, _mm_set1_pd(std::numeric_limits<double>::min())),
+                                         _mm_cmpeq_pd(ax, _mm_setzero_pd()));
+        __m128d no_overflow = _mm_or_pd(_mm_cmplt_pd(ap, _mm_set1_pd(std::numeric_limits<double>::max())),
+                                        _mm_cmpeq_pd(ax, inf));
+        return _mm_movemask_pd(_mm_and_pd(no_underflow, no_overflow)) == 3;
+    }
+
+    /**
+     * Multiplication of an interval by a scalar. The sign of the scalar selects the rounding
+     * direction of each bound, so only two products are needed; if the scalar is a power of two,
+     * the product is usually exact and needs no rounding at all.
+     */
+    inline __m128d mul_scalar_intervald(__m128d x, double s) noexcept IVARP_FN_PURE;
+    __m128d mul_scalar_intervald(__m128d x, double s) noexcept {
+        __m128d sv = _mm_set1_pd(s);
+        if(__builtin_expect(_mm_movemask_pd(_mm_cmpunord_pd(x, sv)), 0)) {
+            return NAN_INTERVAL;
+        }
+        /* multiplying by a negative scalar swaps the bounds */
+        __m128d xs = (s < 0.0) ? _mm_shuffle_pd(x, x, 1) : x;
+        if(is_power_of_two(s)) {
+            __m128d p = _mm_mul_pd(xs, sv);
+            if(__builtin_expect(scaling_exact(xs, p), 1)) {
+                return p;
+            }
+        }
+        return mul_lb_ub_pd(xs, sv);
+    }
+
+#if IVARP_IA_ROUND_TO_NEAREST
+    /// x^N for non-negative x by repeated squaring, rounding every product in the same direction.
+    template<unsigned N, bool Up> struct PowNonnegative {
+        static double round(double x, double y) noexcept {
+            return Up ? mul_up_rn(x, y) : mul_down_rn(x, y);
+        }
+
+        static double compute(double x) noexcept {
+            double h = PowNonnegative<N/2, Up>::compute(x);
+            double r = round(h, h);
+            return (N % 2 == 1) ? round(r, x) : r;
+        }
+    };
+    template<bool Up> struct PowNonnegative<1u, Up> {
+        static double compute(double x) noexcept {
+            return x;
+        }
+    };
+    template<bool Up> struct PowNonnegative<0u, Up> {
+        static double compute(double) noexcept {
+            return 1.0;
+        }
+    };
+
+    template<unsigned N> double pow_ru_single(double x) noexcept IVARP_FN_PURE;
+    template<unsigned N> double pow_ru_single(double x) noexcept {
+        return PowNonnegative<N, true>::compute(x);
+    }
+
+    /// [lb^N, ub^N] for 0 <= lb <= ub, rounding the lower bound down and the upper bound up.
+    template<unsigned N> struct PowNonnegativeInterval {
+        static __m128d compute(__m128d x) noexcept {
+            __m128d h = PowNonnegativeInterval<N/2>::compute(x);
+            __m128d r = mul_nonneg_lb_ub_pd(h, h);
+            return (N % 2 == 1) ? mul_nonneg_lb_ub_pd(r, x) : r;
+        }
+    };
+    template<> struct PowNonnegativeInterval<1u> {
+        static __m128d compute(__m128d x) noexcept {
+            return x;
+        }
+    };
+
+    template<unsigned N>
+    inline __m128d fixed_pow(__m128d x) noexcept IVARP_FN_PURE;
+    template<unsigned N>
+    __m128d fixed_pow(__m128d x) noexcept
+    {
+        if(__builtin_expect(x[0] != x[0] || x[1] != x[1], 0)) {
+            return NAN_INTERVAL;
+        }
+        if(N == 0) {
+            return _mm_set1_pd(1.0);
+        } else if(N == 1) {
+            return x;
+        } else if(N % 2 == 0) {
+            __m128d sorted = horizontal_sort(_mm_andnot_pd(SWITCH_BOTH_SIGNS128, x));
+            if(x[0] <= 0.0 && x[1] >= 0.0) {
+                sorted = _mm_move_sd(sorted, _mm_setzero_pd());
+            }
+            return PowNonnegativeInterval<N>::compute(sorted);
+        } else if(x[0] >= 0.0) {
+            return PowNonnegativeInterval<N>::compute(x);
+        } else if(x[1] <= 0.0) {
+            return negate_intervald(PowNonnegativeInterval<N>::compute(negate_intervald(x)));
+        } else {
+            double l = x[0] >= 0.0 ? PowNonnegative<N, false>::compute(x[0]) : -PowNonnegative<N, true>::compute(-x[0]);
+            double u = x[1] >= 0.0 ? PowNonnegative<N, true>::compute(x[1]) : -PowNonnegative<N, false>::compute(-x[1]);
+            return _mm_set_pd(u, l);
+        }
+    }
+#else
     template<unsigned N> struct PowSingle {
         static double compute(double x, std::true_type) noexcept IVARP_FN_PURE {
             double xsq = PowSingle<N/2>::compute(x);
             double y = -xsq;
-            asm("vmulsd %0, %1, %0" : "+x"(xsq) : "x"(y));
-            asm("vmulsd %0, %1, %0" : "+x"(xsq) : "x"(x));
+            asm(IVARP_IA_VEX("vmulsd %0, %1, %0", "mulsd %1, %0") : "+x"(xsq) : "x"(y));
+            asm(IVARP_IA_VEX("vmulsd %0, %1, %0", "mulsd %1, %0") : "+x"(xsq) : "x"(x));
             return -xsq;
         }
 
         static double compute(double x, std::false_type) noexcept IVARP_FN_PURE {
             x = PowSingle<N/2>::compute(x);
             double y = -x;
-            asm("vmulsd %0, %1, %0" : "+x"(x) : "x"(y));
+            asm(IVARP_IA_VEX("vmulsd %0, %1, %0", "mulsd %1, %0") : "+x"(x) : "x"(y));
             return -x;
         }
 
@@ -118,7 +422,7 @@ namespace impl {
         {
             __m128d xsq = PowInterval<N/2>::compute(x, signswap);
             __m128d y = _mm_xor_pd(xsq, signswap);
-            asm("vmulpd %0, %1, %0" : "+x"(xsq) : "x"(y));
+            asm(IVARP_IA_VEX("vmulpd %0, %1, %0", "mulpd %1, %0") : "+x"(xsq) : "x"(y));
             return xsq;
         }
 
@@ -126,8 +430,8 @@ namespace impl {
         {
             __m128d xsq = PowInterval<N/2>::compute(x, signswap);
             __m128d y = _mm_xor_pd(xsq, signswap);
-            asm("vmulpd %0, %1, %0" : "+x"(xsq) : "x"(y));
-            asm("vmulpd %0, %1, %0" : "+x"(xsq) : "x"(x));
+            asm(IVARP_IA_VEX("vmulpd %0, %1, %0", "mulpd %1, %0") : "+x"(xsq) : "x"(y));
+            asm(IVARP_IA_VEX("vmulpd %0, %1, %0", "mulpd %1, %0") : "+x"(xsq) : "x"(x));
             return xsq;
         }
 
@@ -183,5 +487,6 @@ namespace impl {
             return _mm_xor_pd(x, SWITCH_UPPER_SIGN128);
         }
     }
+#endif
 }
 }
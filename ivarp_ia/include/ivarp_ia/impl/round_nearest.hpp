@@ -0,0 +1,219 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <x86intrin.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "attributes.hpp"
+
+#if IVARP_IA_ROUND_TO_NEAREST && !(defined(__AVX2__) && defined(__FMA__))
+#error "The round-to-nearest backend (IVARP_IA_ROUND_TO_NEAREST) requires AVX2 and FMA."
+#endif
+
+/*
+ * Building blocks of the rounding-mode-independent backend (IVARP_IA_ROUND_TO_NEAREST).
+ * All operations are performed in the default round-to-nearest mode; an error-free
+ * transformation (TwoSum for addition, FMA for products, quotients and square roots)
+ * yields the sign of the rounding error, and the result is moved by one ulp if it was
+ * rounded in the wrong direction. This reproduces directed rounding exactly, except
+ * close to the subnormal range where the error term may underflow; there, the result
+ * is moved outward unconditionally, which may cost one ulp but remains rigorous.
+ */
+namespace ivarp {
+namespace impl {
+    /// Below this magnitude (about 2^-956), the error terms computed with FMA are not necessarily exact;
+    /// they are exact above 2^-969 (the error of a product then lies above the subnormal range).
+    static constexpr double RN_TINY = 1.0e-288;
+
+    inline double next_down(double x) noexcept IVARP_FN_PURE;
+    /// The largest double below x; NaN and -inf are returned unchanged.
+    inline double next_down(double x) noexcept {
+        if(!(x > -std::numeric_limits<double>::infinity())) {
+            return x;
+        }
+        if(x == 0.0) {
+            return -std::numeric_limits<double>::denorm_min();
+        }
+        std::uint64_t bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        bits = (x > 0.0) ? bits - 1 : bits + 1;
+        std::memcpy(&x, &bits, sizeof(bits));
+        return x;
+    }
+
+    inline double next_up(double x) noexcept IVARP_FN_PURE;
+    /// The smallest double above x; NaN and inf are returned unchanged.
+    inline double next_up(double x) noexcept {
+        return -next_down(-x);
+    }
+
+    /// One step down for each entry (positive entries and inf: bits - 1, negative entries: bits + 1).
+    /// Only valid for non-zero, non-NaN entries other than -inf.
+    inline __m128d next_down_pd(__m128d x) noexcept IVARP_FN_PURE;
+    inline __m128d next_down_pd(__m128d x) noexcept {
+        __m128i negative = _mm_castpd_si128(_mm_cmplt_pd(x, _mm_setzero_pd()));
+        __m128i delta = _mm_or_si128(_mm_xor_si128(negative, _mm_set1_epi64x(-1)), _mm_set1_epi64x(1));
+        return _mm_castsi128_pd(_mm_add_epi64(_mm_castpd_si128(x), delta));
+    }
+
+#if defined(__AVX2__)
+    inline __m256d next_down_pd(__m256d x) noexcept IVARP_FN_PURE;
+    inline __m256d next_down_pd(__m256d x) noexcept {
+        __m256i negative = _mm256_castpd_si256(_mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ));
+        __m256i delta = _mm256_or_si256(_mm256_xor_si256(negative, _mm256_set1_epi64x(-1)), _mm256_set1_epi64x(1));
+        return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(x), delta));
+    }
+
+    /// One step up for each entry; only valid for non-zero, non-NaN entries other than inf.
+    inline __m256d next_up_pd(__m256d x) noexcept IVARP_FN_PURE;
+    inline __m256d next_up_pd(__m256d x) noexcept {
+        __m256i negative = _mm256_castpd_si256(_mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ));
+        __m256i delta = _mm256_or_si256(negative, _mm256_set1_epi64x(1));
+        return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(x), delta));
+    }
+#endif
+
+    /**
+     * Round the non-negative lower bound v[0] down and the non-negative upper bound v[1] up,
+     * where the exact values are v + err (NaN in err means no rounding error is known).
+     */
+    inline __m128d round_nonneg_lb_ub_pd(__m128d v, __m128d err) noexcept IVARP_FN_PURE;
+    inline __m128d round_nonneg_lb_ub_pd(__m128d v, __m128d err) noexcept {
+        __m128d down = _mm_and_pd(_mm_cmplt_pd(err, _mm_setzero_pd()), _mm_castsi128_pd(_mm_set_epi64x(0, -1)));
+        __m128d up = _mm_and_pd(_mm_cmpgt_pd(err, _mm_setzero_pd()), _mm_castsi128_pd(_mm_set_epi64x(-1, 0)));
+        // all-ones masks are -1 as integers: lane 0 gets bits - 1, lane 1 gets bits + 1
+        __m128i delta = _mm_sub_epi64(_mm_castpd_si128(down), _mm_castpd_si128(up));
+        return _mm_castsi128_pd(_mm_add_epi64(_mm_castpd_si128(v), delta));
+    }
+
+    /**
+     * Add both entries, rounding both results down.
+     * TwoSum is exact unless the sum overflows; a finite sum that
+     * overflowed to +inf is replaced by the largest finite double.
+     */
+    inline __m128d add_down_pd(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
+    inline __m128d add_down_pd(__m128d a, __m128d b) noexcept {
+        __m128d s = _mm_add_pd(a, b);
+        __m128d bb = _mm_sub_pd(s, a);
+        __m128d err = _mm_add_pd(_mm_sub_pd(a, _mm_sub_pd(s, bb)), _mm_sub_pd(b, bb));
+        __m128d step = _mm_cmplt_pd(err, _mm_setzero_pd());
+        __m128d overflow = _mm_cmpeq_pd(s, _mm_set1_pd(std::numeric_limits<double>::infinity()));
+        if(__builtin_expect(_mm_movemask_pd(overflow), 0)) {
+            // a - a + b - b is 0 exactly if both entries are finite
+            __m128d finite = _mm_cmpeq_pd(_mm_add_pd(_mm_sub_pd(a, a), _mm_sub_pd(b, b)), _mm_setzero_pd());
+            step = _mm_or_pd(step, _mm_and_pd(overflow, finite));
+        }
+        return _mm_blendv_pd(s, next_down_pd(s), step);
+    }
+
+    inline double add_down_rn(double a, double b) noexcept IVARP_FN_PURE;
+    inline double add_down_rn(double a, double b) noexcept {
+        return add_down_pd(_mm_set_sd(a), _mm_set_sd(b))[0];
+    }
+
+    /**
+     * Product rounded down; NaN (from 0 * inf) is replaced by 0.
+     * Near the subnormal range, the result is moved down unconditionally,
+     * but not below 0 if the exact product is known to be non-negative.
+     */
+    inline double mul_down_rn(double a, double b) noexcept IVARP_FN_PURE;
+    inline double mul_down_rn(double a, double b) noexcept {
+        double p = a * b;
+        if(p != p) {
+            return 0.0;
+        }
+        if(__builtin_expect(std::fabs(p) < RN_TINY, 0)) {
+            if(a == 0.0 || b == 0.0) {
+                return p;
+            }
+            double d = next_down(p);
+            return (std::signbit(a) == std::signbit(b) && d < 0.0) ? 0.0 : d;
+        }
+        // overflow to +inf yields err = -inf, which steps down to the largest finite double
+        double err = std::fma(a, b, -p);
+        return err < 0.0 ? next_down(p) : p;
+    }
+
+    inline double mul_up_rn(double a, double b) noexcept IVARP_FN_PURE;
+    inline double mul_up_rn(double a, double b) noexcept {
+        return -mul_down_rn(-a, b);
+    }
+
+    /**
+     * Quotient rounded down for non-NaN a and non-zero, non-NaN b.
+     * The remainder a - q * b computed with FMA is exact unless a or q are tiny.
+     */
+    inline double div_down_rn(double a, double b) noexcept IVARP_FN_PURE;
+    inline double div_down_rn(double a, double b) noexcept {
+        bool negative = (std::signbit(a) != std::signbit(b));
+        if(std::isinf(b) && !std::isinf(a)) {
+            return negative ? -0.0 : 0.0;
+        }
+        double q = a / b;
+        if(__builtin_expect(a != 0.0 && (std::fabs(q) < RN_TINY || std::fabs(a) < RN_TINY), 0)) {
+            double d = next_down(q);
+            return (!negative && d < 0.0) ? 0.0 : d;
+        }
+        // the exact quotient is q + r / b; overflow to +inf yields a remainder that steps down
+        double r = std::fma(-q, b, a);
+        return (r != 0.0 && std::signbit(r) != std::signbit(b)) ? next_down(q) : q;
+    }
+
+    inline double div_up_rn(double a, double b) noexcept IVARP_FN_PURE;
+    inline double div_up_rn(double a, double b) noexcept {
+        return -div_down_rn(-a, b);
+    }
+
+    /**
+     * Multiply non-negative entries, rounding lane 0 down and lane 1 up.
+     */
+    inline __m128d mul_nonneg_lb_ub_pd(__m128d a, __m128d b) noexcept IVARP_FN_PURE;
+    inline __m128d mul_nonneg_lb_ub_pd(__m128d a, __m128d b) noexcept {
+        __m128d p = _mm_mul_pd(a, b);
+        __m128d tiny = _mm_and_pd(_mm_cmplt_pd(p, _mm_set1_pd(RN_TINY)),
+                                  _mm_and_pd(_mm_cmpneq_pd(a, _mm_setzero_pd()), _mm_cmpneq_pd(b, _mm_setzero_pd())));
+        if(__builtin_expect(_mm_movemask_pd(tiny), 0)) {
+            return _mm_set_pd(mul_up_rn(a[1], b[1]), mul_down_rn(a[0], b[0]));
+        }
+        return round_nonneg_lb_ub_pd(p, _mm_fmsub_pd(a, b, p));
+    }
+
+    inline double sqrt_down_rn(double x) noexcept IVARP_FN_PURE;
+    inline double sqrt_down_rn(double x) noexcept {
+        double s = std::sqrt(x);
+        if(__builtin_expect(x > 0.0 && x < RN_TINY, 0)) {
+            double d = next_down(s);
+            return d < 0.0 ? 0.0 : d;
+        }
+        return std::fma(-s, s, x) < 0.0 ? next_down(s) : s;
+    }
+
+    inline double sqrt_up_rn(double x) noexcept IVARP_FN_PURE;
+    inline double sqrt_up_rn(double x) noexcept {
+        double s = std::sqrt(x);
+        if(__builtin_expect(x > 0.0 && x < RN_TINY, 0)) {
+            return next_up(s);
+        }
+        return std::fma(-s, s, x) > 0.0 ? next_up(s) : s;
+    }
+}
+}
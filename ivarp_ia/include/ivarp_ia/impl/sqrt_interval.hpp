@@ -23,19 +23,31 @@
 namespace ivarp {
 namespace impl {
     inline __m128d sqrt_intervald(__m128d x) noexcept IVARP_FN_PURE;
+#if IVARP_IA_ROUND_TO_NEAREST
+    __m128d sqrt_intervald(__m128d x) noexcept {
+        __m128d tiny = _mm_and_pd(_mm_cmpgt_pd(x, _mm_setzero_pd()), _mm_cmplt_pd(x, _mm_set1_pd(RN_TINY)));
+        if(__builtin_expect(_mm_movemask_pd(tiny), 0)) {
+            return _mm_set_pd(sqrt_up_rn(x[1]), sqrt_down_rn(x[0]));
+        }
+        /* the exact square root is above s iff x - s^2 > 0 */
+        __m128d s = _mm_sqrt_pd(x);
+        return round_nonneg_lb_ub_pd(s, _mm_fnmadd_pd(s, s, x));
+    }
+#else
     __m128d sqrt_intervald(__m128d x) noexcept {
         /* the most problematic part of this function (w.r.t. compiler bugs) is
          * the compiler moving rounding-mode setting across the sqrt operation. */
         std::uint32_t mxcsr;
         double lb = x[0], ub = x[1];
         asm("stmxcsr %0\n"
-            "vsqrtsd %1, %1, %1\n"
+            IVARP_IA_VEX("vsqrtsd %1, %1, %1\n", "sqrtsd %1, %1\n")
             "xorl $0x6000, %0\n"
             "ldmxcsr %0\n"
-            "vsqrtsd %2, %2, %2\n"
+            IVARP_IA_VEX("vsqrtsd %2, %2, %2\n", "sqrtsd %2, %2\n")
             "xorl $0x6000, %0\n"
             "ldmxcsr %0\n" : "=m"(mxcsr), "+x"(lb), "+x"(ub));
         return _mm_set_pd(ub, lb);
     }
+#endif
 }
 }
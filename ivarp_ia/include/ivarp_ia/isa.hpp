@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstring>
+#include "impl/attributes.hpp"
+
+/*
+ * The instruction set levels the ivarp_ia kernels (which are mostly inline functions)
+ * can be compiled for, and the detection of the level supported by the running CPU.
+ * This header does not use any vector instructions itself, so it can be included by
+ * code that is compiled for the baseline instruction set to select a build at runtime.
+ */
+namespace ivarp {
+    enum class ISALevel : int {
+        SSE42 = 0,  //< SSE4.2 (x86-64-v2); no fused multiply-add
+        AVX2 = 1,   //< AVX2 and FMA (x86-64-v3)
+        AVX512 = 2  //< AVX2, FMA and AVX-512 F/VL/DQ/BW/CD (x86-64-v4)
+    };
+
+    inline const char* isa_level_name(ISALevel level) noexcept {
+        switch(level) {
+            case ISALevel::SSE42: return "sse42";
+            case ISALevel::AVX2: return "avx2";
+            case ISALevel::AVX512: return "avx512";
+        }
+        return "unknown";
+    }
+
+    /**
+     * Parse the name of an instruction set level ("sse42" or "sse4.2", "avx2", "avx512").
+     */
+    inline bool parse_isa_level(const char* name, ISALevel& level) noexcept {
+        if(std::strcmp(name, "sse42") == 0 || std::strcmp(name, "sse4.2") == 0) {
+            level = ISALevel::SSE42;
+        } else if(std::strcmp(name, "avx2") == 0) {
+            level = ISALevel::AVX2;
+        } else if(std::strcmp(name, "avx512") == 0) {
+            level = ISALevel::AVX512;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * The instruction set level the including translation unit is compiled for.
+     */
+    constexpr ISALevel compiled_isa_level() noexcept {
+#if defined(__AVX512F__) && defined(__AVX512VL__) && defined(__AVX512DQ__)
+        return ISALevel::AVX512;
+#elif defined(__AVX2__) && defined(__FMA__)
+        return ISALevel::AVX2;
+#else
+        return ISALevel::SSE42;
+#endif
+    }
+
+    /**
+     * The highest instruction set level supported by the CPU and enabled by the operating system.
+     */
+    inline ISALevel supported_isa_level() noexcept {
+        __builtin_cpu_init();
+        if(!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("fma")) {
+            return ISALevel::SSE42;
+        }
+        if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+           __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw") &&
+           __builtin_cpu_supports("avx512cd"))
+        {
+            return ISALevel::AVX512;
+        }
+        return ISALevel::AVX2;
+    }
+
+    /**
+     * Check a few interval operations of the ivarp_ia library against precomputed results;
+     * this catches builds with broken kernels for an instruction set level as well as a
+     * floating-point environment that was not set up by setup_floating_point_environment().
+     * Returns nullptr if all checks pass, and the name of the first failing check otherwise.
+     */
+    const char* isa_self_test() noexcept IVARP_FN_VISIBLE;
+}
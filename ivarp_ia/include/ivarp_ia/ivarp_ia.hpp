@@ -43,3 +43,4 @@
 #include "ibool.hpp"
 #include "builtin_interval.hpp"
 #include "constant_cache.hpp"
+#include "isa.hpp"
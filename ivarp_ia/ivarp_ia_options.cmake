@@ -15,4 +15,7 @@
 
 option(IVARP_IA_NO_CUDA "Build without CUDA." OFF)
 option(IVARP_IA_COVERAGE "Build with code coverage analysis enabled." OFF)
+option(IVARP_IA_ROUND_TO_NEAREST "Compute interval bounds in round-to-nearest mode using error-free transformations (requires FMA) instead of switching the rounding mode." OFF)
+set(IVARP_IA_ISA_LEVEL "avx2" CACHE STRING "Instruction set level the ivarp_ia library target is compiled for (sse42, avx2 or avx512).")
+set_property(CACHE IVARP_IA_ISA_LEVEL PROPERTY STRINGS sse42 avx2 avx512)
 
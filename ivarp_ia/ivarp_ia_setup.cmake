@@ -35,23 +35,41 @@ find_package(Boost REQUIRED)
 find_package(GMPXX REQUIRED)
 find_package(Threads REQUIRED)
 
-add_library(ivarp_ia SHARED)
-set_target_properties(ivarp_ia PROPERTIES
-	C_VISIBILITY_PRESET hidden
-	CXX_VISIBILITY_PRESET hidden
-	VISIBILITY_INLINES_HIDDEN On
-)
-target_include_directories(ivarp_ia PUBLIC "${CMAKE_CURRENT_LIST_DIR}/include")
-
+set(IVARP_IA_INCLUDE_DIR "${CMAKE_CURRENT_LIST_DIR}/include")
 add_subdirectory("${CMAKE_CURRENT_LIST_DIR}/src" "ivarp_ia_src")
-target_link_libraries(ivarp_ia
-		PUBLIC util::enable_rounding util::use_sse
-		       Boost::boost ivarp::GMPXX ivarp::MPFR Threads::Threads
-		       ivarp::cuda_support
-		PRIVATE util::enable_warnings util::debug_use_asan __ivarp_ia_sources
-)
-target_enable_lto(ivarp_ia)
+
+# Create a (shared) ivarp_ia library target compiled for the given instruction set level;
+# code using the library is compiled for the same level, as most kernels are inline functions.
+function(ivarp_ia_add_library target isa_level)
+	if(IVARP_IA_ROUND_TO_NEAREST AND "${isa_level}" STREQUAL "sse42")
+		message(FATAL_ERROR "The round-to-nearest backend (IVARP_IA_ROUND_TO_NEAREST) requires AVX2 and FMA; it cannot be built for sse42.")
+	endif()
+	if(NOT TARGET util::isa_${isa_level})
+		message(FATAL_ERROR "Unknown instruction set level '${isa_level}' (expected sse42, avx2 or avx512).")
+	endif()
+
+	add_library(${target} SHARED)
+	set_target_properties(${target} PROPERTIES
+		C_VISIBILITY_PRESET hidden
+		CXX_VISIBILITY_PRESET hidden
+		VISIBILITY_INLINES_HIDDEN On
+	)
+	target_include_directories(${target} PUBLIC "${IVARP_IA_INCLUDE_DIR}")
+	target_link_libraries(${target}
+			PUBLIC util::enable_rounding util::use_sse util::isa_${isa_level}
+			       Boost::boost ivarp::GMPXX ivarp::MPFR Threads::Threads
+			       ivarp::cuda_support
+			PRIVATE util::enable_warnings util::debug_use_asan __ivarp_ia_sources
+	)
+	target_enable_lto(${target})
+	if(IVARP_IA_ROUND_TO_NEAREST)
+		target_compile_definitions(${target} PUBLIC IVARP_IA_ROUND_TO_NEAREST=1)
+	endif()
+endfunction()
+
+ivarp_ia_add_library(ivarp_ia "${IVARP_IA_ISA_LEVEL}")
 
 if(IVARP_IA_BUILDING_SELF)
 	add_subdirectory("${CMAKE_CURRENT_LIST_DIR}/test" "ivarp_ia_test")
+	add_subdirectory("${CMAKE_CURRENT_LIST_DIR}/bench" "ivarp_ia_bench")
 endif()
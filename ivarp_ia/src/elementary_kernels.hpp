@@ -0,0 +1,220 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <cmath>
+#include <limits>
+
+/*
+ * Polynomial kernels for exp, ln/log2 and atan (and thus asin/acos).
+ * Each kernel is evaluated in interval arithmetic on a reduced argument; its leading
+ * coefficient also encloses the remainder of the truncated series, so the evaluation
+ * directly yields a rigorous enclosure of the function value (no per-call MPFR).
+ * The coefficient enclosures {lb, ub} are listed highest degree first; they were
+ * obtained by directed rounding of the exact rational coefficients
+ * (and of 120-digit values of ln(2) and atan(j/8)).
+ */
+namespace ivarp {
+namespace impl {
+    /**
+     * exp(r) = sum_{i < 14} r^i/i! + r^14 * exp(xi)/14! for some xi between 0 and r;
+     * for |r| <= 0.35, exp(xi) lies in [0.7046, 1.4191], which gives the leading coefficient.
+     */
+    static const double exp_kernel[15][2] = {
+        {8.082287348160363e-12, 1.6278135077738253e-11},
+        {1.6059043836821613e-10, 1.6059043836821616e-10},
+        {2.0876756987868096e-09, 2.08767569878681e-09},
+        {2.5052108385441717e-08, 2.505210838544172e-08},
+        {2.755731922398589e-07, 2.7557319223985894e-07},
+        {2.755731922398589e-06, 2.7557319223985893e-06},
+        {2.48015873015873e-05, 2.4801587301587305e-05},
+        {0.0001984126984126984, 0.00019841269841269844},
+        {0.0013888888888888887, 0.001388888888888889},
+        {0.008333333333333333, 0.008333333333333335},
+        {0.041666666666666664, 0.04166666666666667},
+        {0.16666666666666666, 0.16666666666666669},
+        {0.5, 0.5},
+        {1.0, 1.0},
+        {1.0, 1.0}
+    };
+
+    /**
+     * ln(m) = 2s * sum_{i >= 0} v^i/(2i+1) with s = (m-1)/(m+1) and v = s^2;
+     * for m in [sqrt(1/2), sqrt(2)), v <= 0.02945 and the tail starting at i = 10
+     * lies in v^10 * [1/21, 1/(21(1-v))].
+     */
+    static const double ln_kernel[11][2] = {
+        {0.047619047619047616, 0.04906398188557789},
+        {0.05263157894736842, 0.052631578947368425},
+        {0.058823529411764705, 0.05882352941176471},
+        {0.06666666666666667, 0.06666666666666668},
+        {0.07692307692307691, 0.07692307692307693},
+        {0.0909090909090909, 0.09090909090909091},
+        {0.1111111111111111, 0.11111111111111112},
+        {0.14285714285714285, 0.14285714285714288},
+        {0.19999999999999998, 0.2},
+        {0.3333333333333333, 0.33333333333333337},
+        {1.0, 1.0}
+    };
+
+    /**
+     * atan(u) = u * sum_{i >= 0} (-1)^i v^i/(2i+1) with v = u^2; for |u| <= atan_kernel_max_u,
+     * the alternating tail starting at i = 6 lies in v^6 * [1/13 - v/15, 1/13].
+     */
+    static const double atan_kernel[7][2] = {
+        {0.07666182625641024, 0.07692307692307693},
+        {-0.09090909090909091, -0.0909090909090909},
+        {0.1111111111111111, 0.11111111111111112},
+        {-0.14285714285714288, -0.14285714285714285},
+        {0.19999999999999998, 0.2},
+        {-0.33333333333333337, -0.3333333333333333},
+        {1.0, 1.0}
+    };
+
+    static constexpr double atan_kernel_max_u = 0.0626;
+
+    /// atan(j/8) for j = 0, ..., 8.
+    static const double atan_table[9][2] = {
+        {0.0, 0.0},
+        {0.12435499454676142, 0.12435499454676144},
+        {0.24497866312686414, 0.24497866312686417},
+        {0.3587706702705722, 0.35877067027057225},
+        {0.4636476090008061, 0.46364760900080615},
+        {0.5585993153435623, 0.5585993153435624},
+        {0.6435011087932844, 0.6435011087932845},
+        {0.7188299996216244, 0.7188299996216245},
+        {0.7853981633974483, 0.7853981633974484}
+    };
+
+    /// ln(2) = ln2_hi + ln2_lo; ln2_hi has 21 trailing zero bits, so k * ln2_hi is exact for |k| < 2^21.
+    static constexpr double ln2_hi = 0.6931471803691238;
+    static constexpr double ln2_lo[2] = {1.9082149292705877e-10, 1.908214929270588e-10};
+    static constexpr double log2_e[2] = {1.4426950408889634, 1.4426950408889636};
+    static constexpr double sqrt_half = 0.7071067811865476;
+
+    static inline IDouble kernel_coefficient(const double (&c)[2]) noexcept {
+        return IDouble(c[0], c[1]);
+    }
+
+    /// Evaluate a kernel at x using Horner's scheme.
+    template<std::size_t N> static inline IDouble eval_kernel(IDouble x, const double (&coeffs)[N][2]) noexcept {
+        IDouble result = kernel_coefficient(coeffs[0]);
+        for(std::size_t i = 1; i < N; ++i) {
+            result = fma(result, x, kernel_coefficient(coeffs[i]));
+        }
+        return result;
+    }
+
+    /// x * 2^k, where the power of two is split in two factors if it is not a normal double.
+    static inline IDouble scale_pow2(IDouble x, int k) noexcept {
+        if(k > 1023 || k < -1022) {
+            int h = k / 2;
+            return (x * std::ldexp(1.0, h)) * std::ldexp(1.0, k - h);
+        }
+        return x * std::ldexp(1.0, k);
+    }
+
+    /// An enclosure of exp(x) for a (possibly infinite) double x.
+    static inline IDouble exp_point(double x) noexcept {
+        if(x == 0.0) {
+            return IDouble(1.0);
+        }
+        if(x > 709.8) {
+            // exp(709.8) > DBL_MAX
+            return IDouble(std::numeric_limits<double>::max(), std::numeric_limits<double>::infinity());
+        }
+        if(x < -745.2) {
+            // exp(-745.2) < 2^-1075, half the smallest subnormal
+            return IDouble(0.0, std::numeric_limits<double>::denorm_min());
+        }
+
+        // x = k * ln(2) + r with |r| <= ln(2)/2 + (rounding errors in the computation of k) < 0.35
+        double k = std::floor(x * log2_e[0] + 0.5);
+        IDouble r = (IDouble(x) - IDouble(k * ln2_hi)) - kernel_coefficient(ln2_lo) * k;
+        return scale_pow2(eval_kernel(r, exp_kernel), static_cast<int>(k));
+    }
+
+    /**
+     * The reduction of a positive finite x to x = m * 2^e with m in [sqrt(1/2), sqrt(2)),
+     * and an enclosure of ln(m).
+     */
+    struct LogReduction {
+        IDouble ln_m;
+        int e;
+    };
+
+    static inline LogReduction reduce_log(double x) noexcept {
+        int e;
+        double m = std::frexp(x, &e);
+        if(m < sqrt_half) {
+            m *= 2.0;
+            --e;
+        }
+        if(m == 1.0) {
+            return LogReduction{IDouble(0.0), e};
+        }
+
+        // m - 1 is exact (Sterbenz); s = (m-1)/(m+1) does not contain 0.
+        IDouble s = IDouble(m - 1.0) / (IDouble(m) + 1.0);
+        return LogReduction{(s * 2.0) * eval_kernel(square(s), ln_kernel), e};
+    }
+
+    /// An enclosure of ln(x) for a positive finite x.
+    static inline IDouble ln_point(double x) noexcept {
+        LogReduction red = reduce_log(x);
+        if(red.e == 0) {
+            return red.ln_m;
+        }
+        double e = red.e;
+        return IDouble(e * ln2_hi) + fma(kernel_coefficient(ln2_lo), e, red.ln_m);
+    }
+
+    /// An enclosure of log2(x) for a positive finite x.
+    static inline IDouble log2_point(double x) noexcept {
+        LogReduction red = reduce_log(x);
+        return fma(red.ln_m, kernel_coefficient(log2_e), IDouble(static_cast<double>(red.e)));
+    }
+
+    /// An enclosure of atan on a narrow interval t contained in [0, 1].
+    static inline IDouble atan_reduced(IDouble t) noexcept {
+        // atan(t) = atan(c) + atan(u) with c = j/8 closest to t and u = (t - c)/(1 + tc), |u| <= 1/16
+        int j = static_cast<int>(8.0 * t.lb() + 0.5);
+        double c = 0.125 * j;
+        IDouble u = (j == 0) ? t : (t - c) / fma(t, c, IDouble(1.0));
+        if(u.lb() < -atan_kernel_max_u || u.ub() > atan_kernel_max_u) {
+            // t is too wide for a single kernel evaluation; this does not happen for points
+            return IDouble(atan_reduced(IDouble(t.lb())).lb(), atan_reduced(IDouble(t.ub())).ub());
+        }
+        return fma(u, eval_kernel(square(u), atan_kernel), kernel_coefficient(atan_table[j]));
+    }
+
+    /// An enclosure of atan on a narrow non-negative interval t.
+    static inline IDouble atan_nonnegative(IDouble t) noexcept {
+        if(t.ub() <= 1.0) {
+            return atan_reduced(t);
+        }
+        // atan(t) = pi/2 - atan(1/t) for t > 0
+        const IDouble pi_half = get_constants<IDouble>().pi_half(0);
+        if(t.lb() > 1.0) {
+            return pi_half - atan_reduced(1.0 / t);
+        }
+        return IDouble(atan_reduced(IDouble(t.lb())).lb(), (pi_half - atan_reduced(1.0 / IDouble(t.ub()))).ub());
+    }
+}
+}
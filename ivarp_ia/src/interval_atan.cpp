@@ -0,0 +1,106 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "elementary_kernels.hpp"
+#include <algorithm>
+
+namespace ivarp {
+namespace impl {
+    /// An enclosure of atan(x) for a (possibly infinite) double x.
+    static inline IDouble atan_point(double x) noexcept {
+        return (x < 0.0) ? -atan_nonnegative(IDouble(-x)) : atan_nonnegative(IDouble(x));
+    }
+
+    /// An enclosure of asin(x) for x in [-1, 1], using asin(x) = atan(x / sqrt((1 - x)(1 + x))).
+    static inline IDouble asin_point(double x) noexcept {
+        if(x < 0.0) {
+            return -asin_point(-x);
+        }
+        if(x == 1.0) {
+            return get_constants<IDouble>().pi_half(0);
+        }
+        IDouble one_minus_x = 1.0 - IDouble(x), one_plus_x = 1.0 + IDouble(x);
+        return atan_nonnegative(x / sqrt(one_minus_x * one_plus_x));
+    }
+
+    /**
+     * An enclosure of acos(x) for x in [-1, 1], using acos(x) = 2 * atan(sqrt((1 - x)/(1 + x)));
+     * unlike pi/2 - asin(x), this does not suffer from cancellation close to x = 1.
+     */
+    static inline IDouble acos_point(double x) noexcept {
+        if(x == -1.0) {
+            return get_constants<IDouble>().pi(0);
+        }
+        IDouble one_minus_x = 1.0 - IDouble(x), one_plus_x = 1.0 + IDouble(x);
+        return 2.0 * atan_nonnegative(sqrt(one_minus_x / one_plus_x));
+    }
+
+    /// Restrict x to [-1, 1]; returns false if x is entirely outside of [-1, 1].
+    static inline bool restrict_to_unit(IDouble x, double& l, double& u, bool& undef) noexcept {
+        if(x.ub() < -1.0 || x.lb() > 1.0) {
+            return false;
+        }
+        undef = (x.lb() < -1.0 || x.ub() > 1.0);
+        l = (std::max)(x.lb(), -1.0);
+        u = (std::min)(x.ub(), 1.0);
+        return true;
+    }
+}
+
+    IDouble atan(IDouble x) noexcept {
+        if(possibly_undefined(x)) {
+            double h = get_constants<IDouble>().pi_half(0).ub();
+            return IDouble(-h, h, true);
+        }
+        if(x.lb() == x.ub()) {
+            return impl::atan_point(x.lb());
+        }
+        return IDouble(impl::atan_point(x.lb()).lb(), impl::atan_point(x.ub()).ub());
+    }
+
+    IDouble asin(IDouble x) noexcept {
+        double l, u;
+        bool undef;
+        if(possibly_undefined(x)) {
+            double h = get_constants<IDouble>().pi_half(0).ub();
+            return IDouble(-h, h, true);
+        }
+        if(!impl::restrict_to_unit(x, l, u, undef)) {
+            return IDouble::undefined_value();
+        }
+        if(l == u && !undef) {
+            return impl::asin_point(l);
+        }
+        return IDouble(impl::asin_point(l).lb(), impl::asin_point(u).ub(), undef);
+    }
+
+    IDouble acos(IDouble x) noexcept {
+        double l, u;
+        bool undef;
+        if(possibly_undefined(x)) {
+            return IDouble(0.0, get_constants<IDouble>().pi(0).ub(), true);
+        }
+        if(!impl::restrict_to_unit(x, l, u, undef)) {
+            return IDouble::undefined_value();
+        }
+        if(l == u && !undef) {
+            return impl::acos_point(l);
+        }
+        // acos is decreasing
+        return IDouble(impl::acos_point(u).lb(), impl::acos_point(l).ub(), undef);
+    }
+}
@@ -16,71 +16,10 @@
  */
 
 
-#include <ivarp_ia/ivarp_ia.hpp>
-#include "period_reduction.hpp"
-#define MPFR_USE_INTMAX_T 1
-#include <mpfr.h>
+#include "sin_cos_cases.hpp"
 
 namespace ivarp {
 namespace impl {
-    /// Implementation of rounded cosine for nonnegative floating-point values.
-    template<bool RoundUp> static double round_cos(double x, unsigned /*precision_ignored*/)
-    {
-        MPFR_DECL_INIT(mx, 53); // NOLINT
-        int ter = mpfr_set_d(mx, x, RoundUp ? MPFR_RNDD : MPFR_RNDU);
-        assert(ter == 0); (void)ter;
-        mpfr_cos(mx, mx, RoundUp ? MPFR_RNDU : MPFR_RNDD);
-        return mpfr_get_d(mx, RoundUp ? MPFR_RNDU : MPFR_RNDD);
-    }
-
-    /// Implementation of interval cosine for interval that do not wrap across a multiple of 2pi.
-    template<typename IT> static inline IT
-        interval_cos_nowrap(const PositivePeriodReduction<IT>& period, const IT& x, unsigned precision)
-    {
-        using Bound = BoundType<IT>;
-        if(period.lb_period_fractional <= 0.5) {
-            if(period.ub_period_fractional <= 0.5) {
-                return IT{round_cos<false>(ub(x), precision), round_cos<true>(lb(x), precision)};
-            } else {
-                return IT{Bound(-1), (std::max)(round_cos<true>(ub(x), precision), round_cos<true>(lb(x), precision))};
-            }
-        } else {
-            return IT{round_cos<false>(lb(x), precision), round_cos<true>(ub(x), precision)};
-        }
-    }
-
-    /// Implementation of interval cosine for intervals for which the lower bound is one 2pi period before the upper bound.
-    template<typename IT> static inline IT
-        interval_cos_wrap(const PositivePeriodReduction<IT>& period, const IT& x, unsigned precision)
-    {
-        using Bound = BoundType<IT>;
-        if(period.lb_period_fractional <= 0.5 || period.ub_period_fractional >= 0.5) {
-            return IT{Bound(-1), Bound(1)};
-        } else {
-            return IT{(std::min)(round_cos<false>(lb(x), precision), round_cos<false>(ub(x), precision)), Bound(1)};
-        }
-    }
-
-    /// Implementation of cosine for non-negative intervals.
-    template<typename IT> static inline IT
-        interval_cos_nonnegative(const IT& x, unsigned precision)
-    {
-        using Bound = BoundType<IT>;
-        PositivePeriodReduction<IT> period = positive_period_reduction(x, get_constants<IT>().rec_2pi(precision));
-        // the bounds are not definitely in adjacent periods
-        if(add_rd(period.lb_period_integral, Bound(1)) < period.ub_period_integral) {
-            return IT{Bound(-1), Bound(1)};
-        }
-
-        if(period.lb_period_integral == period.ub_period_integral) {
-            // no wrap-around
-            return interval_cos_nowrap(period, x, precision);
-        } else {
-            // wrap-around
-            return interval_cos_wrap(period, x, precision);
-        }
-    }
-
     template<typename IT> static inline
         IT interval_cos_symm(const IT& x, unsigned precision)
     {
@@ -89,17 +28,20 @@ namespace impl {
             return IT(Bound(-1), Bound(1), possibly_undefined(x));
         }
 
+        IT nx;
         if(ub(x) <= 0) {
-            return interval_cos_nonnegative(-x, precision);
+            nx = -x;
         } else if(lb(x) < 0) {
             Bound mx = -lb(x);
             if(mx < ub(x)) {
                 mx = ub(x);
             }
-            return interval_cos_nonnegative(IT{0, mx}, precision);
+            nx = IT{0, mx};
         } else {
-            return interval_cos_nonnegative(x, precision);
+            nx = x;
         }
+        SeparateEndpoints ep;
+        return interval_cos_nonnegative(positive_period_reduction(nx, get_constants<IT>().rec_2pi(precision)), nx, ep);
     }
 }
     IDouble cos(IDouble x) noexcept {
@@ -46,8 +46,12 @@ namespace impl {
             act_num = _mm_set_pd(-ubnum, lbnum);
             act_den = _mm_set_pd(lbden, lbden);
         }
-        asm("vdivpd %1, %0, %0" : "+x"(act_num) : "x"(act_den));
+#if IVARP_IA_ROUND_TO_NEAREST
+        return _mm_set_pd(div_up_rn(-act_num[1], act_den[1]), div_down_rn(act_num[0], act_den[0]));
+#else
+        asm(IVARP_IA_VEX("vdivpd %1, %0, %0", "divpd %1, %0") : "+x"(act_num) : "x"(act_den));
         return _mm_xor_pd(act_num, SWITCH_UPPER_SIGN128);
+#endif
     }
 }
 }
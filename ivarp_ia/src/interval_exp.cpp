@@ -0,0 +1,37 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "elementary_kernels.hpp"
+
+namespace ivarp {
+namespace impl {
+    /// exp is increasing; evaluate the kernel at both endpoints (once for points).
+    static inline IDouble interval_exp(IDouble x) noexcept {
+        if(possibly_undefined(x)) {
+            return IDouble(0.0, std::numeric_limits<double>::infinity(), true);
+        }
+        if(x.lb() == x.ub()) {
+            return exp_point(x.lb());
+        }
+        return IDouble(exp_point(x.lb()).lb(), exp_point(x.ub()).ub());
+    }
+}
+
+    IDouble exp(IDouble x) noexcept {
+        return impl::interval_exp(x);
+    }
+}
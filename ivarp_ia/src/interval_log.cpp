@@ -0,0 +1,51 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "elementary_kernels.hpp"
+
+namespace ivarp {
+namespace impl {
+    /**
+     * ln and log2 are increasing on (0, inf); points of x below 0 are outside the domain,
+     * and the logarithm of 0 is -inf.
+     */
+    template<typename PointFn> static inline IDouble interval_log(IDouble x, PointFn point_fn) noexcept {
+        constexpr double inf = std::numeric_limits<double>::infinity();
+        if(possibly_undefined(x)) {
+            return IDouble(-inf, inf, true);
+        }
+        double l = x.lb(), u = x.ub();
+        if(u < 0.0) {
+            return IDouble::undefined_value();
+        }
+        if(l == u && u > 0.0 && u < inf) {
+            return point_fn(l);
+        }
+        double rl = (l <= 0.0) ? -inf : (l == inf ? std::numeric_limits<double>::max() : point_fn(l).lb());
+        double ru = (u == 0.0) ? -inf : (u == inf ? inf : point_fn(u).ub());
+        return IDouble(rl, ru, l < 0.0);
+    }
+}
+
+    IDouble ln(IDouble x) noexcept {
+        return impl::interval_log(x, &impl::ln_point);
+    }
+
+    IDouble log2(IDouble x) noexcept {
+        return impl::interval_log(x, &impl::log2_point);
+    }
+}
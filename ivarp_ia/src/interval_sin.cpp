@@ -16,95 +16,10 @@
  */
 
 
-#include <ivarp_ia/ivarp_ia.hpp>
-#include "period_reduction.hpp"
-#define MPFR_USE_INTMAX_T 1
-#include <mpfr.h>
+#include "sin_cos_cases.hpp"
 
 namespace ivarp {
 namespace impl {
-    /// Implementation of rounded sine for non-negative floating-point values.
-    template<bool RoundUp>
-    static inline double round_sin(double x, unsigned /*precision_ignored*/) IVARP_FN_RPURE;
-    template<bool RoundUp>
-    static inline double round_sin(double x, unsigned /*precision_ignored*/)
-    {
-        MPFR_DECL_INIT(mx, 53); // NOLINT
-        int ter = mpfr_set_d(mx, x, RoundUp ? MPFR_RNDU : MPFR_RNDD);
-        assert(ter == 0); (void)ter; // There should not be rounding here.
-        mpfr_sin(mx, mx, RoundUp ? MPFR_RNDU : MPFR_RNDD);
-        return mpfr_get_d(mx, RoundUp ? MPFR_RNDU : MPFR_RNDD);
-    }
-
-    /// Implementation of interval sine for intervals that do not wrap across a multiple of 2pi.
-    template<typename IT> static inline IT
-        interval_sin_nowrap(const PositivePeriodReduction<IT>& period, const IT& x, unsigned precision)
-    {
-        using Bound = BoundType<IT>;
-        if(period.lb_period_fractional <= 0.25) {
-            if(period.ub_period_fractional < 0.25) {
-                return IT{round_sin<false>(lb(x), precision), round_sin<true>(ub(x), precision)};
-            } else if(period.ub_period_fractional < 0.75) {
-                return IT{(std::min)(round_sin<false>(lb(x), precision), round_sin<false>(ub(x), precision)), Bound(1)};
-            } else {
-                return IT{Bound(-1), Bound(1)};
-            }
-        } else {
-            if(period.ub_period_fractional < 0.75) {
-                return IT{round_sin<false>(ub(x), precision), round_sin<true>(lb(x), precision)};
-            } else if(period.lb_period_fractional <= 0.75) {
-                return IT{Bound(-1), (std::max)(round_sin<true>(lb(x), precision), round_sin<true>(ub(x), precision))};
-            } else {
-                return IT{round_sin<false>(lb(x), precision), round_sin<true>(ub(x), precision)};
-            }
-        }
-    }
-
-    /// Implementation of interval sine for intervals for which the lower bound is one 2pi period before the upper bound.
-    template<typename IT> static inline IT
-        interval_sin_wrap(const PositivePeriodReduction<IT>& period, const IT& x, unsigned precision)
-    {
-        using Bound = BoundType<IT>;
-        if(period.lb_period_fractional <= 0.25) {
-            return IT{Bound(-1), Bound(1)};
-        } else if(period.lb_period_fractional <= 0.75) {
-            if(period.ub_period_fractional < 0.25) {
-                return IT{Bound(-1), (std::max)(round_sin<true>(lb(x), precision), round_sin<true>(ub(x), precision))};
-            } else {
-                return IT{Bound(-1), Bound(1)};
-            }
-        } else {
-            if(period.ub_period_fractional < 0.25) {
-                return IT{round_sin<false>(lb(x), precision), round_sin<true>(ub(x), precision)};
-            } else if(period.ub_period_fractional < 0.75) {
-                return IT{(std::min)(round_sin<false>(lb(x), precision), round_sin<false>(ub(x), precision)), Bound(1)};
-            } else {
-                return IT{Bound(-1), Bound(1)};
-            }
-        }
-    }
-
-    /// Compute interval sine for non-negative intervals.
-    template<typename IT> static inline IT
-        interval_sin_nonnegative(const IT& x, unsigned precision)
-    {
-        using Bound = BoundType<IT>;
-        // determine which period we are in (and where we are)
-        PositivePeriodReduction<IT> period = positive_period_reduction(x, get_constants<IT>().rec_2pi(precision));
-        // the bounds are not definitely in adjacent periods
-        if(add_rd(period.lb_period_integral, Bound(1)) < period.ub_period_integral) {
-            return IT{Bound(-1), Bound(1)};
-        }
-
-        if(period.lb_period_integral == period.ub_period_integral) {
-            // no wrap-around
-            return interval_sin_nowrap(period, x, precision);
-        } else {
-            // wrap-around
-            return interval_sin_wrap(period, x, precision);
-        }
-    }
-
     /// Use sine's symmetry to get rid of all negative input values.
     template<typename IT>
     static inline IT interval_sin_symm(const IT& x, unsigned precision) {
@@ -113,19 +28,23 @@ namespace impl {
             return IT(Bound(-1), Bound(1), possibly_undefined(x));
         }
 
+        const IT rec_2pi = get_constants<IT>().rec_2pi(precision);
+        SeparateEndpoints ep;
         const auto& l = lb(x);
         const auto& u = ub(x);
         if(u <= 0) {
             // negative
-            return -interval_sin_nonnegative(-x, precision);
+            IT nx = -x;
+            return -interval_sin_nonnegative(positive_period_reduction(nx, rec_2pi), nx, ep);
         } else if(l < 0) {
             // mixed
-            IT rneg = -interval_sin_nonnegative(IT{0, -l}, precision);
-            IT rpos = interval_sin_nonnegative(IT{0, u}, precision);
+            IT neg{0, -l}, pos{0, u};
+            IT rneg = -interval_sin_nonnegative(positive_period_reduction(neg, rec_2pi), neg, ep);
+            IT rpos = interval_sin_nonnegative(positive_period_reduction(pos, rec_2pi), pos, ep);
             return join(rpos, rneg);
         } else {
             // positive
-            return interval_sin_nonnegative(x, precision);
+            return interval_sin_nonnegative(positive_period_reduction(x, rec_2pi), x, ep);
         }
     }
 }
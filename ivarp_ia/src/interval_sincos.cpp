@@ -0,0 +1,133 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <cmath>
+#include "sin_cos_cases.hpp"
+
+namespace ivarp {
+namespace impl {
+    /**
+     * Endpoint evaluation for sine and cosine of the same interval.
+     * Both function values at an endpoint come from a single call to mpfr_sin_cos;
+     * the directed roundings are recovered from its ternary value, so the results
+     * are identical to those of round_sin/round_cos.
+     * At most three distinct endpoints (0, -lb(x), ub(x)) occur per interval.
+     */
+    class SharedEndpoints {
+    public:
+        template<bool RoundUp> double sin(double x) {
+            const Entry& e = lookup(x);
+            return RoundUp ? e.sin_ub : e.sin_lb;
+        }
+
+        template<bool RoundUp> double cos(double x) {
+            const Entry& e = lookup(x);
+            return RoundUp ? e.cos_ub : e.cos_lb;
+        }
+
+    private:
+        struct Entry {
+            double x, sin_lb, sin_ub, cos_lb, cos_ub;
+        };
+
+        const Entry& lookup(double x) {
+            for(unsigned i = 0; i < count; ++i) {
+                if(entries[i].x == x) {
+                    return entries[i];
+                }
+            }
+            assert(count < 3);
+            Entry& e = entries[count++];
+            e.x = x;
+            if(x < 1.0e-270) {
+                // results near the subnormal range would be rounded twice; use separate directed calls
+                e.sin_lb = round_sin<false>(x);
+                e.sin_ub = round_sin<true>(x);
+                e.cos_lb = round_cos<false>(x);
+                e.cos_ub = round_cos<true>(x);
+                return e;
+            }
+
+            MPFR_DECL_INIT(mx, 53); // NOLINT
+            MPFR_DECL_INIT(ms, 53); // NOLINT
+            MPFR_DECL_INIT(mc, 53); // NOLINT
+            int ter = mpfr_set_d(mx, x, MPFR_RNDN);
+            assert(ter == 0);
+            // ternary value: s + 4c, where 0 means exact, 1 rounded up and 2 rounded down
+            ter = mpfr_sin_cos(ms, mc, mx, MPFR_RNDN);
+            set_bounds(mpfr_get_d(ms, MPFR_RNDN), ter & 3, e.sin_lb, e.sin_ub);
+            set_bounds(mpfr_get_d(mc, MPFR_RNDN), ter >> 2, e.cos_lb, e.cos_ub);
+            return e;
+        }
+
+        static void set_bounds(double v, int ter, double& lb, double& ub) noexcept {
+            lb = (ter == 1) ? std::nextafter(v, -HUGE_VAL) : v;
+            ub = (ter == 2) ? std::nextafter(v, HUGE_VAL) : v;
+        }
+
+        Entry entries[3];
+        unsigned count = 0;
+    };
+
+    /// Compute sine and cosine of x, sharing the period reduction and the endpoint evaluations.
+    template<typename IT>
+    static inline std::pair<IT,IT> interval_sincos_symm(const IT& x, const IT& rec_2pi) {
+        using Bound = BoundType<IT>;
+        if(!is_finite(x) || possibly_undefined(x)) {
+            IT r(Bound(-1), Bound(1), possibly_undefined(x));
+            return {r, r};
+        }
+
+        SharedEndpoints ep;
+        const auto& l = lb(x);
+        const auto& u = ub(x);
+        if(u <= 0) {
+            // negative
+            IT nx = -x;
+            PositivePeriodReduction<IT> period = positive_period_reduction(nx, rec_2pi);
+            return {-interval_sin_nonnegative(period, nx, ep), interval_cos_nonnegative(period, nx, ep)};
+        } else if(l < 0) {
+            // mixed; cosine only needs the part with the larger absolute value
+            IT neg{0, -l}, pos{0, u};
+            PositivePeriodReduction<IT> pneg = positive_period_reduction(neg, rec_2pi);
+            PositivePeriodReduction<IT> ppos = positive_period_reduction(pos, rec_2pi);
+            IT rneg = -interval_sin_nonnegative(pneg, neg, ep);
+            IT rpos = interval_sin_nonnegative(ppos, pos, ep);
+            IT c = (-l < u) ? interval_cos_nonnegative(ppos, pos, ep) : interval_cos_nonnegative(pneg, neg, ep);
+            return {join(rpos, rneg), c};
+        } else {
+            // positive
+            PositivePeriodReduction<IT> period = positive_period_reduction(x, rec_2pi);
+            return {interval_sin_nonnegative(period, x, ep), interval_cos_nonnegative(period, x, ep)};
+        }
+    }
+}
+
+    std::pair<IDouble, IDouble> sincos(IDouble x) noexcept {
+        return impl::interval_sincos_symm(x, get_constants<IDouble>().rec_2pi(0));
+    }
+
+    void sincos(const IDouble* x, IDouble* sin_out, IDouble* cos_out, std::size_t n) noexcept {
+        const IDouble rec_2pi = get_constants<IDouble>().rec_2pi(0);
+        for(std::size_t i = 0; i < n; ++i) {
+            std::pair<IDouble, IDouble> r = impl::interval_sincos_symm(x[i], rec_2pi);
+            sin_out[i] = r.first;
+            cos_out[i] = r.second;
+        }
+    }
+}
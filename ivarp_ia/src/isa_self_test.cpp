@@ -0,0 +1,65 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+
+namespace ivarp {
+namespace {
+    struct SelfTestCase {
+        const char* name;
+        IDouble (*compute)();
+        double expected_lb, expected_ub;
+    };
+
+    // the expected bounds are the exact results rounded outward
+    const SelfTestCase self_test_cases[] = {
+        {"add", [] () { return IDouble(0.1) + IDouble(0.2); }, 0.3, 0.30000000000000004},
+        {"sub", [] () { return IDouble(0.2) - IDouble(0.1, 0.3); }, -0.09999999999999998, 0.1},
+        {"mul (mixed)", [] () { return IDouble(-0.1, 0.3) * IDouble(-0.7, 0.9); }, -0.21, 0.27},
+        {"mul (non-negative factor)", [] () { return IDouble(-0.1, 0.3) * IDouble(0.7, 0.9); },
+            -0.09000000000000001, 0.27},
+        {"mul (scalar)", [] () { return IDouble(0.1, 0.3) * 3.0; }, 0.3, 0.9},
+        {"div", [] () { return IDouble(1.0) / IDouble(3.0); }, 0.3333333333333333, 0.33333333333333337},
+        {"div (mixed numerator)", [] () { return IDouble(-1.0, 1.0) / IDouble(3.0); },
+            -0.33333333333333337, 0.33333333333333337},
+        {"sqrt", [] () { return sqrt(IDouble(2.0)); }, 1.414213562373095, 1.4142135623730951},
+        {"fixed_pow<2>", [] () { return fixed_pow<2>(IDouble(0.1)); }, 0.01, 0.010000000000000002},
+        {"int64 conversion", [] () { return IDouble(std::int64_t(4611686018427387905)); },
+            4.611686018427388e+18, 4.611686018427389e+18},
+        {"fma (exact)", [] () { return fma(IDouble(0.5), IDouble(0.25), IDouble(1.0)); }, 1.125, 1.125},
+        {"sin", [] () { return sin(IDouble(1.0)); }, 0.8414709848078965, 0.8414709848078966}
+    };
+}
+
+    const char* isa_self_test() noexcept {
+        for(const SelfTestCase& c : self_test_cases) {
+            IDouble result = c.compute();
+            if(result.lb() != c.expected_lb || result.ub() != c.expected_ub) {
+                return c.name;
+            }
+        }
+
+        // the fused multiply-add may be tighter than, but must be contained in, the unfused result
+        IDouble x(0.1, 0.3), y(-0.7, 0.9), z(0.2);
+        IDouble fused = fma(x, y, z), unfused = x * y + z;
+        if(!(fused.lb() >= unfused.lb() && fused.ub() <= unfused.ub() && fused.lb() < fused.ub())) {
+            return "fma (containment)";
+        }
+        return nullptr;
+    }
+}
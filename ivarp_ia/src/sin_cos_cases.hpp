@@ -0,0 +1,181 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include "period_reduction.hpp"
+#define MPFR_USE_INTMAX_T 1
+#include <mpfr.h>
+
+/*
+ * The case analysis of interval sine and cosine; the function values at the endpoints
+ * are obtained from an Endpoints object with members sin<RoundUp>(x) and cos<RoundUp>(x),
+ * so that sine and cosine of the same interval can share their endpoint evaluations.
+ */
+namespace ivarp {
+namespace impl {
+    /// Implementation of rounded sine for non-negative floating-point values.
+    template<bool RoundUp>
+    static inline double round_sin(double x) IVARP_FN_RPURE;
+    template<bool RoundUp>
+    static inline double round_sin(double x)
+    {
+        MPFR_DECL_INIT(mx, 53); // NOLINT
+        int ter = mpfr_set_d(mx, x, RoundUp ? MPFR_RNDU : MPFR_RNDD);
+        assert(ter == 0); (void)ter; // There should not be rounding here.
+        mpfr_sin(mx, mx, RoundUp ? MPFR_RNDU : MPFR_RNDD);
+        return mpfr_get_d(mx, RoundUp ? MPFR_RNDU : MPFR_RNDD);
+    }
+
+    /// Implementation of rounded cosine for nonnegative floating-point values.
+    template<bool RoundUp> static inline double round_cos(double x)
+    {
+        MPFR_DECL_INIT(mx, 53); // NOLINT
+        int ter = mpfr_set_d(mx, x, RoundUp ? MPFR_RNDD : MPFR_RNDU);
+        assert(ter == 0); (void)ter;
+        mpfr_cos(mx, mx, RoundUp ? MPFR_RNDU : MPFR_RNDD);
+        return mpfr_get_d(mx, RoundUp ? MPFR_RNDU : MPFR_RNDD);
+    }
+
+    /// Endpoint evaluation with one MPFR call per function value.
+    struct SeparateEndpoints {
+        template<bool RoundUp> double sin(double x) const {
+            return round_sin<RoundUp>(x);
+        }
+
+        template<bool RoundUp> double cos(double x) const {
+            return round_cos<RoundUp>(x);
+        }
+    };
+
+    /// Implementation of interval sine for intervals that do not wrap across a multiple of 2pi.
+    template<typename IT, typename Endpoints> static inline IT
+        interval_sin_nowrap(const PositivePeriodReduction<IT>& period, const IT& x, Endpoints& ep)
+    {
+        using Bound = BoundType<IT>;
+        if(period.lb_period_fractional <= 0.25) {
+            if(period.ub_period_fractional < 0.25) {
+                return IT{ep.template sin<false>(lb(x)), ep.template sin<true>(ub(x))};
+            } else if(period.ub_period_fractional < 0.75) {
+                return IT{(std::min)(ep.template sin<false>(lb(x)), ep.template sin<false>(ub(x))), Bound(1)};
+            } else {
+                return IT{Bound(-1), Bound(1)};
+            }
+        } else {
+            if(period.ub_period_fractional < 0.75) {
+                return IT{ep.template sin<false>(ub(x)), ep.template sin<true>(lb(x))};
+            } else if(period.lb_period_fractional <= 0.75) {
+                return IT{Bound(-1), (std::max)(ep.template sin<true>(lb(x)), ep.template sin<true>(ub(x)))};
+            } else {
+                return IT{ep.template sin<false>(lb(x)), ep.template sin<true>(ub(x))};
+            }
+        }
+    }
+
+    /// Implementation of interval sine for intervals for which the lower bound is one 2pi period before the upper bound.
+    template<typename IT, typename Endpoints> static inline IT
+        interval_sin_wrap(const PositivePeriodReduction<IT>& period, const IT& x, Endpoints& ep)
+    {
+        using Bound = BoundType<IT>;
+        if(period.lb_period_fractional <= 0.25) {
+            return IT{Bound(-1), Bound(1)};
+        } else if(period.lb_period_fractional <= 0.75) {
+            if(period.ub_period_fractional < 0.25) {
+                return IT{Bound(-1), (std::max)(ep.template sin<true>(lb(x)), ep.template sin<true>(ub(x)))};
+            } else {
+                return IT{Bound(-1), Bound(1)};
+            }
+        } else {
+            if(period.ub_period_fractional < 0.25) {
+                return IT{ep.template sin<false>(lb(x)), ep.template sin<true>(ub(x))};
+            } else if(period.ub_period_fractional < 0.75) {
+                return IT{(std::min)(ep.template sin<false>(lb(x)), ep.template sin<false>(ub(x))), Bound(1)};
+            } else {
+                return IT{Bound(-1), Bound(1)};
+            }
+        }
+    }
+
+    /// Compute interval sine for non-negative intervals, given the period reduction of x.
+    template<typename IT, typename Endpoints> static inline IT
+        interval_sin_nonnegative(const PositivePeriodReduction<IT>& period, const IT& x, Endpoints& ep)
+    {
+        using Bound = BoundType<IT>;
+        // the bounds are not definitely in adjacent periods
+        if(add_rd(period.lb_period_integral, Bound(1)) < period.ub_period_integral) {
+            return IT{Bound(-1), Bound(1)};
+        }
+
+        if(period.lb_period_integral == period.ub_period_integral) {
+            // no wrap-around
+            return interval_sin_nowrap(period, x, ep);
+        } else {
+            // wrap-around
+            return interval_sin_wrap(period, x, ep);
+        }
+    }
+
+    /// Implementation of interval cosine for interval that do not wrap across a multiple of 2pi.
+    template<typename IT, typename Endpoints> static inline IT
+        interval_cos_nowrap(const PositivePeriodReduction<IT>& period, const IT& x, Endpoints& ep)
+    {
+        using Bound = BoundType<IT>;
+        if(period.lb_period_fractional <= 0.5) {
+            if(period.ub_period_fractional <= 0.5) {
+                return IT{ep.template cos<false>(ub(x)), ep.template cos<true>(lb(x))};
+            } else {
+                return IT{Bound(-1), (std::max)(ep.template cos<true>(ub(x)), ep.template cos<true>(lb(x)))};
+            }
+        } else {
+            return IT{ep.template cos<false>(lb(x)), ep.template cos<true>(ub(x))};
+        }
+    }
+
+    /// Implementation of interval cosine for intervals for which the lower bound is one 2pi period before the upper bound.
+    template<typename IT, typename Endpoints> static inline IT
+        interval_cos_wrap(const PositivePeriodReduction<IT>& period, const IT& x, Endpoints& ep)
+    {
+        using Bound = BoundType<IT>;
+        if(period.lb_period_fractional <= 0.5 || period.ub_period_fractional >= 0.5) {
+            return IT{Bound(-1), Bound(1)};
+        } else {
+            return IT{(std::min)(ep.template cos<false>(lb(x)), ep.template cos<false>(ub(x))), Bound(1)};
+        }
+    }
+
+    /// Implementation of cosine for non-negative intervals, given the period reduction of x.
+    template<typename IT, typename Endpoints> static inline IT
+        interval_cos_nonnegative(const PositivePeriodReduction<IT>& period, const IT& x, Endpoints& ep)
+    {
+        using Bound = BoundType<IT>;
+        // the bounds are not definitely in adjacent periods
+        if(add_rd(period.lb_period_integral, Bound(1)) < period.ub_period_integral) {
+            return IT{Bound(-1), Bound(1)};
+        }
+
+        if(period.lb_period_integral == period.ub_period_integral) {
+            // no wrap-around
+            return interval_cos_nowrap(period, x, ep);
+        } else {
+            // wrap-around
+            return interval_cos_wrap(period, x, ep);
+        }
+    }
+}
+}
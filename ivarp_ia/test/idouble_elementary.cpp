@@ -0,0 +1,197 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <doctest/doctest.hpp>
+#include <mpfr.h>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace ivarp;
+
+namespace {
+    using MPFRFunction = int (*)(mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+
+    /// f(x) rounded down and up to double by MPFR.
+    IDouble mpfr_enclosure(MPFRFunction f, double x) {
+        MPFR_DECL_INIT(mx, 53); // NOLINT
+        MPFR_DECL_INIT(mr, 53); // NOLINT
+        mpfr_set_d(mx, x, MPFR_RNDN);
+        f(mr, mx, MPFR_RNDD);
+        double l = mpfr_get_d(mr, MPFR_RNDD);
+        f(mr, mx, MPFR_RNDU);
+        double u = mpfr_get_d(mr, MPFR_RNDU);
+        return IDouble{l, u};
+    }
+
+    /// The number of doubles strictly between a <= b (up to limit).
+    int doubles_between(double a, double b, int limit) {
+        int n = 0;
+        while(n <= limit && a < b) {
+            a = std::nextafter(a, b);
+            if(a < b) {
+                ++n;
+            }
+        }
+        return n;
+    }
+
+    /**
+     * Check that computed contains the exact value and is at most max_ulps
+     * wider than the MPFR enclosure on each side.
+     */
+    void check_enclosure(IDouble computed, IDouble expected, int max_ulps) {
+        DOCTEST_REQUIRE(!possibly_undefined(computed));
+        DOCTEST_REQUIRE(lb(computed) <= lb(expected));
+        DOCTEST_REQUIRE(ub(computed) >= ub(expected));
+        DOCTEST_REQUIRE(doubles_between(lb(computed), lb(expected), max_ulps) <= max_ulps);
+        DOCTEST_REQUIRE(doubles_between(ub(expected), ub(computed), max_ulps) <= max_ulps);
+    }
+
+    /**
+     * Random doubles in [lb, ub]: uniformly distributed, with uniformly distributed exponent,
+     * or close to one of the bounds.
+     */
+    class RandomArgument {
+    public:
+        RandomArgument(double lb, double ub) : m_uniform(lb, ub), m_lb(lb), m_ub(ub) {}
+
+        double operator()(std::mt19937_64& rng) {
+            double bound = (rng() & 1) ? m_ub : m_lb;
+            double x;
+            switch(rng() % 3) {
+                default:
+                    return m_uniform(rng);
+                case 1: {
+                    int exp_max;
+                    std::frexp(bound, &exp_max);
+                    int exponent = std::uniform_int_distribution<int>(exp_max - 1100, exp_max)(rng);
+                    x = std::copysign(std::ldexp(std::uniform_real_distribution<double>(0.5, 1.0)(rng), exponent), bound);
+                    break;
+                }
+                case 2: {
+                    int exponent = std::uniform_int_distribution<int>(-60, -1)(rng);
+                    x = bound * (1.0 - std::ldexp(std::uniform_real_distribution<double>(0.0, 1.0)(rng), exponent));
+                    break;
+                }
+            }
+            return (x < m_lb || x > m_ub) ? m_uniform(rng) : x;
+        }
+
+    private:
+        std::uniform_real_distribution<double> m_uniform;
+        double m_lb, m_ub;
+    };
+
+    // the round-to-nearest backend composes fma from two roundings and widens results close to the subnormal range
+#if IVARP_IA_ROUND_TO_NEAREST
+    constexpr int max_ulps = 6;
+#else
+    constexpr int max_ulps = 4;
+#endif
+
+    struct ElementaryFunction {
+        const char* name;
+        IDouble (*fn)(IDouble);
+        MPFRFunction mpfr_fn;
+        double lb, ub;
+    };
+
+    const ElementaryFunction elementary_functions[] = {
+        {"exp", &ivarp::exp, &mpfr_exp, -745.0, 709.0},
+        {"ln", &ivarp::ln, &mpfr_log, 0.0, 1.0e300},
+        {"log2", &ivarp::log2, &mpfr_log2, 0.0, 1.0e300},
+        {"atan", &ivarp::atan, &mpfr_atan, -1.0e20, 1.0e20},
+        {"asin", &ivarp::asin, &mpfr_asin, -1.0, 1.0},
+        {"acos", &ivarp::acos, &mpfr_acos, -1.0, 1.0}
+    };
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Elementary functions against MPFR") {
+    std::mt19937_64 rng(47);
+    for(const ElementaryFunction& f : elementary_functions) {
+        DOCTEST_INFO(f.name);
+        RandomArgument arg(f.lb, f.ub);
+        for(int i = 0; i < 100000; ++i) {
+            double x = arg(rng);
+            if(x == 0.0 && f.lb == 0.0) {
+                continue;
+            }
+            DOCTEST_INFO(x);
+            check_enclosure(f.fn(IDouble(x)), mpfr_enclosure(f.mpfr_fn, x), max_ulps);
+        }
+    }
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Elementary functions on intervals") {
+    std::mt19937_64 rng(470);
+    for(const ElementaryFunction& f : elementary_functions) {
+        DOCTEST_INFO(f.name);
+        RandomArgument arg(f.lb, f.ub);
+        for(int i = 0; i < 10000; ++i) {
+            double x = arg(rng), y = arg(rng);
+            if(x > y) {
+                std::swap(x, y);
+            }
+            IDouble r = f.fn(IDouble(x, y)), rx = f.fn(IDouble(x)), ry = f.fn(IDouble(y));
+            // all functions are monotone, acos is decreasing
+            if(f.mpfr_fn == &mpfr_acos) {
+                DOCTEST_REQUIRE(same(r, IDouble(lb(ry), ub(rx))));
+            } else if(x != 0.0 || f.lb != 0.0) {
+                DOCTEST_REQUIRE(same(r, IDouble(lb(rx), ub(ry))));
+            }
+        }
+    }
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Elementary functions at special values") {
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    const IDouble pi = get_constants<IDouble>().pi(0), pi_half = get_constants<IDouble>().pi_half(0);
+
+    DOCTEST_REQUIRE(same(exp(IDouble(0.0)), IDouble(1.0)));
+    DOCTEST_REQUIRE(same(exp(IDouble(-inf, 0.0)), IDouble(0.0, 1.0)));
+    DOCTEST_REQUIRE(same(exp(IDouble(-1000.0)), IDouble(0.0, 5.0e-324)));
+    DOCTEST_REQUIRE(ub(exp(IDouble(0.0, 710.0))) == inf);
+    DOCTEST_REQUIRE(lb(exp(IDouble(710.0))) == std::numeric_limits<double>::max());
+    DOCTEST_REQUIRE(lb(exp(IDouble(-745.0))) == 0.0);
+    DOCTEST_REQUIRE(ub(exp(IDouble(-745.0))) > 0.0);
+    DOCTEST_REQUIRE(ub(exp(IDouble(-745.0))) <= 1.0e-323);
+
+    DOCTEST_REQUIRE(same(ln(IDouble(1.0)), IDouble(0.0)));
+    DOCTEST_REQUIRE(same(log2(IDouble(1.0)), IDouble(0.0)));
+    DOCTEST_REQUIRE(same(log2(IDouble(0.125, 1024.0)), IDouble(-3.0, 10.0)));
+    DOCTEST_REQUIRE(same(log2(IDouble(5.0e-324)), IDouble(-1074.0)));
+    DOCTEST_REQUIRE(same(ln(IDouble(0.0, 1.0)), IDouble(-inf, 0.0)));
+    DOCTEST_REQUIRE(same(ln(IDouble(1.0, inf)), IDouble(0.0, inf)));
+    DOCTEST_REQUIRE(possibly_undefined(ln(IDouble(-2.0, -1.0))));
+    DOCTEST_REQUIRE(possibly_undefined(log2(IDouble(-1.0, 1.0))));
+    DOCTEST_REQUIRE(lb(log2(IDouble(-1.0, 1.0))) == -inf);
+
+    DOCTEST_REQUIRE(same(atan(IDouble(0.0)), IDouble(0.0)));
+    DOCTEST_REQUIRE(same(atan(IDouble(-inf, inf)), IDouble(-ub(pi_half), ub(pi_half))));
+    DOCTEST_REQUIRE(same(atan(IDouble(1.0)), IDouble(0.7853981633974483, 0.7853981633974484)));
+    DOCTEST_REQUIRE(same(asin(IDouble(0.0)), IDouble(0.0)));
+    DOCTEST_REQUIRE(same(asin(IDouble(-1.0, 1.0)), IDouble(-ub(pi_half), ub(pi_half))));
+    DOCTEST_REQUIRE(same(acos(IDouble(1.0)), IDouble(0.0)));
+    DOCTEST_REQUIRE(same(acos(IDouble(-1.0, 1.0)), IDouble(0.0, ub(pi))));
+    DOCTEST_REQUIRE(same(acos(IDouble(-1.0)), pi));
+    DOCTEST_REQUIRE(possibly_undefined(asin(IDouble(1.5, 2.0))));
+    DOCTEST_REQUIRE(possibly_undefined(acos(IDouble(0.5, 2.0))));
+    DOCTEST_REQUIRE(lb(acos(IDouble(0.5, 2.0))) == 0.0);
+    DOCTEST_REQUIRE(possibly_undefined(exp(IDouble(0.0, 1.0, true))));
+}
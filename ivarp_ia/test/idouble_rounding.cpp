@@ -0,0 +1,366 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <doctest/doctest.hpp>
+#include <mpfr.h>
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+using namespace ivarp;
+
+namespace {
+    std::mt19937_64 rounding_rng(std::random_device{}());
+
+    /**
+     * Random doubles of both signs with exponents from different ranges:
+     * moderate, the full range, close to the subnormal range and close to overflow.
+     */
+    double random_double() {
+        static const int exponent_ranges[][2] = {{-60, 60}, {-1074, 1023}, {-1074, -940}, {960, 1023}};
+        const auto& range = exponent_ranges[std::uniform_int_distribution<int>(0, 3)(rounding_rng)];
+        int exponent = std::uniform_int_distribution<int>(range[0], range[1])(rounding_rng);
+        double mantissa = std::uniform_real_distribution<double>(1.0, 2.0)(rounding_rng);
+        double result = std::ldexp(mantissa, exponent);
+        return (rounding_rng() & 1) ? -result : result;
+    }
+
+    /**
+     * A double-precision operation evaluated exactly (or with enough precision) by MPFR,
+     * rounded down and up to double.
+     */
+    class MPFRResult {
+    public:
+        explicit MPFRResult(mpfr_prec_t precision) {
+            mpfr_init2(m_x, 53);
+            mpfr_init2(m_y, 53);
+            mpfr_init2(m_r, precision);
+        }
+
+        ~MPFRResult() {
+            mpfr_clear(m_x);
+            mpfr_clear(m_y);
+            mpfr_clear(m_r);
+        }
+
+        template<typename Op> IDouble compute(double x, double y, Op&& op) {
+            mpfr_set_d(m_x, x, MPFR_RNDN);
+            mpfr_set_d(m_y, y, MPFR_RNDN);
+            op(m_r, m_x, m_y, MPFR_RNDD);
+            double l = mpfr_get_d(m_r, MPFR_RNDD);
+            op(m_r, m_x, m_y, MPFR_RNDU);
+            double u = mpfr_get_d(m_r, MPFR_RNDU);
+            return IDouble{l, u};
+        }
+
+    private:
+        mpfr_t m_x, m_y, m_r;
+    };
+
+    bool is_tiny(double x) noexcept {
+        return x != 0.0 && std::fabs(x) < 1.0e-288;
+    }
+
+    /**
+     * The MXCSR backend reproduces directed rounding exactly; the round-to-nearest
+     * backend may be one ulp wider if an operand or the result is close to the subnormal range.
+     */
+    void check_rounding(IDouble computed, IDouble expected, bool tiny) {
+        DOCTEST_REQUIRE(lb(computed) <= lb(expected));
+        DOCTEST_REQUIRE(ub(computed) >= ub(expected));
+#if IVARP_IA_ROUND_TO_NEAREST
+        if(tiny) {
+            DOCTEST_REQUIRE(lb(computed) >= impl::next_down(lb(expected)));
+            DOCTEST_REQUIRE(ub(computed) <= impl::next_up(ub(expected)));
+            return;
+        }
+#else
+        (void)tiny;
+#endif
+        DOCTEST_REQUIRE(same(computed, expected));
+    }
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Directed rounding of basic operations against MPFR") {
+    constexpr std::size_t n = 200000;
+    // all sums and products of doubles are exact with these precisions
+    MPFRResult add(2200), mul(110), div(200), root(200);
+    for(std::size_t i = 0; i < n; ++i) {
+        double x = random_double(), y = random_double();
+        IDouble ix(x), iy(y);
+        bool tiny = is_tiny(x) || is_tiny(y);
+
+        IDouble e = add.compute(x, y, [] (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, mpfr_rnd_t rnd) { mpfr_add(r, a, b, rnd); });
+        check_rounding(ix + iy, e, false);
+        e = add.compute(x, y, [] (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, mpfr_rnd_t rnd) { mpfr_sub(r, a, b, rnd); });
+        check_rounding(ix - iy, e, false);
+        DOCTEST_REQUIRE(add_rd(x, y) == lb(ix + iy));
+
+        e = mul.compute(x, y, [] (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, mpfr_rnd_t rnd) { mpfr_mul(r, a, b, rnd); });
+        check_rounding(ix * iy, e, tiny || is_tiny(lb(e)) || is_tiny(ub(e)) || lb(e) == 0.0);
+
+        e = div.compute(x, y, [] (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, mpfr_rnd_t rnd) { mpfr_div(r, a, b, rnd); });
+        check_rounding(ix / iy, e, tiny || is_tiny(lb(e)) || is_tiny(ub(e)) || lb(e) == 0.0);
+
+        double ax = std::fabs(x);
+        e = root.compute(ax, 0.0, [] (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr, mpfr_rnd_t rnd) { mpfr_sqrt(r, a, rnd); });
+        check_rounding(sqrt(IDouble(ax)), e, is_tiny(ax));
+    }
+}
+
+namespace {
+    /// A random interval; lb < 0 < ub, lb >= 0 and ub <= 0 are equally likely.
+    IDouble random_interval() {
+        double x = random_double(), y = random_double();
+        switch(rounding_rng() % 3) {
+            case 0: x = -std::fabs(x); y = std::fabs(y); break;
+            case 1: x = std::fabs(x); y = std::fabs(y); break;
+            default: x = -std::fabs(x); y = -std::fabs(y); break;
+        }
+        return IDouble((std::min)(x, y), (std::max)(x, y));
+    }
+
+    /// The hull of op applied to all pairs of endpoints, rounded outward by MPFR.
+    template<typename Op> IDouble endpoint_hull(MPFRResult& mpfr, IDouble x, IDouble y, Op&& op, bool& tiny) {
+        double l = std::numeric_limits<double>::infinity(), u = -l;
+        for(double a : {lb(x), ub(x)}) {
+            for(double b : {lb(y), ub(y)}) {
+                IDouble e = mpfr.compute(a, b, op);
+                tiny |= is_tiny(a) || is_tiny(b) || is_tiny(lb(e)) || is_tiny(ub(e)) || lb(e) == 0.0;
+                l = (std::min)(l, lb(e));
+                u = (std::max)(u, ub(e));
+            }
+        }
+        return IDouble(l, u);
+    }
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Sign-classified multiplication and division against MPFR") {
+    constexpr std::size_t n = 100000;
+    MPFRResult mul(110), div(200);
+    auto mpfr_mul_op = [] (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, mpfr_rnd_t rnd) { mpfr_mul(r, a, b, rnd); };
+    auto mpfr_div_op = [] (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, mpfr_rnd_t rnd) { mpfr_div(r, a, b, rnd); };
+    for(std::size_t i = 0; i < n; ++i) {
+        IDouble x = random_interval(), y = random_interval();
+        bool tiny = false;
+        IDouble e = endpoint_hull(mul, x, y, mpfr_mul_op, tiny);
+        check_rounding(x * y, e, tiny);
+        if(lb(x) >= 0.0 && lb(y) >= 0.0) {
+            check_rounding(mul_nonneg(x, y), e, tiny);
+        }
+        tiny = false;
+        e = endpoint_hull(div, x, y, mpfr_div_op, tiny);
+        if(lb(y) > 0.0 || ub(y) < 0.0) {
+            check_rounding(x / y, e, tiny);
+        }
+        if(lb(y) > 0.0) {
+            check_rounding(div_pos(x, y), e, tiny);
+        }
+    }
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Scalar multiplication and division against MPFR") {
+    constexpr std::size_t n = 100000;
+    MPFRResult mul(110), div(200);
+    auto mpfr_mul_op = [] (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, mpfr_rnd_t rnd) { mpfr_mul(r, a, b, rnd); };
+    auto mpfr_div_op = [] (mpfr_ptr r, mpfr_srcptr a, mpfr_srcptr b, mpfr_rnd_t rnd) { mpfr_div(r, a, b, rnd); };
+    for(std::size_t i = 0; i < n; ++i) {
+        IDouble x = random_interval();
+        double s = random_double();
+        if(rounding_rng() & 1) {
+            // powers of two, including some whose products leave the normal range
+            s = std::ldexp((s < 0.0 ? -1.0 : 1.0), std::uniform_int_distribution<int>(-1022, 1023)(rounding_rng));
+        }
+        bool tiny = false;
+        IDouble e = endpoint_hull(mul, x, IDouble(s), mpfr_mul_op, tiny);
+        check_rounding(x * s, e, tiny);
+        check_rounding(s * x, e, tiny);
+        tiny = false;
+        e = endpoint_hull(div, x, IDouble(s), mpfr_div_op, tiny);
+        check_rounding(x / s, e, tiny);
+    }
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Scalar multiplication and division special cases") {
+    double inf = std::numeric_limits<double>::infinity();
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    double mx = std::numeric_limits<double>::max();
+    double mn = std::numeric_limits<double>::denorm_min();
+    DOCTEST_REQUIRE(same(-2.0 * IDouble(1.0, 3.0), IDouble(-6.0, -2.0)));
+    DOCTEST_REQUIRE(same(IDouble(-1.0, 3.0) / -4, IDouble(-0.75, 0.25)));
+    DOCTEST_REQUIRE(same(0.0 * IDouble(1.0, inf), IDouble(0.0, 0.0)));
+    DOCTEST_REQUIRE(same(2.0 * IDouble(1.0, mx), IDouble(2.0, inf)));
+    DOCTEST_REQUIRE(same(2.0 * IDouble(mx, mx), IDouble(mx, inf)));
+    DOCTEST_REQUIRE(same(IDouble(mn, 1.0) * 0.5, IDouble(0.0, 0.5)));
+    DOCTEST_REQUIRE(same(IDouble(-mn, -mn) / 2.0, IDouble(-mn, -0.0)));
+    DOCTEST_REQUIRE(same(IDouble(1.0, 2.0) * inf, IDouble(inf, inf)));
+    DOCTEST_REQUIRE((IDouble(1.0, 2.0) / 0.0).possibly_undefined());
+    DOCTEST_REQUIRE((IDouble(1.0, 2.0) * nan).possibly_undefined());
+    DOCTEST_REQUIRE((IDouble(1.0, 2.0, true) * 2.0).possibly_undefined());
+    DOCTEST_REQUIRE((IDouble(1.0, 2.0, true) / 3.0).possibly_undefined());
+    DOCTEST_REQUIRE(same(IDouble(1.0, inf) / 3.0, IDouble(1.0, inf) / IDouble(3.0)));
+    DOCTEST_REQUIRE(same(IDouble(-inf, -3.0) / -3, IDouble(1.0, inf)));
+    // 64-bit integers are not necessarily representable; the product must still enclose the exact result
+    std::int64_t big = (std::int64_t(1) << 60) + 1;
+    IDouble p = IDouble(1.0, 1.0) * big;
+    DOCTEST_REQUIRE(lb(p) < ub(p));
+}
+
+namespace {
+    /// The hull of x * y + z over the endpoints, with a single outward rounding per bound.
+    IDouble fma_endpoint_hull(IDouble x, IDouble y, IDouble z) {
+        mpfr_t a, b, c, r;
+        mpfr_init2(a, 53);
+        mpfr_init2(b, 53);
+        mpfr_init2(c, 53);
+        mpfr_init2(r, 53);
+        double l = std::numeric_limits<double>::infinity(), u = -l;
+        for(double ea : {lb(x), ub(x)}) {
+            for(double eb : {lb(y), ub(y)}) {
+                mpfr_set_d(a, ea, MPFR_RNDN);
+                mpfr_set_d(b, eb, MPFR_RNDN);
+                mpfr_set_d(c, lb(z), MPFR_RNDN);
+                mpfr_fma(r, a, b, c, MPFR_RNDD);
+                l = (std::min)(l, mpfr_get_d(r, MPFR_RNDD));
+                mpfr_set_d(c, ub(z), MPFR_RNDN);
+                mpfr_fma(r, a, b, c, MPFR_RNDU);
+                u = (std::max)(u, mpfr_get_d(r, MPFR_RNDU));
+            }
+        }
+        mpfr_clear(a);
+        mpfr_clear(b);
+        mpfr_clear(c);
+        mpfr_clear(r);
+        return IDouble(l, u);
+    }
+
+    bool subset(IDouble x, IDouble y) noexcept {
+        return lb(y) <= lb(x) && ub(x) <= ub(y);
+    }
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Fused multiply-add against MPFR") {
+    constexpr std::size_t n = 100000;
+    for(std::size_t i = 0; i < n; ++i) {
+        IDouble x = random_interval(), y = random_interval(), z = random_interval();
+        double s = random_double();
+        IDouble e = fma_endpoint_hull(x, y, z);
+        IDouble r = fma(x, y, z), rs = fma(x, s, z);
+        DOCTEST_REQUIRE(subset(e, r));
+        DOCTEST_REQUIRE(subset(r, x * y + z));
+        DOCTEST_REQUIRE(subset(fma_endpoint_hull(x, IDouble(s), z), rs));
+        DOCTEST_REQUIRE(subset(rs, x * s + z));
+#if !IVARP_IA_ROUND_TO_NEAREST && defined(__FMA__)
+        DOCTEST_REQUIRE(same(r, e));
+        DOCTEST_REQUIRE(same(rs, fma_endpoint_hull(x, IDouble(s), z)));
+#endif
+    }
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Horner evaluation and dot products") {
+    double inf = std::numeric_limits<double>::infinity();
+    IDouble x(0.5, 2.0);
+    // 3/16 x^2 + 15/32 + 27/256 / x^2 as used in the rectangle cover lemma
+    IDouble p = horner(x, 3.0 / 16.0, 0.0, 15.0 / 32.0);
+    DOCTEST_REQUIRE(subset(p, (3.0 / 16.0) * square(x) + (15.0 / 32.0)));
+    DOCTEST_REQUIRE(same(horner(IDouble(3.0), 1, -2, IDouble(1.0)), IDouble(4.0)));
+    DOCTEST_REQUIRE(same(horner(x, IDouble(7.0)), IDouble(7.0)));
+    DOCTEST_REQUIRE(same(fma(IDouble(1.0, inf), IDouble(2.0), IDouble(-1.0)), IDouble(1.0, inf)));
+    DOCTEST_REQUIRE(fma(IDouble(1.0, 2.0, true), IDouble(2.0), IDouble(-1.0)).possibly_undefined());
+
+    IDouble xs[12], ys[12];
+    IDouble naive(0.0);
+    for(int i = 0; i < 12; ++i) {
+        xs[i] = random_interval();
+        ys[i] = random_interval();
+        naive += xs[i] * ys[i];
+    }
+    IDouble d = dot(xs, ys);
+    DOCTEST_REQUIRE(subset(d, naive));
+    // the dot product of point intervals encloses the exact value
+    mpfr_t acc, a, b;
+    mpfr_init2(acc, 4500);
+    mpfr_init2(a, 53);
+    mpfr_init2(b, 53);
+    mpfr_set_d(acc, 0.0, MPFR_RNDN);
+    for(int i = 0; i < 12; ++i) {
+        xs[i] = IDouble(lb(xs[i]));
+        ys[i] = IDouble(ub(ys[i]));
+        mpfr_set_d(a, lb(xs[i]), MPFR_RNDN);
+        mpfr_set_d(b, lb(ys[i]), MPFR_RNDN);
+        mpfr_fma(acc, a, b, acc, MPFR_RNDN);
+    }
+    d = dot(xs, ys);
+    DOCTEST_REQUIRE(lb(d) <= mpfr_get_d(acc, MPFR_RNDD));
+    DOCTEST_REQUIRE(ub(d) >= mpfr_get_d(acc, MPFR_RNDU));
+    mpfr_clear(acc);
+    mpfr_clear(a);
+    mpfr_clear(b);
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Sign-classified kernels with zeros, infinities and NaNs") {
+    double inf = std::numeric_limits<double>::infinity();
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    DOCTEST_REQUIRE(same(IDouble(0.0, 0.0) * IDouble(0.0, inf), IDouble(0.0, 0.0)));
+    DOCTEST_REQUIRE(same(IDouble(-1.0, 2.0) * IDouble(0.0, inf), IDouble(-inf, inf)));
+    DOCTEST_REQUIRE(same(IDouble(-inf, -1.0) * IDouble(-3.0, -2.0), IDouble(2.0, inf)));
+    DOCTEST_REQUIRE(same(mul_nonneg(IDouble(0.0, 0.0), IDouble(1.0, inf)), IDouble(0.0, 0.0)));
+    DOCTEST_REQUIRE(same(mul_nonneg(IDouble(-1.0, 2.0), IDouble(3.0, 4.0)), IDouble(-4.0, 8.0)));
+    DOCTEST_REQUIRE(mul_nonneg(IDouble(1.0, 2.0, true), IDouble(3.0, 4.0)).possibly_undefined());
+    DOCTEST_REQUIRE(same(div_pos(IDouble(-1.0, 2.0), IDouble(4.0, 8.0)), IDouble(-0.25, 0.5)));
+    DOCTEST_REQUIRE(same(div_pos(IDouble(-1.0, 2.0), IDouble(-8.0, -4.0)), IDouble(-0.5, 0.25)));
+    DOCTEST_REQUIRE(same(div_pos(IDouble(1.0, 2.0), IDouble(4.0, inf)), IDouble(0.0, 0.5)));
+    DOCTEST_REQUIRE(div_pos(IDouble(1.0, 2.0), IDouble(0.0, 1.0)).possibly_undefined());
+    DOCTEST_REQUIRE(div_pos(IDouble(nan, 2.0), IDouble(1.0, 1.0)).possibly_undefined());
+    DOCTEST_REQUIRE(same(IDouble(-3.0, -1.0) / IDouble(-2.0, -0.5), IDouble(0.5, 6.0)));
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Overflow and underflow of basic operations") {
+    double mx = std::numeric_limits<double>::max();
+    double mn = std::numeric_limits<double>::denorm_min();
+    double inf = std::numeric_limits<double>::infinity();
+    DOCTEST_REQUIRE(same(IDouble(mx) + IDouble(mx), IDouble(mx, inf)));
+    DOCTEST_REQUIRE(same(IDouble(-mx) - IDouble(mx), IDouble(-inf, -mx)));
+    DOCTEST_REQUIRE(same(IDouble(mx) * IDouble(2.0), IDouble(mx, inf)));
+    DOCTEST_REQUIRE(same(IDouble(-mx) * IDouble(2.0), IDouble(-inf, -mx)));
+    DOCTEST_REQUIRE(same(IDouble(mx) / IDouble(0.5), IDouble(mx, inf)));
+    DOCTEST_REQUIRE(same(IDouble(mn) * IDouble(0.5), IDouble(0.0, mn)));
+    DOCTEST_REQUIRE(same(IDouble(-mn) * IDouble(0.5), IDouble(-mn, 0.0)));
+    DOCTEST_REQUIRE(same(IDouble(mn) / IDouble(4.0), IDouble(0.0, mn)));
+    IDouble s = sqrt(IDouble(mn));
+    DOCTEST_REQUIRE(lb(s) * lb(s) <= mn);
+    DOCTEST_REQUIRE(ub(s) > 0.0);
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] Instruction set level and self-test") {
+    const char* failed = isa_self_test();
+    DOCTEST_INFO("failed self-test check: " << (failed ? failed : "none"));
+    DOCTEST_REQUIRE(failed == nullptr);
+    DOCTEST_REQUIRE(static_cast<int>(compiled_isa_level()) <= static_cast<int>(supported_isa_level()));
+
+    for(ISALevel level : {ISALevel::SSE42, ISALevel::AVX2, ISALevel::AVX512}) {
+        ISALevel parsed;
+        DOCTEST_REQUIRE(parse_isa_level(isa_level_name(level), parsed));
+        DOCTEST_REQUIRE(parsed == level);
+    }
+    ISALevel parsed;
+    DOCTEST_REQUIRE(parse_isa_level("sse4.2", parsed));
+    DOCTEST_REQUIRE(parsed == ISALevel::SSE42);
+    DOCTEST_REQUIRE(!parse_isa_level("avx", parsed));
+}
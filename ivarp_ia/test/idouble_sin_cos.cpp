@@ -40,3 +40,43 @@ DOCTEST_TEST_CASE("[ivarp_ia][IDouble] IDouble sine") {
         DOCTEST_REQUIRE(same(sin(p.first), p.second));
     }
 }
+
+// like same(), but also true if both intervals are possibly undefined (and thus contain NaN)
+static bool same_or_undefined(IDouble x, IDouble y) {
+    return possibly_undefined(x) ? possibly_undefined(y) : same(x, y);
+}
+
+DOCTEST_TEST_CASE("[ivarp_ia][IDouble] IDouble sincos matches sin and cos") {
+    std::mt19937_64 rng(45);
+    std::uniform_real_distribution<double> center(-20.0, 20.0);
+    std::uniform_real_distribution<double> width(0.0, 1.0);
+    std::uniform_int_distribution<int> kind(0, 3);
+    std::vector<IDouble> inputs{
+        IDouble{0}, IDouble{1}, IDouble{-1}, IDouble{0, 8}, IDouble{-8, 0}, IDouble{-1.0, 2.0}, IDouble{-2.0, 1.0},
+        IDouble{-1.0, 1.0}, IDouble{5.0e-324}, IDouble{-5.0e-324, 1.0e-300}, IDouble{1.0e-280, 1.0e-260},
+        IDouble{1.57, 1.571}, IDouble{3.1, 3.25}, IDouble{4.5, 4.75}, IDouble{1.0e10, 1.0e10 + 1.0},
+        IDouble{-std::numeric_limits<double>::infinity(), 0.0}, IDouble{0.0, 1.0, true}
+    };
+    for(int i = 0; i < 10000; ++i) {
+        double c = center(rng);
+        switch(kind(rng)) {
+            case 0: inputs.emplace_back(c); break;
+            case 1: inputs.emplace_back(c, std::nextafter(c, 100.0)); break;
+            case 2: inputs.emplace_back(c, c + width(rng)); break;
+            default: inputs.emplace_back(c, c + 8.0 * width(rng)); break;
+        }
+    }
+
+    for(const IDouble& x : inputs) {
+        std::pair<IDouble, IDouble> sc = sincos(x);
+        DOCTEST_REQUIRE(same_or_undefined(sc.first, sin(x)));
+        DOCTEST_REQUIRE(same_or_undefined(sc.second, cos(x)));
+    }
+
+    std::vector<IDouble> s(inputs.size()), c(inputs.size());
+    sincos(inputs.data(), s.data(), c.data(), inputs.size());
+    for(std::size_t i = 0; i < inputs.size(); ++i) {
+        DOCTEST_REQUIRE(same_or_undefined(s[i], sin(inputs[i])));
+        DOCTEST_REQUIRE(same_or_undefined(c[i], cos(inputs[i])));
+    }
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Process-wide overrides used to run ablation experiments on proofs run by
+ * the proof functions: in the prover named proof, the constraints with the
+ * given indices (in the order of addition) are left out, and every prover gives up
+ * (and fails) once it has processed max_nodes nodes or run for max_seconds (0: no limit).
+ */
+struct AblationOptions {
+    std::string proof;
+    std::vector<std::size_t> disabled_constraints;
+    std::uint64_t max_nodes = 0;
+    double max_seconds = 0.0;
+};
+
+inline AblationOptions& default_ablation_options() noexcept {
+    static AblationOptions options;
+    return options;
+}
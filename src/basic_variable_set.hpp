@@ -41,9 +41,27 @@ public:
     BasicVariableSet(const BasicVariableSet&) noexcept = default;
     BasicVariableSet &operator=(const BasicVariableSet&) noexcept = default;
 
-protected:
-    template<typename Callback> void default_split(Callback&& callback, std::uint64_t height) const noexcept {
-        std::size_t idx = static_cast<std::size_t>(height % num_vars);
+    ivarp::IDouble get_variable(std::size_t index) const noexcept {
+        return m_variable_values[index];
+    }
+
+    /**
+     * Set all variables from raw bounds given as lb_0, ub_0, lb_1, ub_1, ...
+     * and run the change handlers, as on construction.
+     */
+    void assign_values(const double* bounds) noexcept {
+        for(std::size_t i = 0; i < num_vars; ++i) {
+            m_variable_values[i] = ivarp::IDouble{bounds[2 * i], bounds[2 * i + 1]};
+        }
+        for(std::size_t i = 0; i < num_vars; ++i) {
+            p_call_handler(i, true, true);
+        }
+    }
+
+    /**
+     * Bisect the variable with the given index and pass both halves to the callback.
+     */
+    template<typename Callback> void split_variable(Callback&& callback, std::size_t idx) const noexcept {
         ivarp::IDouble half1, half2;
         std::tie(half1, half2) = ivarp::split_half(m_variable_values[idx]);
         ConcreteVariableSet vset1(*static_cast<const ConcreteVariableSet*>(this));
@@ -58,6 +76,11 @@ protected:
         callback(vset2);
     }
 
+protected:
+    template<typename Callback> void default_split(Callback&& callback, std::uint64_t height) const noexcept {
+        split_variable(std::forward<Callback>(callback), static_cast<std::size_t>(height % num_vars));
+    }
+
     template<std::size_t Index> ivarp::IDouble get_value() const noexcept {
         return m_variable_values[Index];
     }
@@ -114,6 +137,7 @@ private:
 };
 
 #define DECLARE_NAMED_VARIABLE(name, index) \
+    static constexpr std::size_t name##_index = index; \
     ivarp::IDouble get_##name() const noexcept {   \
         return this->template get_value<index>();\
     }                                       \
@@ -23,8 +23,15 @@
 #include <vector>
 #include <cassert>
 #include <sstream>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <tuple>
+#include <stdexcept>
 #include "basic_variable_set.hpp"
 #include "prover.hpp"
+#include "trace_registry.hpp"
+#include "corpus_replay.hpp"
 #include "rectangle_base_cover.hpp"
 #include "r1_in_center.hpp"
 #include "two_large_disks.hpp"
@@ -68,8 +75,7 @@ private:
 
     void on_alpha_changed(bool lb_changed, bool ub_changed) noexcept {
         tan_alpha_half = ivarp::tan(0.5 * get_alpha());
-        sin_alpha = ivarp::sin(get_alpha());
-        cos_alpha = ivarp::cos(get_alpha());
+        std::tie(sin_alpha, cos_alpha) = ivarp::sincos(get_alpha());
         IDouble max_r1 = 0.5 / sin_alpha;
         weight = ivarp::square(max_r1);
         height = 0.5 / tan_alpha_half;
@@ -204,27 +210,177 @@ struct NotInManualRegion : Constraint<VariableSet> {
     }
 
     ivarp::IBool satisfied(const VariableSet& vars) override {
-        return vars.get_alpha() < 0.7679448708775049592389905228628776967525482177734375 ||
+        return vars.get_alpha() < manual_alpha ||
                vars.get_r1() < 0.48 ||
                vars.get_r2() < 0.48;
     }
+
+    bool guard(typename Constraint<VariableSet>::GuardBox& box) const override {
+        const double inf = std::numeric_limits<double>::infinity();
+        box = Constraint<VariableSet>::unbounded_guard();
+        box[VariableSet::alpha_index] = IDouble{manual_alpha, inf};
+        box[VariableSet::r1_index] = IDouble{0.48, inf};
+        box[VariableSet::r2_index] = IDouble{0.48, inf};
+        return true;
+    }
+
+    static constexpr double manual_alpha = 0.7679448708775049592389905228628776967525482177734375;
 };
 
-bool prove_acute_isoceles_below45() {
-    if(!prove_below45_isoceles_derivative_signs()) {
-        return false;
+/**
+ * TwoLargeDisksConvergent with a guard that relies on the domain of Below45IsocelesVariables:
+ * for 0.3449 ≤ α ≤ π/4 and r_2 ≤ 1/2, the segment that r_1 has to cover has length
+ * ℓ ≥ sqrt((1/(2tan(π/8)) - (1 + cos(0.3449))/2)² + 1/4) > 0.5531;
+ * thus, μ² = r_1²/ℓ² - 1/4 < 0 and the routine fails immediately for r_1 < 0.2765.
+ */
+struct Below45TwoLargeDisksConvergent : TwoLargeDisksConvergent<Below45IsocelesVariables> {
+    bool guard(GuardBox& box) const override {
+        const Below45IsocelesVariables domain;
+        if(domain.get_alpha().lb() < 0.3449 || domain.get_alpha().ub() > 0.7854 || domain.get_r2().ub() > 0.5) {
+            return false;
+        }
+        box = unbounded_guard();
+        box[Below45IsocelesVariables::r1_index] = IDouble{0.2765, std::numeric_limits<double>::infinity()};
+        return true;
     }
-    Prover<Below45IsocelesVariables> prover_below45;
-    Below45IsocelesVariables variables;
-    prover_below45.add_variable_set(variables);
+};
+
+static void setup_below45_constraints(Prover<Below45IsocelesVariables>& prover_below45) {
+    prover_below45.set_name("below45");
     prover_below45.emplace_constraint<Radius123Consistency<Below45IsocelesVariables>>(); // necessary (tested)
     prover_below45.emplace_constraint<RectangleBaseRectangleCoverLemma4<Below45IsocelesVariables>>(); // necessary (tested)
     prover_below45.emplace_constraint<R1R2RectangleBaseCover<Below45IsocelesVariables>>(); // necessary (tested)
     prover_below45.emplace_constraint<R1R2R3RectangleBaseCover<Below45IsocelesVariables>>(); // necessary (tested)
     prover_below45.emplace_constraint<NotInManualRegion<Below45IsocelesVariables>>(); // necessary (tested)
     prover_below45.emplace_constraint<R1InCenterCover<Below45IsocelesVariables>>(); // necessary (tested)
-    prover_below45.emplace_constraint<TwoLargeDisksConvergent<Below45IsocelesVariables>>(); // necessary (tested)
+    prover_below45.emplace_constraint<Below45TwoLargeDisksConvergent>(); // necessary (tested)
     prover_below45.abort_on_satisfiable();
     prover_below45.abort_at_height(100);
-    return prover_below45.prove();
+}
+
+bool prove_acute_isoceles_below45() {
+    if(!prove_below45_isoceles_derivative_signs()) {
+        return false;
+    }
+    return prove_below45_main_case();
+}
+
+/**
+ * Prove the below-45 case with the given number of in-process shards proved
+ * concurrently; the per-shard statistics are merged into one record named below45.
+ */
+static bool prove_below45_main_case_threaded(std::size_t threads) {
+    if(!default_checkpoint_options().file.empty()) {
+        throw std::runtime_error("Checkpointing is not supported with more than one thread");
+    }
+    std::vector<Prover<Below45IsocelesVariables>> provers(threads);
+    std::vector<char> proved(threads, 0);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for(std::size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([&, i] () {
+            ivarp::setup_floating_point_environment();
+            Prover<Below45IsocelesVariables>& prover = provers[i];
+            setup_below45_constraints(prover);
+            prover.add_variable_set(Below45IsocelesVariables{});
+            prover.shard(i, threads, 64 * threads);
+            prover.set_instance(".shard" + std::to_string(i));
+            proved[i] = prover.prove();
+        });
+    }
+    for(std::thread& t : workers) {
+        t.join();
+    }
+    ProofStats merged;
+    for(const auto& prover : provers) {
+        merge_proof_stats(merged, prover.stats());
+    }
+    bool result = std::all_of(proved.begin(), proved.end(), [] (char p) { return p != 0; });
+    add_proof_run_record(ProofRunRecord{"below45", result, merged.nodes, merged.peak_open_boxes,
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+        false, merged.constraints});
+    if(!result) {
+        return false;
+    }
+    std::cout << merged;
+    return true;
+}
+
+/**
+ * Prove the below-45 case using worker processes managed by a coordinator.
+ */
+static bool prove_below45_main_case_distributed(const DistributedOptions& options) {
+    // start with a few boxes per worker; the workers give back more as needed
+    std::size_t workers = options.workers ? options.workers : (std::max)(std::thread::hardware_concurrency(), 1u);
+    std::vector<Below45IsocelesVariables> roots{Below45IsocelesVariables{}};
+    std::vector<WireBox> initial;
+    for(const auto& box : expand_breadth_first(roots, 4 * workers)) {
+        initial.push_back(WireBox{0, box.height, box_bounds(box.domain)});
+    }
+    Coordinator coordinator(options, std::move(initial));
+    return coordinator.run();
+}
+
+bool prove_below45_main_case() {
+    if(default_distributed_options().coordinator()) {
+        return prove_below45_main_case_distributed(default_distributed_options());
+    }
+    std::size_t threads = default_shard_options().threads;
+    if(threads > 1) {
+        return prove_below45_main_case_threaded(threads);
+    }
+    Prover<Below45IsocelesVariables> prover_below45;
+    setup_below45_constraints(prover_below45);
+    prover_below45.add_variable_set(Below45IsocelesVariables{});
+    if(!prover_below45.prove()) {
+        return false;
+    }
+    std::cout << prover_below45.stats();
+    return true;
+}
+
+bool prove_acute_isoceles_below45_shard(const ShardOptions& options) {
+    if(!prove_below45_isoceles_derivative_signs()) {
+        return false;
+    }
+    Prover<Below45IsocelesVariables> prover_below45;
+    setup_below45_constraints(prover_below45);
+    prover_below45.add_variable_set(Below45IsocelesVariables{});
+    prover_below45.shard(options.index, options.count, options.expansion);
+    auto start = std::chrono::steady_clock::now();
+    bool proved = prover_below45.prove();
+    ShardResult result;
+    result.proof_name = "below45";
+    result.shard_index = options.index;
+    result.shard_count = options.count;
+    result.expansion = options.expansion;
+    result.total_boxes = prover_below45.shard_total_boxes();
+    result.proved = proved;
+    result.nodes = prover_below45.stats().nodes;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.boxes = prover_below45.shard_boxes();
+    result.write(options.result_file_for("below45"));
+    std::cout << prover_below45.stats();
+    return proved;
+}
+
+int run_below45_worker(const DistributedOptions& options) {
+    return run_worker<Below45IsocelesVariables, Prover<Below45IsocelesVariables>>(options, &setup_below45_constraints);
+}
+
+std::vector<std::vector<double>> below45_shard_expansion(std::size_t expansion) {
+    std::vector<Below45IsocelesVariables> roots{Below45IsocelesVariables{}};
+    std::vector<std::vector<double>> result;
+    for(const auto& box : expand_breadth_first(roots, expansion)) {
+        result.push_back(box_bounds(box.domain));
+    }
+    return result;
+}
+
+void register_below45_trace_renderers() {
+    register_trace_renderer<Below45IsocelesVariables>("below45");
+}
+
+void register_below45_corpus_replayers() {
+    register_corpus_replayer<Below45IsocelesVariables>("below45", &setup_below45_constraints);
 }
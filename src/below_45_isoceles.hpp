@@ -16,5 +16,29 @@
  */
 
 #pragma once
+#include <vector>
+#include "sharding.hpp"
+#include "distributed.hpp"
 
 extern bool prove_acute_isoceles_below45();
+
+/**
+ * Prove the below-45 case without first proving the derivative signs it relies on;
+ * with --coordinator, using worker processes, and with --threads, using in-process shards.
+ */
+extern bool prove_below45_main_case();
+
+/**
+ * Prove the part of the below-45 case assigned to the given shard and write its result file.
+ */
+extern bool prove_acute_isoceles_below45_shard(const ShardOptions& options);
+
+/**
+ * The bounds of the boxes the below-45 domain is expanded into for sharding.
+ */
+extern std::vector<std::vector<double>> below45_shard_expansion(std::size_t expansion);
+
+/**
+ * Run as worker process for the below-45 case.
+ */
+extern int run_below45_worker(const DistributedOptions& options);
@@ -25,76 +25,15 @@
 #include <sstream>
 #include "basic_variable_set.hpp"
 #include "prover.hpp"
+#include "trace_registry.hpp"
+#include "corpus_replay.hpp"
 #include "below_45_isoceles_derivatives.hpp"
+#include "generated/below_45_isoceles_derivatives_kernels.hpp"
 
 
 using IDouble = ivarp::IDouble;
 using IBool = ivarp::IBool;
 
-IDouble diff_restweight_by_r1(IDouble alpha, IDouble r1, IDouble r2) {
-    using ivarp::cos;
-    using ivarp::sin;
-    using ivarp::square;
-    using ivarp::sqrt;
-    IDouble x0 = 8.0 * square(r1);
-    IDouble x1 = 2.0 * square(r2);
-    IDouble x2 = cos(alpha);
-    IDouble x3 = 2.0 * alpha;
-    IDouble x4 = 2.0 * r2 * sin(x3);
-    IDouble x5 = x1 * cos(x3);
-    IDouble x6 = x0 * x2 - x0 + x1 - x4 - x5 + 1.0;
-    IDouble x7 = sqrt(x6/(-x1 + x4 + x5 - 1.0));
-    return -2.0 * r1 * (x6 + 2.0*x7*(x2 - 1.0)*(x7 - tan(0.5 * alpha))) / x6;
-}
-
-IDouble diff_restweight_by_r2(IDouble alpha, IDouble r2) {
-    using ivarp::sin;
-    using ivarp::cos;
-    using ivarp::square;
-    using ivarp::sqrt;
-    using ivarp::tan;
-    IDouble x0 = 2.0 * square(r2);
-    IDouble x1 = 2.0 * alpha;
-    IDouble x2 = sin(x1);
-    IDouble x3 = 2.0 * r2;
-    IDouble x4 = cos(x1);
-    IDouble x5 = x0*x4 - x0 + x2*x3;
-    IDouble x6 = x5 - 1.0;
-    IDouble x7 = 1.0 / x6;
-    IDouble x8 = cos(alpha);
-    IDouble x9 = x5 - 2.0 * x8 + 1.0;
-    IDouble x10 = sqrt(-x7 * x9);
-    return -x7*(x10*(x10 - tan(0.5 * alpha))*(x8 - 1.0)*(x2 + x3*x4 - x3) + x3*x6*x9)/x9;
-}
-
-IDouble diff_restweight_by_alpha(IDouble alpha) {
-    using ivarp::sin;
-    using ivarp::cos;
-    using ivarp::square;
-    using ivarp::cube;
-    using ivarp::sqrt;
-    using ivarp::tan;
-    IDouble x0 = sin(alpha);
-    IDouble x1 = 2*alpha;
-    IDouble x2 = cos(x1);
-    IDouble x3 = sin(x1);
-    IDouble x4 = 2*x3;
-    IDouble x5 = x2 + x4 - 3;
-    IDouble x6 = 1 / x5;
-    IDouble x7 = cos(alpha);
-    IDouble x8 = -x2 - x4 + 4*x7 - 1;
-    IDouble x9 = square(x0);
-    IDouble x10 = 0.5 * alpha;
-    IDouble x11 = sqrt(x6*x8);
-    IDouble x12 = x11 - tan(x10);
-    IDouble x13 = square(x12) + 2;
-    IDouble x14 = x5 * x8;
-    IDouble x15 = 2 * x14 * x7;
-    IDouble x16 = 3 * alpha;
-    return x6*(x15*(x13*x9 - 1) + x9*(x0*x12*(2*x11*(-9*x0 - 8*x2 + 4*x3 + 6*x7 - sin(x16) + 2*cos(x16)) +
-           x14/square(cos(x10))) - x13*x15)) / (4*cube(x0)*x8);
-}
-
 template<typename VariableSet>
 struct DiffR1Negative : Constraint<VariableSet> {
     std::string name() const override {
@@ -297,39 +236,64 @@ inline std::ostream& operator<<(std::ostream& output, const VariableSetProofRest
     return output << "dΔ/dα: " << diff_restweight_by_alpha(vars.get_alpha());
 }
 
-bool prove_r1_diff_negative(bool trace = false) {
-    Prover<VariableSetProofRestweightPartialR1Negative> prover_r1_diff_negative;
-    VariableSetProofRestweightPartialR1Negative variables;
-    prover_r1_diff_negative.add_variable_set(variables);
+static void setup_r1_diff_negative(Prover<VariableSetProofRestweightPartialR1Negative>& prover_r1_diff_negative) {
+    prover_r1_diff_negative.set_name("below45_r1_diff");
     prover_r1_diff_negative.abort_on_satisfiable(true);
     prover_r1_diff_negative.abort_at_height(100);
-    prover_r1_diff_negative.trace(trace);
     prover_r1_diff_negative.emplace_constraint<DiffR1Negative<VariableSetProofRestweightPartialR1Negative>>();
+}
+
+bool prove_r1_diff_negative() {
+    Prover<VariableSetProofRestweightPartialR1Negative> prover_r1_diff_negative;
+    setup_r1_diff_negative(prover_r1_diff_negative);
+    VariableSetProofRestweightPartialR1Negative variables;
+    prover_r1_diff_negative.add_variable_set(variables);
     return prover_r1_diff_negative.prove();
 }
 
-bool prove_r2_diff_negative(bool trace = false) {
-    Prover<VariableSetProofRestweightPartialR2Negative> prover_r2_diff_negative;
-    VariableSetProofRestweightPartialR2Negative variables;
-    prover_r2_diff_negative.add_variable_set(variables);
+static void setup_r2_diff_negative(Prover<VariableSetProofRestweightPartialR2Negative>& prover_r2_diff_negative) {
+    prover_r2_diff_negative.set_name("below45_r2_diff");
     prover_r2_diff_negative.abort_on_satisfiable(true);
     prover_r2_diff_negative.abort_at_height(100);
-    prover_r2_diff_negative.trace(trace);
     prover_r2_diff_negative.emplace_constraint<DiffR2Negative<VariableSetProofRestweightPartialR2Negative>>();
+}
+
+bool prove_r2_diff_negative() {
+    Prover<VariableSetProofRestweightPartialR2Negative> prover_r2_diff_negative;
+    setup_r2_diff_negative(prover_r2_diff_negative);
+    VariableSetProofRestweightPartialR2Negative variables;
+    prover_r2_diff_negative.add_variable_set(variables);
     return prover_r2_diff_negative.prove();
 }
 
-bool prove_alpha_diff_negative(bool trace = false) {
-    Prover<VariableSetProofRestweightPartialAlphaNegative> prover_alpha_diff_negative;
-    VariableSetProofRestweightPartialAlphaNegative variables;
-    prover_alpha_diff_negative.add_variable_set(variables);
+static void setup_alpha_diff_negative(Prover<VariableSetProofRestweightPartialAlphaNegative>& prover_alpha_diff_negative) {
+    prover_alpha_diff_negative.set_name("below45_alpha_diff");
     prover_alpha_diff_negative.abort_on_satisfiable(true);
     prover_alpha_diff_negative.abort_at_height(100);
-    prover_alpha_diff_negative.trace(trace);
     prover_alpha_diff_negative.emplace_constraint<DiffAlphaNegative<VariableSetProofRestweightPartialAlphaNegative>>();
+}
+
+bool prove_alpha_diff_negative() {
+    Prover<VariableSetProofRestweightPartialAlphaNegative> prover_alpha_diff_negative;
+    setup_alpha_diff_negative(prover_alpha_diff_negative);
+    VariableSetProofRestweightPartialAlphaNegative variables;
+    prover_alpha_diff_negative.add_variable_set(variables);
     return prover_alpha_diff_negative.prove();
 }
 
 bool prove_below45_isoceles_derivative_signs() {
     return prove_r1_diff_negative() && prove_r2_diff_negative() && prove_alpha_diff_negative();
 }
+
+void register_below45_derivative_trace_renderers() {
+    register_trace_renderer<VariableSetProofRestweightPartialR1Negative>("below45_r1_diff");
+    register_trace_renderer<VariableSetProofRestweightPartialR2Negative>("below45_r2_diff");
+    register_trace_renderer<VariableSetProofRestweightPartialAlphaNegative>("below45_alpha_diff");
+}
+
+void register_below45_derivative_corpus_replayers() {
+    register_corpus_replayer<VariableSetProofRestweightPartialR1Negative>("below45_r1_diff", &setup_r1_diff_negative);
+    register_corpus_replayer<VariableSetProofRestweightPartialR2Negative>("below45_r2_diff", &setup_r2_diff_negative);
+    register_corpus_replayer<VariableSetProofRestweightPartialAlphaNegative>("below45_alpha_diff",
+                                                                             &setup_alpha_diff_negative);
+}
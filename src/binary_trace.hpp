@@ -0,0 +1,228 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "record_file.hpp"
+
+/**
+ * Process-wide options for binary tracing; if trace_directory is non-empty,
+ * each named prover writes a binary trace to <trace_directory>/<name>.trace.
+ */
+struct TraceOptions {
+    std::string trace_directory;
+};
+
+inline TraceOptions& default_trace_options() noexcept {
+    static TraceOptions options;
+    return options;
+}
+
+/**
+ * What happened to a node of the search tree.
+ */
+enum class TraceOutcome : std::uint8_t {
+    SPLIT = 0,                   //< the box was subdivided
+    EMPTY_AFTER_PROPAGATION = 1, //< a propagator made the box empty
+    REFUTED = 2,                 //< a constraint is violated everywhere on the box
+    SATISFIABLE = 3,             //< all constraints may hold on the box (possible counterexample)
+    UNDECIDED = 4                //< the box could not be split further
+};
+
+inline const char* trace_outcome_name(TraceOutcome outcome) noexcept {
+    switch(outcome) {
+        case TraceOutcome::SPLIT: return "split";
+        case TraceOutcome::EMPTY_AFTER_PROPAGATION: return "empty after propagation";
+        case TraceOutcome::REFUTED: return "refuted";
+        case TraceOutcome::SATISFIABLE: return "satisfiable";
+        case TraceOutcome::UNDECIDED: return "undecided";
+    }
+    return "unknown";
+}
+
+/**
+ * The part of a trace record that does not depend on the number of variables.
+ * deciding_constraint is the index of the constraint (in the order of addition)
+ * that refuted the box or made it empty, or -1.
+ */
+struct TraceNode {
+    std::uint64_t id;
+    std::uint64_t parent_id;
+    std::uint32_t depth;
+    std::int32_t deciding_constraint;
+    std::uint8_t outcome;
+    std::uint8_t padding[7];
+};
+
+/**
+ * The fixed-size record written for each node; the bounds are stored as
+ * lb_0, ub_0, lb_1, ub_1, ... as they were when the node was taken from the stack.
+ */
+template<std::size_t NumVars> struct TraceRecord {
+    TraceNode node;
+    double bounds[2 * NumVars];
+};
+
+/**
+ * Layout of a trace file: the magic bytes and header (see record_file.hpp),
+ * followed by one TraceRecord per node.
+ */
+constexpr char trace_file_magic[8] = {'C', 'C', 'T', 'R', 'A', 'C', 'E', '1'};
+
+/**
+ * Writes fixed-size records to a file from a background thread.
+ * The prover thread copies each record into a single-producer/single-consumer
+ * ring buffer; the writer thread drains it in large blocks.
+ * If the ring buffer is full, the producer waits: traces are never truncated.
+ */
+class BinaryTraceWriter {
+public:
+    BinaryTraceWriter(const std::string& filename, const TraceFileHeader& header,
+                      std::size_t capacity_records = std::size_t(1) << 16) :
+        m_record_size(header.record_size),
+        m_capacity(round_up_power_of_two(capacity_records)),
+        m_buffer(new unsigned char[m_capacity * m_record_size]),
+        m_file(std::fopen(filename.c_str(), "wb"))
+    {
+        if(!m_file) {
+            throw std::runtime_error("Could not open trace file '" + filename + "'");
+        }
+        write_record_file_header(m_file.get(), trace_file_magic, header);
+        m_writer = std::thread([this] () { drain_loop(); });
+    }
+
+    BinaryTraceWriter(const BinaryTraceWriter&) = delete;
+    BinaryTraceWriter &operator=(const BinaryTraceWriter&) = delete;
+
+    ~BinaryTraceWriter() {
+        m_stop.store(true, std::memory_order_release);
+        m_writer.join();
+    }
+
+    void push(const void* record) noexcept {
+        std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+        while(tail - m_head.load(std::memory_order_acquire) >= m_capacity) {
+            std::this_thread::yield();
+        }
+        std::memcpy(m_buffer.get() + (tail & (m_capacity - 1)) * m_record_size, record, m_record_size);
+        m_tail.store(tail + 1, std::memory_order_release);
+    }
+
+private:
+    static std::size_t round_up_power_of_two(std::size_t n) noexcept {
+        std::size_t result = 1;
+        while(result < n) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    void drain_loop() {
+        for(;;) {
+            // read stop before tail, so no record pushed before stopping is missed
+            bool stop = m_stop.load(std::memory_order_acquire);
+            std::uint64_t head = m_head.load(std::memory_order_relaxed);
+            std::uint64_t tail = m_tail.load(std::memory_order_acquire);
+            if(head == tail) {
+                if(stop) {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                continue;
+            }
+            // write the contiguous part of [head, tail) in one block
+            std::uint64_t begin = head & (m_capacity - 1);
+            std::uint64_t count = (std::min)(tail - head, m_capacity - begin);
+            std::fwrite(m_buffer.get() + begin * m_record_size, m_record_size, count, m_file.get());
+            m_head.store(head + count, std::memory_order_release);
+        }
+        std::fflush(m_file.get());
+    }
+
+    std::size_t m_record_size;
+    std::uint64_t m_capacity;
+    std::unique_ptr<unsigned char[]> m_buffer;
+    TraceFilePtr m_file;
+    alignas(64) std::atomic<std::uint64_t> m_head{0};
+    alignas(64) std::atomic<std::uint64_t> m_tail{0};
+    std::atomic<bool> m_stop{false};
+    std::thread m_writer;
+};
+
+/**
+ * Reads a trace file written by BinaryTraceWriter.
+ */
+class BinaryTraceReader {
+public:
+    explicit BinaryTraceReader(const std::string& filename) :
+        m_file(std::fopen(filename.c_str(), "rb"))
+    {
+        if(!m_file) {
+            throw std::runtime_error("Could not open trace file '" + filename + "'");
+        }
+        m_header = read_record_file_header(m_file.get(), trace_file_magic, filename, "trace");
+        if(m_header.record_size < sizeof(TraceNode) + 2 * sizeof(double) * m_header.num_vars) {
+            throw std::runtime_error("Trace file '" + filename + "' has an invalid record size");
+        }
+        m_record.resize(m_header.record_size);
+    }
+
+    BinaryTraceReader(const BinaryTraceReader&) = delete;
+    BinaryTraceReader &operator=(const BinaryTraceReader&) = delete;
+
+    const TraceFileHeader& header() const noexcept {
+        return m_header;
+    }
+
+    /**
+     * Read the next record; returns false at the end of the file.
+     */
+    bool next() {
+        return std::fread(m_record.data(), 1, m_record.size(), m_file.get()) == m_record.size();
+    }
+
+    TraceNode node() const noexcept {
+        TraceNode result;
+        std::memcpy(&result, m_record.data(), sizeof(TraceNode));
+        return result;
+    }
+
+    /**
+     * The bounds of the current record, in the order lb_0, ub_0, lb_1, ub_1, ...
+     */
+    std::vector<double> bounds() const {
+        std::vector<double> result(2 * m_header.num_vars);
+        std::memcpy(result.data(), m_record.data() + sizeof(TraceNode), result.size() * sizeof(double));
+        return result;
+    }
+
+private:
+    TraceFilePtr m_file;
+    TraceFileHeader m_header;
+    std::vector<unsigned char> m_record;
+};
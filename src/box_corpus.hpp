@@ -0,0 +1,231 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <ivarp_ia/ivarp_ia.hpp>
+#include "binary_trace.hpp"
+#include "record_file.hpp"
+#include "timeline.hpp"
+
+/**
+ * Process-wide options for capturing box corpora; if corpus_directory is non-empty,
+ * each named prover writes every sample_interval-th box passed to each of its
+ * checkers to <corpus_directory>/<name>.corpus.
+ */
+struct CorpusOptions {
+    std::string corpus_directory;
+    std::uint64_t sample_interval = 64;
+};
+
+inline CorpusOptions& default_corpus_options() noexcept {
+    static CorpusOptions options;
+    return options;
+}
+
+/**
+ * The result of a constraint evaluation, as stored in a corpus.
+ */
+enum class CorpusResult : std::uint8_t {
+    VIOLATED = 0,   //< the constraint is violated everywhere on the box
+    SATISFIED = 1,  //< the constraint is satisfied everywhere on the box
+    UNDECIDED = 2,  //< the constraint may or may not be satisfied
+    EMPTIED = 3     //< propagating the constraint made the box empty (only in certificates)
+};
+
+constexpr std::size_t num_corpus_results = 4;
+
+inline CorpusResult corpus_result(ivarp::IBool result) noexcept {
+    if(!possibly(result)) {
+        return CorpusResult::VIOLATED;
+    }
+    return definitely(result) ? CorpusResult::SATISFIED : CorpusResult::UNDECIDED;
+}
+
+inline const char* corpus_result_name(CorpusResult result) noexcept {
+    switch(result) {
+        case CorpusResult::VIOLATED: return "violated";
+        case CorpusResult::SATISFIED: return "satisfied";
+        case CorpusResult::UNDECIDED: return "undecided";
+        case CorpusResult::EMPTIED: return "emptied";
+    }
+    return "unknown";
+}
+
+/**
+ * The part of a corpus record that does not depend on the number of variables;
+ * constraint is the index of the constraint in the order of addition.
+ * It is followed by the bounds lb_0, ub_0, lb_1, ub_1, ... of the box.
+ */
+struct CorpusEntry {
+    std::uint32_t constraint;
+    std::uint32_t depth;
+    std::uint8_t result;
+    std::uint8_t padding[7];
+};
+
+/**
+ * Layout of a corpus file: the magic bytes and header (see record_file.hpp),
+ * followed by one CorpusEntry and the box bounds per record.
+ */
+constexpr char corpus_file_magic[8] = {'C', 'C', 'C', 'O', 'R', 'P', 'S', '1'};
+
+/**
+ * Writes a corpus file; the records are buffered and written by the prover thread,
+ * which is cheap enough because only a small sample of all evaluations is recorded.
+ * With append set, an existing non-empty file is continued instead of truncated
+ * (e.g., when a proof is resumed from a checkpoint); its header must match, and a
+ * partial record left by an interrupted run is dropped.
+ */
+class BoxCorpusWriter {
+public:
+    BoxCorpusWriter(const std::string& filename, const TraceFileHeader& header, bool append = false) :
+        m_record_size(sizeof(CorpusEntry) + 2 * sizeof(double) * header.num_vars)
+    {
+        TraceFileHeader h = header;
+        h.record_size = std::uint32_t(m_record_size);
+        bool continued = append && prepare_append(filename, h);
+        m_file.reset(std::fopen(filename.c_str(), continued ? "ab" : "wb"));
+        if(!m_file) {
+            throw std::runtime_error("Could not open corpus file '" + filename + "'");
+        }
+        if(!continued) {
+            write_record_file_header(m_file.get(), corpus_file_magic, h);
+        }
+        m_buffer.reserve(buffer_records * m_record_size);
+    }
+
+    BoxCorpusWriter(const BoxCorpusWriter&) = delete;
+    BoxCorpusWriter &operator=(const BoxCorpusWriter&) = delete;
+
+    ~BoxCorpusWriter() {
+        flush();
+    }
+
+    /**
+     * Append a record; bounds holds 2 * num_vars values.
+     */
+    void push(const CorpusEntry& entry, const double* bounds) {
+        std::size_t offset = m_buffer.size();
+        m_buffer.resize(offset + m_record_size);
+        std::memcpy(m_buffer.data() + offset, &entry, sizeof(CorpusEntry));
+        std::memcpy(m_buffer.data() + offset + sizeof(CorpusEntry), bounds, m_record_size - sizeof(CorpusEntry));
+        ++m_records;
+        if(m_buffer.size() >= buffer_records * m_record_size) {
+            flush();
+        }
+    }
+
+    std::uint64_t records() const noexcept {
+        return m_records;
+    }
+
+    /**
+     * Write the buffered records to the file.
+     */
+    void flush() {
+        TimelineSpan span("write corpus", "io");
+        std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file.get());
+        std::fflush(m_file.get());
+        m_buffer.clear();
+    }
+
+private:
+    /**
+     * Check the header of an existing file and cut off a trailing partial record;
+     * returns false if there is no file to append to.
+     */
+    bool prepare_append(const std::string& filename, const TraceFileHeader& header) const {
+        long end_of_records;
+        {
+            TraceFilePtr existing(std::fopen(filename.c_str(), "rb"));
+            if(!existing || std::fseek(existing.get(), 0, SEEK_END) != 0 || std::ftell(existing.get()) <= 0) {
+                return false;
+            }
+            long size = std::ftell(existing.get());
+            std::rewind(existing.get());
+            TraceFileHeader found = read_record_file_header(existing.get(), corpus_file_magic, filename, "corpus");
+            if(found.num_vars != header.num_vars || found.record_size != header.record_size ||
+               found.proof_name != header.proof_name || found.constraint_names != header.constraint_names)
+            {
+                throw std::runtime_error("Cannot append to corpus file '" + filename + "': it was written for a different proof");
+            }
+            long header_size = std::ftell(existing.get());
+            end_of_records = size - (size - header_size) % long(m_record_size);
+            if(end_of_records == size) {
+                return true;
+            }
+        }
+        if(::truncate(filename.c_str(), off_t(end_of_records)) != 0) {
+            throw std::runtime_error("Could not truncate the partial record of corpus file '" + filename + "'");
+        }
+        return true;
+    }
+
+    static constexpr std::size_t buffer_records = 4096;
+    std::size_t m_record_size;
+    TraceFilePtr m_file;
+    std::vector<unsigned char> m_buffer;
+    std::uint64_t m_records = 0;
+};
+
+/**
+ * A corpus file read into memory.
+ */
+struct BoxCorpus {
+    TraceFileHeader header;
+    std::vector<CorpusEntry> entries;
+    std::vector<double> bounds; //< 2 * num_vars values per entry
+
+    const double* bounds_of(std::size_t entry) const noexcept {
+        return bounds.data() + 2 * header.num_vars * entry;
+    }
+
+    static BoxCorpus read(const std::string& filename) {
+        TraceFilePtr file(std::fopen(filename.c_str(), "rb"));
+        if(!file) {
+            throw std::runtime_error("Could not open corpus file '" + filename + "'");
+        }
+        BoxCorpus result;
+        result.header = read_record_file_header(file.get(), corpus_file_magic, filename, "corpus");
+        std::size_t num_constraints = result.header.constraint_names.size();
+        std::size_t num_bounds = 2 * result.header.num_vars;
+        if(result.header.record_size != sizeof(CorpusEntry) + num_bounds * sizeof(double)) {
+            throw std::runtime_error("Corpus file '" + filename + "' has an invalid record size");
+        }
+        std::vector<unsigned char> record(result.header.record_size);
+        while(std::fread(record.data(), 1, record.size(), file.get()) == record.size()) {
+            CorpusEntry entry;
+            std::memcpy(&entry, record.data(), sizeof(CorpusEntry));
+            if(entry.constraint >= num_constraints || entry.result >= num_corpus_results) {
+                throw std::runtime_error("Corpus file '" + filename + "' refers to an unknown constraint");
+            }
+            result.entries.push_back(entry);
+            std::size_t offset = result.bounds.size();
+            result.bounds.resize(offset + num_bounds);
+            std::memcpy(result.bounds.data() + offset, record.data() + sizeof(CorpusEntry), num_bounds * sizeof(double));
+        }
+        return result;
+    }
+};
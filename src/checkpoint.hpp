@@ -0,0 +1,157 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "timeline.hpp"
+
+/**
+ * Process-wide checkpoint options: if file is non-empty, the running prover
+ * writes its open boxes to file every interval seconds, and after each proof
+ * the names of the completed proofs are recorded. If resume is set,
+ * the checkpoint in file is read first: completed proofs are skipped
+ * and the proof in progress continues from its saved open boxes.
+ */
+struct CheckpointOptions {
+    std::string file;
+    double interval = 300.0;
+    bool resume = false;
+};
+
+inline CheckpointOptions& default_checkpoint_options() noexcept {
+    static CheckpointOptions options;
+    return options;
+}
+
+/**
+ * The saved state of a sequence of proofs.
+ * Bounds are written as hexadecimal floating-point numbers so they are reproduced exactly.
+ */
+struct Checkpoint {
+    struct Box {
+        std::uint64_t height;
+        bool deferred;               //< waiting for the next iterative deepening pass
+        std::vector<double> bounds;  //< lb_0, ub_0, lb_1, ub_1, ...
+    };
+
+    std::vector<std::string> completed;
+    std::string proof_name;          //< the proof in progress, or empty
+    std::uint64_t nodes = 0;
+    std::uint64_t id_counter = 0;
+    std::uint64_t height_limit = 0;
+    std::vector<Box> boxes;
+
+    bool is_completed(const std::string& name) const {
+        for(const std::string& c : completed) {
+            if(c == name) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void write(const std::string& filename) const {
+        TimelineSpan span("write checkpoint", "io");
+        std::string tmp_name = filename + ".tmp";
+        {
+            std::ofstream output(tmp_name, std::ios::out | std::ios::trunc);
+            for(const std::string& c : completed) {
+                output << "completed " << c << '\n';
+            }
+            if(!proof_name.empty()) {
+                output << "proof " << proof_name << '\n'
+                       << "nodes " << nodes << '\n'
+                       << "ids " << id_counter << '\n'
+                       << "height_limit " << height_limit << '\n';
+                output << std::hexfloat;
+                for(const Box& b : boxes) {
+                    output << "box " << b.height << ' ' << (b.deferred ? 1 : 0);
+                    for(double d : b.bounds) {
+                        output << ' ' << d;
+                    }
+                    output << '\n';
+                }
+            }
+            if(!output) {
+                throw std::runtime_error("Could not write checkpoint file '" + filename + "'");
+            }
+        }
+        if(std::rename(tmp_name.c_str(), filename.c_str()) != 0) {
+            throw std::runtime_error("Could not write checkpoint file '" + filename + "'");
+        }
+    }
+
+    static Checkpoint read(const std::string& filename) {
+        std::ifstream input(filename);
+        if(!input) {
+            throw std::runtime_error("Could not open checkpoint file '" + filename + "'");
+        }
+        Checkpoint result;
+        std::string line;
+        while(std::getline(input, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            fields >> key;
+            if(key == "completed") {
+                std::string name;
+                fields >> name;
+                result.completed.push_back(name);
+            } else if(key == "proof") {
+                fields >> result.proof_name;
+            } else if(key == "nodes") {
+                fields >> result.nodes;
+            } else if(key == "ids") {
+                fields >> result.id_counter;
+            } else if(key == "height_limit") {
+                fields >> result.height_limit;
+            } else if(key == "box") {
+                Box box;
+                int deferred;
+                fields >> box.height >> deferred;
+                box.deferred = (deferred != 0);
+                std::string number;
+                while(fields >> number) {
+                    // operator>> does not parse hexfloats reliably, strtod does
+                    box.bounds.push_back(std::strtod(number.c_str(), nullptr));
+                }
+                result.boxes.push_back(std::move(box));
+            } else if(!key.empty()) {
+                throw std::runtime_error("Unexpected line in checkpoint file '" + filename + "': " + line);
+            }
+            if(fields.fail() && !fields.eof()) {
+                throw std::runtime_error("Malformed line in checkpoint file '" + filename + "': " + line);
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * The checkpoint read on startup when resuming (empty otherwise).
+ */
+inline Checkpoint& resumed_checkpoint() noexcept {
+    static Checkpoint checkpoint;
+    return checkpoint;
+}
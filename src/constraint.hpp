@@ -18,14 +18,33 @@
 #pragma once
 #include <ivarp_ia/ivarp_ia.hpp>
 #include <string>
+#include <array>
+#include <limits>
 #include "propagate_result.hpp"
 
 template<typename VariableSet> struct Constraint {
+    using GuardBox = std::array<ivarp::IDouble, VariableSet::num_vars>;
+
     virtual ~Constraint() = default;
     virtual bool can_propagate() const { return false; }
     virtual bool can_propagate(const VariableSet& vars) const { return this->can_propagate(); }
     virtual std::string name() const { return {}; }
     virtual ivarp::IBool satisfied(const VariableSet& vars) = 0;
     virtual PropagateResult propagate(VariableSet& vars) { return PropagateResult::UNCHANGED; }
+
+    /**
+     * Constraints that can only be violated in part of the domain may declare
+     * a guard box; on any box that does not intersect the guard box,
+     * the constraint must be definitely satisfied, so the prover can skip it.
+     * Returns false if the constraint does not declare a guard.
+     */
+    virtual bool guard(GuardBox& /*box*/) const { return false; }
+
+    static GuardBox unbounded_guard() noexcept {
+        GuardBox result;
+        result.fill(ivarp::IDouble{-std::numeric_limits<double>::infinity(),
+                                   std::numeric_limits<double>::infinity()});
+        return result;
+    }
 };
 
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+/**
+ * Keeps running estimates of the refutation probability and the evaluation cost
+ * of each checker, bucketed by node height, and periodically re-sorts the
+ * checkers of each bucket by their expected cost to refutation.
+ * For independent checkers that are evaluated until the first refutation,
+ * sorting by cost / refutation probability minimizes the expected cost.
+ */
+class AdaptiveConstraintOrder {
+public:
+    static constexpr std::size_t bucket_height = 8;
+    static constexpr std::size_t num_buckets = 16;
+
+    void reset(std::size_t num_checkers, std::uint64_t resort_interval) {
+        m_resort_interval = resort_interval;
+        m_nodes_since_resort = 0;
+        std::vector<std::size_t> identity(num_checkers);
+        std::iota(identity.begin(), identity.end(), std::size_t(0));
+        for(Bucket& b : m_buckets) {
+            b.order = identity;
+            b.estimates.assign(num_checkers, Estimate{});
+        }
+    }
+
+    const std::vector<std::size_t>& order(std::uint64_t height) const noexcept {
+        return m_buckets[bucket_of(height)].order;
+    }
+
+    void record(std::uint64_t height, std::size_t checker, std::uint64_t cost, bool refuted) noexcept {
+        Estimate& e = m_buckets[bucket_of(height)].estimates[checker];
+        e.evaluations += 1.0;
+        e.cost += double(cost);
+        if(refuted) {
+            e.refutations += 1.0;
+        }
+    }
+
+    void node_done() {
+        if(++m_nodes_since_resort >= m_resort_interval) {
+            m_nodes_since_resort = 0;
+            resort();
+        }
+    }
+
+private:
+    struct Estimate {
+        double evaluations = 0.0;
+        double refutations = 0.0;
+        double cost = 0.0;
+
+        // Laplace-smoothed estimate of the expected cost per refutation
+        double expected_cost_to_refutation() const noexcept {
+            double p = (refutations + 1.0) / (evaluations + 2.0);
+            double c = (cost + 1.0) / (evaluations + 1.0);
+            return c / p;
+        }
+    };
+
+    struct Bucket {
+        std::vector<std::size_t> order;
+        std::vector<Estimate> estimates;
+    };
+
+    static std::size_t bucket_of(std::uint64_t height) noexcept {
+        return static_cast<std::size_t>((std::min)(height / bucket_height, std::uint64_t(num_buckets - 1)));
+    }
+
+    void resort() {
+        for(Bucket& b : m_buckets) {
+            std::vector<double> keys(b.estimates.size());
+            for(std::size_t i = 0; i < keys.size(); ++i) {
+                keys[i] = b.estimates[i].expected_cost_to_refutation();
+            }
+            std::stable_sort(b.order.begin(), b.order.end(),
+                             [&] (std::size_t i1, std::size_t i2) { return keys[i1] < keys[i2]; });
+            // decay old observations so the order can follow the search into other regions
+            for(Estimate& e : b.estimates) {
+                e.evaluations *= 0.5;
+                e.refutations *= 0.5;
+                e.cost *= 0.5;
+            }
+        }
+    }
+
+    Bucket m_buckets[num_buckets];
+    std::uint64_t m_resort_interval = 4096;
+    std::uint64_t m_nodes_since_resort = 0;
+};
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "corpus_replay.hpp"
+
+static void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--constraint NAME_OR_INDEX] [--min-time SECONDS] CORPUS_FILE" << std::endl;
+}
+
+static bool is_index(const std::string& s) {
+    return !s.empty() && s.find_first_not_of("0123456789") == std::string::npos;
+}
+
+/**
+ * Replay the boxes of a corpus written by a proof run with --corpus-dir
+ * against the constraints of that proof, and report the time per call
+ * and the distribution of outcomes.
+ */
+int main(int argc, char** argv) {
+    std::string constraint;
+    std::string filename;
+    double min_time = 1.0;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--constraint") == 0 && i + 1 < argc) {
+            constraint = argv[++i];
+        } else if(std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            min_time = std::atof(argv[++i]);
+        } else if(filename.empty() && argv[i][0] != '-') {
+            filename = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if(filename.empty()) {
+        usage(argv[0]);
+        return 2;
+    }
+    ivarp::setup_floating_point_environment();
+    register_all_corpus_replayers();
+    try {
+        BoxCorpus corpus = BoxCorpus::read(filename);
+        auto replayer = corpus_replayers().find(corpus.header.proof_name);
+        if(replayer == corpus_replayers().end()) {
+            std::cerr << "Unknown proof '" << corpus.header.proof_name << "' in corpus file" << std::endl;
+            return 1;
+        }
+        const std::vector<std::string>& names = corpus.header.constraint_names;
+        auto select = [&] (std::size_t index) {
+            if(constraint.empty()) {
+                return true;
+            }
+            if(is_index(constraint)) {
+                return index == std::strtoull(constraint.c_str(), nullptr, 10);
+            }
+            return index < names.size() && names[index] == constraint;
+        };
+        std::vector<ReplayResult> results = replayer->second(corpus, select, min_time);
+        if(results.empty()) {
+            std::cerr << "No constraint matches '" << constraint << "'" << std::endl;
+            return 1;
+        }
+        std::cout << "Proof " << corpus.header.proof_name << ", " << corpus.entries.size() << " boxes\n";
+        bool consistent = true;
+        for(const ReplayResult& r : results) {
+            std::cout << '[' << r.constraint << "] " << r.name << ": " << r.boxes << " boxes";
+            if(r.boxes == 0) {
+                std::cout << '\n';
+                continue;
+            }
+            if(r.calls == 0) {
+                std::cout << '\n';
+            } else {
+                std::cout << ", " << std::fixed << std::setprecision(1) << r.ns_per_call << " ns/call ("
+                          << r.calls << " calls)" << std::defaultfloat << '\n';
+            }
+            for(std::size_t k = 0; k < num_corpus_results; ++k) {
+                if(CorpusResult(k) == CorpusResult::EMPTIED && r.recorded[k] == 0) {
+                    continue;
+                }
+                std::cout << "    " << std::left << std::setw(10) << corpus_result_name(CorpusResult(k)) << std::right
+                          << std::setw(10) << r.replayed[k] << " (recorded: " << r.recorded[k] << ")\n";
+            }
+            if(r.mismatches) {
+                std::cout << "    " << r.mismatches << " boxes have a different outcome than recorded\n";
+                consistent = false;
+            }
+        }
+        std::cout << std::flush;
+        return consistent ? 0 : 1;
+    } catch(const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
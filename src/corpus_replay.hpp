@@ -0,0 +1,154 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "box_corpus.hpp"
+#include "prover.hpp"
+
+/**
+ * The result of replaying the boxes recorded for one constraint.
+ */
+struct ReplayResult {
+    std::size_t constraint;
+    std::string name;
+    std::size_t boxes = 0;
+    std::uint64_t calls = 0;
+    double ns_per_call = 0.0;
+    std::uint64_t recorded[num_corpus_results] = {}; //< outcomes in the corpus, indexed by CorpusResult
+    std::uint64_t replayed[num_corpus_results] = {}; //< outcomes of the replay, indexed by CorpusResult
+    std::uint64_t mismatches = 0;          //< boxes on which the replay outcome differs from the recorded one
+};
+
+/**
+ * Propagate a single constraint on a copy of the box until nothing changes;
+ * the result is EMPTIED if the box becomes empty, and UNDECIDED otherwise.
+ */
+template<typename VariableSet>
+    CorpusResult propagation_result(Constraint<VariableSet>& constraint, VariableSet vars)
+{
+    PropagateResult r;
+    do {
+        r = constraint.propagate(vars);
+        if((r & PropagateResult::EMPTY) != PropagateResult::UNCHANGED) {
+            return CorpusResult::EMPTIED;
+        }
+    } while(r == PropagateResult::CHANGED);
+    return CorpusResult::UNDECIDED;
+}
+
+/**
+ * Replays the boxes of a corpus for the constraints for which select returns true,
+ * calling each of them in a loop for at least min_seconds.
+ */
+using CorpusReplayer = std::function<std::vector<ReplayResult>(const BoxCorpus& corpus,
+                                                               const std::function<bool(std::size_t)>& select,
+                                                               double min_seconds)>;
+
+inline std::map<std::string, CorpusReplayer>& corpus_replayers() {
+    static std::map<std::string, CorpusReplayer> replayers;
+    return replayers;
+}
+
+/**
+ * Register the proof with the given name for corpus replay;
+ * setup must add the constraints of the proof to the prover in the same order as the proof does.
+ */
+template<typename VariableSet, typename SetupFn> void register_corpus_replayer(const std::string& proof_name, SetupFn setup) {
+    corpus_replayers()[proof_name] = [setup] (const BoxCorpus& corpus, const std::function<bool(std::size_t)>& select,
+                                              double min_seconds)
+    {
+        Prover<VariableSet> prover;
+        setup(prover);
+        const auto& constraints = prover.constraints();
+        std::vector<ReplayResult> results;
+        for(std::size_t c = 0; c < constraints.size(); ++c) {
+            if(!select(c)) {
+                continue;
+            }
+            ReplayResult result;
+            result.constraint = c;
+            result.name = constraints[c]->name();
+            std::vector<VariableSet> boxes;
+            std::vector<CorpusResult> expected;
+            for(std::size_t e = 0; e < corpus.entries.size(); ++e) {
+                if(corpus.entries[e].constraint == c) {
+                    VariableSet vars;
+                    vars.assign_values(corpus.bounds_of(e));
+                    boxes.push_back(vars);
+                    expected.push_back(CorpusResult(corpus.entries[e].result));
+                    ++result.recorded[corpus.entries[e].result];
+                }
+            }
+            result.boxes = boxes.size();
+            if(boxes.empty()) {
+                results.push_back(result);
+                continue;
+            }
+            std::vector<VariableSet> timed;
+            for(std::size_t b = 0; b < boxes.size(); ++b) {
+                CorpusResult r;
+                if(expected[b] == CorpusResult::EMPTIED) {
+                    r = propagation_result(*constraints[c], boxes[b]);
+                } else {
+                    r = corpus_result(constraints[c]->satisfied(boxes[b]));
+                    timed.push_back(boxes[b]);
+                }
+                ++result.replayed[std::size_t(r)];
+                if(r != expected[b]) {
+                    ++result.mismatches;
+                }
+            }
+            boxes.swap(timed);
+            if(boxes.empty()) {
+                results.push_back(result);
+                continue;
+            }
+            // time whole passes over the boxes, so the clock is not read per call;
+            // the results are accumulated so the calls cannot be dropped even if they are devirtualized
+            double seconds = 0.0;
+            std::uint64_t calls = 0;
+            std::uint64_t possible = 0;
+            while(seconds < min_seconds) {
+                auto begin = std::chrono::steady_clock::now();
+                for(const VariableSet& vars : boxes) {
+                    possible += possibly(constraints[c]->satisfied(vars));
+                }
+                seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+                calls += boxes.size();
+            }
+            volatile std::uint64_t sink = possible;
+            (void)sink;
+            result.calls = calls;
+            result.ns_per_call = 1.0e9 * seconds / double(calls);
+            results.push_back(result);
+        }
+        return results;
+    };
+}
+
+/**
+ * Register all proofs for corpus replay; defined in corpus_replay.cpp.
+ */
+extern void register_all_corpus_replayers();
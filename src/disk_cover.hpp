@@ -0,0 +1,325 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "geometry.hpp"
+
+/**
+ * A disk of radius r such that p and q lie on its boundary and its center
+ * lies to the right of p -> q (or on p -> q if |pq| = 2r); convenient for placing disks
+ * with a chord on an edge of the region to cover. The center is undefined if r < |pq|/2.
+ */
+inline Circle disk_through(Point p, Point q, ivarp::IDouble r) noexcept {
+    CircleResult c = circle_right_of(p, q, r);
+    if(!possibly(c.exists)) {
+        return Circle{Point{ivarp::IDouble::undefined_value(), ivarp::IDouble::undefined_value()}, r};
+    }
+    if(!definitely(c.exists)) {
+        // the center computed for values with r < |pq|/2 is meaningless
+        c.cx = ivarp::IDouble(c.cx.lb(), c.cx.ub(), true);
+        c.cy = ivarp::IDouble(c.cy.lb(), c.cy.ub(), true);
+    }
+    return Circle{Point{c.cx, c.cy}, r};
+}
+
+struct DiskCoverOptions {
+    unsigned max_depth = 12;            //< maximal depth of the quadtree
+    std::size_t max_cells = 1u << 16;   //< maximal number of cells examined per problem
+};
+
+/**
+ * A coverage problem: does the union of the disks cover the convex polygon
+ * (vertices in counterclockwise or clockwise order) for all values in the intervals?
+ */
+struct DiskCoverProblem {
+    const Point* polygon;
+    std::size_t num_vertices;
+    const Circle* disks;
+    std::size_t num_disks;
+};
+
+struct DiskCoverStats {
+    std::size_t cells = 0;      //< number of quadtree cells examined
+    unsigned max_depth = 0;     //< depth of the deepest cell examined
+    bool edge_gap = false;      //< non-coverage was detected on an edge, before the quadtree
+    bool rejected = false;      //< the problem is not supported; the result is indeterminate
+};
+
+/**
+ * Decide coverage of a convex polygon by disks with interval centers and radii.
+ * The result is definitely true if every cell of an adaptive quadtree over the polygon's
+ * bounding box is outside the polygon or inside one of the disks, definitely false if there is
+ * a point of the polygon outside all disks for all values of the intervals, and indeterminate
+ * otherwise. The search stops at the first cell that proves non-coverage or that cannot
+ * be decided within the depth limit. At most 64 disks are supported per problem;
+ * problems with more disks, or with a polygon that is not convex for all values of
+ * the intervals, are rejected with an indeterminate result.
+ * An engine keeps its work stack between calls; use one engine per thread.
+ */
+class DiskCoverEngine {
+public:
+    explicit DiskCoverEngine(DiskCoverOptions options = DiskCoverOptions{}) :
+        m_options(options)
+    {}
+
+    ivarp::IBool covers(const Point* polygon, std::size_t num_vertices, const Circle* disks, std::size_t num_disks) {
+        m_stats = DiskCoverStats{};
+        if(num_vertices < 3 || num_disks > 64 || !set_polygon(polygon, num_vertices) || !set_disks(disks, num_disks)) {
+            m_stats.rejected = true;
+            return {false, true};
+        }
+        if(edge_gap()) {
+            m_stats.edge_gap = true;
+            return {false, false};
+        }
+        return cover_by_quadtree();
+    }
+
+    ivarp::IBool covers(const DiskCoverProblem& problem) {
+        return covers(problem.polygon, problem.num_vertices, problem.disks, problem.num_disks);
+    }
+
+    /**
+     * Decide a batch of problems, e.g., all placements of a strategy for a box;
+     * results[i] is the result for problems[i].
+     */
+    void covers(const DiskCoverProblem* problems, ivarp::IBool* results, std::size_t count) {
+        for(std::size_t i = 0; i < count; ++i) {
+            results[i] = covers(problems[i]);
+        }
+    }
+
+    /// Statistics of the last problem decided.
+    const DiskCoverStats& last_stats() const noexcept {
+        return m_stats;
+    }
+
+private:
+    struct Cell {
+        double x0, x1, y0, y1;
+        std::uint64_t active;   //< the disks that may intersect the cell
+        unsigned depth;
+    };
+
+    struct Edge {
+        Point p, d;             //< the edge is p + t * d for t in [0, 1]
+    };
+
+    enum class Side { OUTSIDE, INSIDE, BOUNDARY };
+
+    bool set_polygon(const Point* polygon, std::size_t n) {
+        using ivarp::IDouble;
+        m_edges.clear();
+        IDouble area2(0.0);
+        m_bbox_x0 = m_bbox_y0 = std::numeric_limits<double>::infinity();
+        m_bbox_x1 = m_bbox_y1 = -std::numeric_limits<double>::infinity();
+        for(std::size_t i = 0; i < n; ++i) {
+            const Point& p = polygon[i];
+            const Point& q = polygon[(i + 1) % n];
+            if(possibly_undefined(p.x) || possibly_undefined(p.y)) {
+                return false;
+            }
+            m_edges.push_back(Edge{p, Point{q.x - p.x, q.y - p.y}});
+            area2 += p.x * q.y - q.x * p.y;
+            m_bbox_x0 = (std::min)(m_bbox_x0, p.x.lb());
+            m_bbox_x1 = (std::max)(m_bbox_x1, p.x.ub());
+            m_bbox_y0 = (std::min)(m_bbox_y0, p.y.lb());
+            m_bbox_y1 = (std::max)(m_bbox_y1, p.y.ub());
+        }
+        if(area2.lb() > 0.0) {
+            m_orientation = 1.0;
+        } else if(area2.ub() < 0.0) {
+            m_orientation = -1.0;
+        } else {
+            return false;
+        }
+        // the half-plane test in classify is only sound for convex polygons; consistent turns
+        // are not enough (a pentagram has them), so every vertex must lie on the inner side of every edge
+        for(std::size_t i = 0; i < n; ++i) {
+            const Edge& e = m_edges[i];
+            for(std::size_t j = 0; j < n; ++j) {
+                if(j == i || j == (i + 1) % n) {
+                    continue;
+                }
+                const Point& v = polygon[j];
+                if((m_orientation * (e.d.x * (v.y - e.p.y) - e.d.y * (v.x - e.p.x))).lb() < 0.0) {
+                    return false;
+                }
+            }
+        }
+        return ivarp::is_finite(IDouble(m_bbox_x0, m_bbox_x1)) && ivarp::is_finite(IDouble(m_bbox_y0, m_bbox_y1));
+    }
+
+    bool set_disks(const Circle* disks, std::size_t n) {
+        m_disks.assign(disks, disks + n);
+        m_radius_sq.clear();
+        m_undefined_disks = false;
+        for(const Circle& c : m_disks) {
+            m_radius_sq.push_back(ivarp::square(c.radius));
+            if(possibly_undefined(c.center.x) || possibly_undefined(c.center.y) || possibly_undefined(c.radius)) {
+                // such a disk never proves coverage, but may cover any point
+                m_undefined_disks = true;
+            }
+        }
+        return true;
+    }
+
+    bool disk_defined(std::size_t i) const noexcept {
+        const Circle& c = m_disks[i];
+        return !possibly_undefined(c.center.x) && !possibly_undefined(c.center.y) && !possibly_undefined(c.radius);
+    }
+
+    /// Classify the points (x, y) w.r.t. the polygon, for all values of the intervals.
+    Side classify(ivarp::IDouble x, ivarp::IDouble y) const noexcept {
+        bool inside = true;
+        for(const Edge& e : m_edges) {
+            ivarp::IDouble s = m_orientation * (e.d.x * (y - e.p.y) - e.d.y * (x - e.p.x));
+            if(s.ub() < 0.0) {
+                return Side::OUTSIDE;
+            }
+            inside &= (s.lb() >= 0.0);
+        }
+        return inside ? Side::INSIDE : Side::BOUNDARY;
+    }
+
+    /**
+     * Look for a gap on an edge: a parameter t in [0, 1] such that the point at t
+     * is outside every disk for all values of the intervals.
+     */
+    bool edge_gap() {
+        using ivarp::IDouble;
+        if(m_undefined_disks) {
+            return false;
+        }
+        for(const Edge& e : m_edges) {
+            IDouble dsq = ivarp::square(e.d.x) + ivarp::square(e.d.y);
+            if(!(dsq.lb() > 0.0)) {
+                continue;
+            }
+            m_chords.clear();
+            for(const Circle& c : m_disks) {
+                IntersectionResult r = line_circle_intersection(e.p, e.d, c);
+                if(!possibly(r.exists)) {
+                    continue;
+                }
+                // the parameters of the chord's end points on p + t * d
+                IDouble t1 = ((r.first_on_line.x - e.p.x) * e.d.x + (r.first_on_line.y - e.p.y) * e.d.y) / dsq;
+                IDouble t2 = ((r.second_on_line.x - e.p.x) * e.d.x + (r.second_on_line.y - e.p.y) * e.d.y) / dsq;
+                if(possibly_undefined(t1) || possibly_undefined(t2)) {
+                    return false;
+                }
+                m_chords.emplace_back(t1.lb(), t2.ub());
+            }
+            std::sort(m_chords.begin(), m_chords.end());
+            double covered_to = 0.0;
+            for(const auto& chord : m_chords) {
+                if(chord.first > covered_to) {
+                    break;
+                }
+                covered_to = (std::max)(covered_to, chord.second);
+            }
+            if(covered_to < 1.0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Whether the point (x, y) is outside every disk in active for all values of the intervals.
+    bool uncovered_point(double x, double y, std::uint64_t active) const noexcept {
+        Point pt{ivarp::IDouble(x), ivarp::IDouble(y)};
+        for(std::uint64_t m = active; m != 0; m &= m - 1) {
+            std::size_t i = static_cast<std::size_t>(__builtin_ctzll(m));
+            if(!(squared_distance(pt, m_disks[i].center).lb() > m_radius_sq[i].ub())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    ivarp::IBool cover_by_quadtree() {
+        using ivarp::IDouble;
+        std::uint64_t all = (m_disks.size() == 64) ? ~std::uint64_t(0) : ((std::uint64_t(1) << m_disks.size()) - 1);
+        m_stack.clear();
+        m_stack.push_back(Cell{m_bbox_x0, m_bbox_x1, m_bbox_y0, m_bbox_y1, all, 0});
+        while(!m_stack.empty()) {
+            Cell cell = m_stack.back();
+            m_stack.pop_back();
+            ++m_stats.cells;
+            m_stats.max_depth = (std::max)(m_stats.max_depth, cell.depth);
+
+            IDouble x(cell.x0, cell.x1), y(cell.y0, cell.y1);
+            Side side = classify(x, y);
+            if(side == Side::OUTSIDE) {
+                continue;
+            }
+
+            // drop the disks that cannot intersect the cell; stop if one contains it
+            Point box{x, y};
+            std::uint64_t active = 0;
+            bool contained = false;
+            for(std::uint64_t m = cell.active; m != 0; m &= m - 1) {
+                std::size_t i = static_cast<std::size_t>(__builtin_ctzll(m));
+                IDouble dsq = squared_distance(box, m_disks[i].center);
+                if(dsq.ub() <= m_radius_sq[i].lb() && disk_defined(i)) {
+                    contained = true;
+                    break;
+                }
+                if(!(dsq.lb() > m_radius_sq[i].ub())) {
+                    active |= std::uint64_t(1) << i;
+                }
+            }
+            if(contained) {
+                continue;
+            }
+
+            double cx = 0.5 * (cell.x0 + cell.x1), cy = 0.5 * (cell.y0 + cell.y1);
+            if(!m_undefined_disks && classify(IDouble(cx), IDouble(cy)) == Side::INSIDE && uncovered_point(cx, cy, active)) {
+                return {false, false};
+            }
+            if(cell.depth >= m_options.max_depth || m_stats.cells >= m_options.max_cells ||
+               !(cell.x0 < cx && cx < cell.x1 && cell.y0 < cy && cy < cell.y1))
+            {
+                return {false, true};
+            }
+            unsigned d = cell.depth + 1;
+            m_stack.push_back(Cell{cell.x0, cx, cell.y0, cy, active, d});
+            m_stack.push_back(Cell{cx, cell.x1, cell.y0, cy, active, d});
+            m_stack.push_back(Cell{cell.x0, cx, cy, cell.y1, active, d});
+            m_stack.push_back(Cell{cx, cell.x1, cy, cell.y1, active, d});
+        }
+        return {true, true};
+    }
+
+    DiskCoverOptions m_options;
+    DiskCoverStats m_stats;
+    std::vector<Edge> m_edges;
+    std::vector<Circle> m_disks;
+    std::vector<ivarp::IDouble> m_radius_sq;
+    std::vector<std::pair<double, double>> m_chords;
+    std::vector<Cell> m_stack;
+    double m_orientation = 1.0;
+    double m_bbox_x0 = 0.0, m_bbox_x1 = 0.0, m_bbox_y0 = 0.0, m_bbox_y1 = 0.0;
+    bool m_undefined_disks = false;
+};
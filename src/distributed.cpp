@@ -0,0 +1,355 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <chrono>
+#include <csignal>
+#include <iomanip>
+#include <thread>
+#include <algorithm>
+#include <sstream>
+#include <poll.h>
+#include <sys/wait.h>
+#include "distributed.hpp"
+#include "box_corpus.hpp"
+#include "hot_subtrees.hpp"
+#include "perf_counters.hpp"
+#include "prover_options.hpp"
+#include "timeline.hpp"
+
+static double now_seconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Coordinator::Coordinator(DistributedOptions options, std::vector<WireBox> initial_boxes) :
+    m_options(std::move(options))
+{
+    if(m_options.workers == 0) {
+        m_options.workers = (std::max)(std::thread::hardware_concurrency(), 1u);
+    }
+    for(WireBox& b : initial_boxes) {
+        add_item(std::move(b));
+    }
+}
+
+Coordinator::~Coordinator() {
+    for(Worker& w : m_workers) {
+        ::close(w.fd);
+    }
+    if(m_listen_fd >= 0) {
+        ::close(m_listen_fd);
+        ::unlink(m_options.socket_path.c_str());
+    }
+    for(pid_t child : m_children) {
+        ::kill(child, SIGTERM);
+        ::waitpid(child, nullptr, 0);
+    }
+}
+
+std::uint64_t Coordinator::add_item(WireBox box) {
+    std::uint64_t id = m_items.size();
+    box.id = id;
+    m_items.push_back(Item{std::move(box), Item::PENDING, 0});
+    m_pending.push_back(id);
+    return id;
+}
+
+void Coordinator::listen_socket() {
+    m_listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(m_listen_fd < 0) {
+        throw std::runtime_error(std::string("Could not create socket: ") + std::strerror(errno));
+    }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(m_options.socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path '" + m_options.socket_path + "' is too long");
+    }
+    std::strncpy(address.sun_path, m_options.socket_path.c_str(), sizeof(address.sun_path) - 1);
+    ::unlink(m_options.socket_path.c_str());
+    if(::bind(m_listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+       ::listen(m_listen_fd, 64) != 0)
+    {
+        throw std::runtime_error("Could not listen on '" + m_options.socket_path + "': " + std::strerror(errno));
+    }
+}
+
+static std::string format_double(double value) {
+    std::ostringstream output;
+    output << std::setprecision(17) << value;
+    return output.str();
+}
+
+/**
+ * The command-line options that make a worker prove its boxes with the same settings as this process.
+ */
+static std::vector<std::string> forwarded_worker_arguments() {
+    std::vector<std::string> args;
+    const ProverOptions& prover = default_prover_options();
+    if(prover.max_height != 0) {
+        args.insert(args.end(), {"--max-depth", std::to_string(prover.max_height)});
+    }
+    if(prover.min_width != 0.0) {
+        args.insert(args.end(), {"--min-width", format_double(prover.min_width)});
+    }
+    if(prover.split_policy != SplitPolicy::DEFAULT) {
+        args.insert(args.end(), {"--split", prover.split_policy == SplitPolicy::WIDEST ? "widest" : "round-robin"});
+    }
+    if(prover.adaptive_order) {
+        args.emplace_back("--adaptive-order");
+    }
+    if(!prover.certificate_directory.empty()) {
+        args.insert(args.end(), {"--certificate", prover.certificate_directory});
+    }
+    if(default_perf_counter_options().enabled) {
+        args.emplace_back("--perf-counters");
+    }
+    const HotSubtreeOptions& hot = default_hot_subtree_options();
+    if(hot.depth != 0) {
+        args.insert(args.end(), {"--hot-subtrees", std::to_string(hot.depth),
+                                 "--hot-subtrees-top", std::to_string(hot.top_k)});
+    }
+    const CorpusOptions& corpus = default_corpus_options();
+    if(!corpus.corpus_directory.empty()) {
+        args.insert(args.end(), {"--corpus-dir", corpus.corpus_directory,
+                                 "--corpus-sample", std::to_string(corpus.sample_interval)});
+    }
+    // workers write their own timelines next to that of the coordinator
+    const TimelineOptions& timeline = default_timeline_options();
+    if(!timeline.file.empty()) {
+        args.insert(args.end(), {"--timeline", timeline.file,
+                                 "--timeline-sample", std::to_string(timeline.node_sample_interval),
+                                 "--timeline-threshold", format_double(timeline.constraint_threshold_us)});
+    }
+    return args;
+}
+
+void Coordinator::spawn_worker() {
+    std::vector<std::string> arguments{"triangle_cover_by_disks", "--quiet", "--worker", m_options.socket_path,
+                                       "--offload-interval", format_double(m_options.offload_interval)};
+    std::vector<std::string> forwarded = forwarded_worker_arguments();
+    arguments.insert(arguments.end(), forwarded.begin(), forwarded.end());
+    std::vector<const char*> args;
+    for(const std::string& a : arguments) {
+        args.push_back(a.c_str());
+    }
+    args.push_back(nullptr);
+    pid_t pid = ::fork();
+    if(pid < 0) {
+        throw std::runtime_error(std::string("Could not fork worker: ") + std::strerror(errno));
+    }
+    if(pid == 0) {
+        ::close(m_listen_fd);
+        ::execv("/proc/self/exe", const_cast<char* const*>(args.data()));
+        std::_Exit(127);
+    }
+    m_children.push_back(pid);
+    ++m_spawned;
+}
+
+void Coordinator::accept_worker() {
+    int fd = ::accept(m_listen_fd, nullptr, nullptr);
+    if(fd >= 0) {
+        m_workers.push_back(Worker{fd, MessageReader{}, 0, false});
+    }
+}
+
+void Coordinator::worker_lost(Worker& worker) {
+    if(worker.item != 0) {
+        Item& item = m_items[worker.item - 1];
+        if(item.state == Item::ASSIGNED) {
+            if(++item.reissues > m_options.max_reissues) {
+                std::cerr << "[coordinator] Box " << item.box.id << " lost its worker too often, giving up" << std::endl;
+                m_failed = true;
+            } else {
+                std::cerr << "[coordinator] Worker lost, re-issuing box " << item.box.id << std::endl;
+                item.state = Item::PENDING;
+                m_pending.push_back(item.box.id);
+            }
+        }
+    }
+    ::close(worker.fd);
+    worker.fd = -1;
+}
+
+bool Coordinator::handle_input(Worker& worker) {
+    unsigned char data[65536];
+    ssize_t r = ::recv(worker.fd, data, sizeof(data), 0);
+    if(r < 0 && errno == EINTR) {
+        return true;
+    }
+    if(r <= 0) {
+        return false;
+    }
+    worker.reader.append(data, std::size_t(r));
+    MessageType type;
+    std::vector<unsigned char> payload;
+    try {
+        while(worker.reader.next(type, payload)) {
+            if(!handle_message(worker, type, payload)) {
+                return false;
+            }
+        }
+    } catch(const std::runtime_error& e) {
+        std::cerr << "[coordinator] Bad message from worker: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Coordinator::handle_message(Worker& worker, MessageType type, const std::vector<unsigned char>& payload) {
+    MessageParser parser(payload);
+    switch(type) {
+        case MessageType::REQUEST_WORK:
+            worker.waiting = true;
+            return true;
+
+        case MessageType::OFFLOAD: {
+            m_nodes += parser.get_u64();
+            std::uint64_t count = parser.get_u64();
+            for(std::uint64_t i = 0; i < count; ++i) {
+                add_item(parser.get_box());
+            }
+            return true;
+        }
+
+        case MessageType::RESULT: {
+            std::uint64_t id = parser.get_u64();
+            bool proved = parser.get_u64() != 0;
+            m_nodes += parser.get_u64();
+            if(worker.item != id + 1) {
+                return false;
+            }
+            worker.item = 0;
+            Item& item = m_items[id];
+            item.state = Item::DONE;
+            ++m_done;
+            if(!proved) {
+                std::cerr << "[coordinator] Box " << id << " could not be proved" << std::endl;
+                m_failed = true;
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+void Coordinator::dispatch() {
+    for(Worker& w : m_workers) {
+        if(m_pending.empty()) {
+            break;
+        }
+        if(w.fd < 0 || !w.waiting) {
+            continue;
+        }
+        // hand out the most recently added box first; these come from the deepest offloads
+        std::uint64_t id = m_pending.back();
+        m_pending.pop_back();
+        MessageWriter message;
+        message.put_box(m_items[id].box);
+        w.waiting = false;
+        w.item = id + 1;
+        m_items[id].state = Item::ASSIGNED;
+        if(!send_message(w.fd, MessageType::WORK, message.payload())) {
+            worker_lost(w);
+        }
+    }
+}
+
+void Coordinator::report(bool force) {
+    double now = now_seconds();
+    if(!force && now - m_last_report < m_options.report_interval) {
+        return;
+    }
+    double dt = now - m_last_report;
+    std::size_t busy = std::count_if(m_workers.begin(), m_workers.end(),
+                                     [] (const Worker& w) { return w.fd >= 0 && w.item != 0; });
+    std::size_t connected = std::count_if(m_workers.begin(), m_workers.end(),
+                                          [] (const Worker& w) { return w.fd >= 0; });
+    std::cerr << "[coordinator] " << std::fixed << std::setprecision(1) << (now - m_start) << "s, "
+              << m_nodes << " nodes (" << std::setprecision(0)
+              << (dt > 0.0 ? double(m_nodes - m_nodes_at_last_report) / dt : 0.0) << "/s, "
+              << (now > m_start ? double(m_nodes) / (now - m_start) : 0.0) << "/s overall), "
+              << m_done << "/" << m_items.size() << " boxes done, " << m_pending.size() << " pending, "
+              << busy << "/" << connected << " workers busy" << std::defaultfloat << std::endl;
+    m_last_report = now;
+    m_nodes_at_last_report = m_nodes;
+}
+
+void Coordinator::reap_children() {
+    int status;
+    pid_t pid;
+    while((pid = ::waitpid(-1, &status, WNOHANG)) > 0) {
+        m_children.erase(std::remove(m_children.begin(), m_children.end(), pid), m_children.end());
+        if(!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << "[coordinator] Worker " << pid << " terminated abnormally" << std::endl;
+        }
+    }
+    // keep the configured number of workers running; replacements are bounded,
+    // so a box that crashes every worker cannot make us fork forever
+    std::size_t max_spawns = m_options.workers * (m_options.max_reissues + 1);
+    while(m_children.size() < m_options.workers && m_spawned < max_spawns) {
+        spawn_worker();
+    }
+}
+
+bool Coordinator::run() {
+    listen_socket();
+    m_start = m_last_report = now_seconds();
+    for(std::size_t i = 0; i < m_options.workers; ++i) {
+        spawn_worker();
+    }
+    while(!m_failed && m_done < m_items.size()) {
+        std::vector<pollfd> fds;
+        fds.push_back(pollfd{m_listen_fd, POLLIN, 0});
+        for(const Worker& w : m_workers) {
+            fds.push_back(pollfd{w.fd, POLLIN, 0});
+        }
+        int r = ::poll(fds.data(), fds.size(), 1000);
+        if(r < 0 && errno != EINTR) {
+            throw std::runtime_error(std::string("poll failed: ") + std::strerror(errno));
+        }
+        if(r > 0) {
+            if(fds[0].revents & POLLIN) {
+                accept_worker();
+            }
+            for(std::size_t i = 1; i < fds.size(); ++i) {
+                Worker& w = m_workers[i - 1];
+                if(fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                    if(!handle_input(w)) {
+                        worker_lost(w);
+                    }
+                }
+            }
+            m_workers.erase(std::remove_if(m_workers.begin(), m_workers.end(),
+                                           [] (const Worker& w) { return w.fd < 0; }), m_workers.end());
+        }
+        reap_children();
+        if(m_children.empty() && m_workers.empty() && m_done < m_items.size()) {
+            std::cerr << "[coordinator] No workers left" << std::endl;
+            m_failed = true;
+        }
+        dispatch();
+        report(false);
+    }
+    for(Worker& w : m_workers) {
+        send_message(w.fd, MessageType::SHUTDOWN);
+    }
+    report(true);
+    return !m_failed;
+}
@@ -0,0 +1,336 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdexcept>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "sharding.hpp"
+
+/**
+ * Options for distributing a proof over local worker processes:
+ * a coordinator hands out boxes over a Unix-domain socket; workers that
+ * work on a box for too long give the bottom half of their stack back.
+ */
+struct DistributedOptions {
+    std::string socket_path;
+    bool worker = false;            //< run as worker connecting to socket_path
+    std::size_t workers = 0;        //< number of local workers the coordinator spawns (0: one per core)
+    double offload_interval = 5.0;  //< seconds after which workers give back part of their stack
+    double report_interval = 10.0;  //< seconds between two progress lines of the coordinator
+    std::size_t max_reissues = 3;   //< a box whose worker died more often than this fails the proof
+
+    bool coordinator() const noexcept {
+        return !worker && !socket_path.empty();
+    }
+};
+
+inline DistributedOptions& default_distributed_options() noexcept {
+    static DistributedOptions options;
+    return options;
+}
+
+/**
+ * Messages between coordinator and workers; each message consists of
+ * its type and payload length (both uint32) followed by the payload.
+ */
+enum class MessageType : std::uint32_t {
+    REQUEST_WORK = 1,  //< worker -> coordinator: ready for a box
+    WORK = 2,          //< coordinator -> worker: a box (WireBox)
+    OFFLOAD = 3,       //< worker -> coordinator: nodes since the last message, boxes given back
+    RESULT = 4,        //< worker -> coordinator: box id, proved flag, nodes since the last message
+    SHUTDOWN = 5       //< coordinator -> worker: exit
+};
+
+/**
+ * A box as transmitted between the processes.
+ */
+struct WireBox {
+    std::uint64_t id;
+    std::uint64_t height;
+    std::vector<double> bounds;
+};
+
+class MessageWriter {
+public:
+    void put_u64(std::uint64_t value) {
+        put(&value, sizeof(value));
+    }
+
+    void put_double(double value) {
+        put(&value, sizeof(value));
+    }
+
+    void put_box(const WireBox& box) {
+        put_u64(box.id);
+        put_u64(box.height);
+        put_u64(box.bounds.size());
+        for(double d : box.bounds) {
+            put_double(d);
+        }
+    }
+
+    const std::vector<unsigned char>& payload() const noexcept {
+        return m_payload;
+    }
+
+private:
+    void put(const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        m_payload.insert(m_payload.end(), bytes, bytes + size);
+    }
+
+    std::vector<unsigned char> m_payload;
+};
+
+class MessageParser {
+public:
+    explicit MessageParser(const std::vector<unsigned char>& payload) noexcept :
+        m_payload(payload)
+    {}
+
+    std::uint64_t get_u64() {
+        std::uint64_t value;
+        get(&value, sizeof(value));
+        return value;
+    }
+
+    double get_double() {
+        double value;
+        get(&value, sizeof(value));
+        return value;
+    }
+
+    WireBox get_box() {
+        WireBox box;
+        box.id = get_u64();
+        box.height = get_u64();
+        std::uint64_t n = get_u64();
+        if(n > (m_payload.size() - m_offset) / sizeof(double)) {
+            throw std::runtime_error("Malformed box in message");
+        }
+        for(std::uint64_t i = 0; i < n; ++i) {
+            box.bounds.push_back(get_double());
+        }
+        return box;
+    }
+
+private:
+    void get(void* data, std::size_t size) {
+        if(m_payload.size() - m_offset < size) {
+            throw std::runtime_error("Truncated message");
+        }
+        std::memcpy(data, m_payload.data() + m_offset, size);
+        m_offset += size;
+    }
+
+    const std::vector<unsigned char>& m_payload;
+    std::size_t m_offset = 0;
+};
+
+/**
+ * Send a complete message; returns false if the peer is gone.
+ */
+inline bool send_message(int fd, MessageType type, const std::vector<unsigned char>& payload = {}) {
+    std::uint32_t header[2] = {static_cast<std::uint32_t>(type), static_cast<std::uint32_t>(payload.size())};
+    std::vector<unsigned char> data(reinterpret_cast<const unsigned char*>(header),
+                                    reinterpret_cast<const unsigned char*>(header) + sizeof(header));
+    data.insert(data.end(), payload.begin(), payload.end());
+    std::size_t sent = 0;
+    while(sent < data.size()) {
+        ssize_t r = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if(r < 0) {
+            if(errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        sent += std::size_t(r);
+    }
+    return true;
+}
+
+/**
+ * Collects incoming bytes and splits them into messages.
+ */
+class MessageReader {
+public:
+    void append(const unsigned char* data, std::size_t size) {
+        m_buffer.insert(m_buffer.end(), data, data + size);
+    }
+
+    bool next(MessageType& type, std::vector<unsigned char>& payload) {
+        std::uint32_t header[2];
+        if(m_buffer.size() < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(header, m_buffer.data(), sizeof(header));
+        if(m_buffer.size() < sizeof(header) + header[1]) {
+            return false;
+        }
+        type = static_cast<MessageType>(header[0]);
+        payload.assign(m_buffer.begin() + sizeof(header), m_buffer.begin() + sizeof(header) + header[1]);
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + sizeof(header) + header[1]);
+        return true;
+    }
+
+    /**
+     * Block until a complete message has been received; returns false if the peer is gone.
+     */
+    bool receive(int fd, MessageType& type, std::vector<unsigned char>& payload) {
+        unsigned char data[4096];
+        while(!next(type, payload)) {
+            ssize_t r = ::recv(fd, data, sizeof(data), 0);
+            if(r < 0 && errno == EINTR) {
+                continue;
+            }
+            if(r <= 0) {
+                return false;
+            }
+            append(data, std::size_t(r));
+        }
+        return true;
+    }
+
+private:
+    std::vector<unsigned char> m_buffer;
+};
+
+/**
+ * Hands out boxes to workers, collects their results and
+ * re-issues the box of a worker whose connection breaks.
+ * The proof succeeds once every box (initial or given back) has been proved.
+ */
+class Coordinator {
+public:
+    Coordinator(DistributedOptions options, std::vector<WireBox> initial_boxes);
+    ~Coordinator();
+
+    Coordinator(const Coordinator&) = delete;
+    Coordinator &operator=(const Coordinator&) = delete;
+
+    bool run();
+
+private:
+    struct Item {
+        WireBox box;
+        enum State { PENDING, ASSIGNED, DONE } state;
+        std::size_t reissues;
+    };
+
+    struct Worker {
+        int fd;
+        MessageReader reader;
+        std::uint64_t item;  //< id of the assigned item + 1, or 0
+        bool waiting;
+    };
+
+    void listen_socket();
+    void spawn_worker();
+    void accept_worker();
+    bool handle_input(Worker& worker);
+    bool handle_message(Worker& worker, MessageType type, const std::vector<unsigned char>& payload);
+    void worker_lost(Worker& worker);
+    void dispatch();
+    void report(bool force);
+    void reap_children();
+    std::uint64_t add_item(WireBox box);
+
+    DistributedOptions m_options;
+    int m_listen_fd = -1;
+    std::vector<Item> m_items;
+    std::vector<std::uint64_t> m_pending;
+    std::vector<Worker> m_workers;
+    std::vector<pid_t> m_children;
+    std::size_t m_spawned = 0;
+    std::size_t m_done = 0;
+    bool m_failed = false;
+    std::uint64_t m_nodes = 0, m_nodes_at_last_report = 0;
+    double m_start = 0.0, m_last_report = 0.0;
+};
+
+/**
+ * Run as worker: connect to the coordinator and prove the boxes it hands out.
+ * setup is called with a fresh prover for each box and has to add the constraints.
+ */
+template<typename VariableSet, typename ProverType, typename Setup>
+    int run_worker(const DistributedOptions& options, Setup&& setup)
+{
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, options.socket_path.c_str(), sizeof(address.sun_path) - 1);
+    if(fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        std::cerr << "Worker: could not connect to '" << options.socket_path << "': " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    MessageReader reader;
+    MessageType type;
+    std::vector<unsigned char> payload;
+    // all boxes proved by this worker share its certificate and corpus files
+    std::string instance = ".worker-" + std::to_string(::getpid());
+    bool first_box = true;
+    while(send_message(fd, MessageType::REQUEST_WORK) && reader.receive(fd, type, payload)) {
+        if(type != MessageType::WORK) {
+            break;
+        }
+        WireBox box = MessageParser(payload).get_box();
+        if(box.bounds.size() != 2 * VariableSet::num_vars) {
+            std::cerr << "Worker: received a box with the wrong number of variables" << std::endl;
+            break;
+        }
+        VariableSet vars;
+        vars.assign_values(box.bounds.data());
+        ProverType prover;
+        setup(prover);
+        prover.set_instance(instance);
+        prover.append_outputs(!first_box);
+        first_box = false;
+        prover.add_variable_set(vars, box.height);
+        std::uint64_t reported_nodes = 0;
+        bool connected = true;
+        prover.set_offload_handler(options.offload_interval, [&] (std::vector<ExpandedBox<VariableSet>>&& boxes) {
+            MessageWriter message;
+            message.put_u64(prover.stats().nodes - reported_nodes);
+            reported_nodes = prover.stats().nodes;
+            message.put_u64(boxes.size());
+            for(const auto& b : boxes) {
+                message.put_box(WireBox{0, b.height, box_bounds(b.domain)});
+            }
+            connected = connected && send_message(fd, MessageType::OFFLOAD, message.payload());
+        });
+        bool proved = prover.prove();
+        MessageWriter result;
+        result.put_u64(box.id);
+        result.put_u64(proved ? 1 : 0);
+        result.put_u64(prover.stats().nodes - reported_nodes);
+        if(!connected || !send_message(fd, MessageType::RESULT, result.payload())) {
+            break;
+        }
+    }
+    ::close(fd);
+    return 0;
+}
@@ -25,6 +25,8 @@
 #include <sstream>
 #include "basic_variable_set.hpp"
 #include "prover.hpp"
+#include "trace_registry.hpp"
+#include "corpus_replay.hpp"
 
 using IDouble = ivarp::IDouble;
 using IBool = ivarp::IBool;
@@ -129,13 +131,18 @@ const ivarp::IDouble EquilateralCase3Variables::initial_values[EquilateralCase3V
 constexpr EquilateralCase3Variables::OnChangeHandler
 EquilateralCase3Variables::change_handlers[EquilateralCase3Variables::num_vars];
 
+static void setup_equilateral(Prover<EquilateralCase3Variables>& prover_equilateral) {
+    prover_equilateral.set_name("equilateral");
+    prover_equilateral.emplace_constraint<FormulaViolated>();
+    prover_equilateral.abort_on_satisfiable();
+    prover_equilateral.abort_at_height(100);
+}
+
 bool proof_equilateral() {
     Prover<EquilateralCase3Variables> prover_equilateral;
+    setup_equilateral(prover_equilateral);
     EquilateralCase3Variables variables;
     prover_equilateral.add_variable_set(variables);
-    prover_equilateral.emplace_constraint<FormulaViolated>();
-    prover_equilateral.abort_on_satisfiable();
-    prover_equilateral.abort_at_height(100);
     if(!prover_equilateral.prove()) {
 		return false;
 	}
@@ -143,3 +150,11 @@ bool proof_equilateral() {
 	return true;
 }
 
+
+void register_equilateral_trace_renderers() {
+    register_trace_renderer<EquilateralCase3Variables>("equilateral");
+}
+
+void register_equilateral_corpus_replayers() {
+    register_corpus_replayer<EquilateralCase3Variables>("equilateral", &setup_equilateral);
+}
@@ -0,0 +1,411 @@
+// Generated by generate_kernels.py from below_45_isoceles_derivatives.kernels; do not edit.
+
+#pragma once
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <cstddef>
+#include <tuple>
+
+/**
+ * dΔ/dr_1.
+ */
+inline ivarp::IDouble diff_restweight_by_r1(ivarp::IDouble alpha, ivarp::IDouble r1, ivarp::IDouble r2) noexcept {
+    const ivarp::IDouble t0 = ivarp::square(r1);
+    const ivarp::IDouble x0 = 8.0 * t0;
+    const ivarp::IDouble t1 = ivarp::square(r2);
+    const ivarp::IDouble x1 = 2.0 * t1;
+    const ivarp::IDouble x2 = ivarp::cos(alpha);
+    const ivarp::IDouble x3 = 2.0 * alpha;
+    const ivarp::IDouble t2 = 2.0 * r2;
+    ivarp::IDouble t3, t4;
+    std::tie(t3, t4) = ivarp::sincos(x3);
+    const ivarp::IDouble x4 = ivarp::mul_nonneg(t2, t3);
+    const ivarp::IDouble x5 = x1 * t4;
+    const ivarp::IDouble t6 = ivarp::fma(x0, x2, -x0);
+    const ivarp::IDouble t7 = x1 + t6;
+    const ivarp::IDouble t8 = t7 - x4;
+    const ivarp::IDouble t9 = t8 - x5;
+    const ivarp::IDouble x6 = t9 + 1.0;
+    const ivarp::IDouble t10 = x4 - x1;
+    const ivarp::IDouble t11 = x5 + t10;
+    const ivarp::IDouble t12 = t11 - 1.0;
+    const ivarp::IDouble t13 = -ivarp::div_pos(x6, -t12);
+    const ivarp::IDouble x7 = ivarp::sqrt(t13);
+    const ivarp::IDouble t14 = 2.0 * r1;
+    const ivarp::IDouble t15 = 2.0 * x7;
+    const ivarp::IDouble t16 = x2 - 1.0;
+    const ivarp::IDouble t17 = t15 * t16;
+    const ivarp::IDouble t18 = 0.5 * alpha;
+    const ivarp::IDouble t19 = ivarp::tan(t18);
+    const ivarp::IDouble t20 = x7 - t19;
+    const ivarp::IDouble t22 = ivarp::fma(t17, t20, x6);
+    const ivarp::IDouble t23 = t14 * t22;
+    const ivarp::IDouble value = -t23 / x6;
+    return value;
+}
+
+/// diff_restweight_by_r1 for n argument tuples, from the arrays of the arguments to the arrays of the outputs.
+inline void diff_restweight_by_r1(const ivarp::IDouble* alpha, const ivarp::IDouble* r1, const ivarp::IDouble* r2, ivarp::IDouble* value, std::size_t n) noexcept {
+    for(std::size_t i = 0; i < n; ++i) {
+        value[i] = diff_restweight_by_r1(alpha[i], r1[i], r2[i]);
+    }
+}
+
+/**
+ * dΔ/dr_2.
+ */
+inline ivarp::IDouble diff_restweight_by_r2(ivarp::IDouble alpha, ivarp::IDouble r2) noexcept {
+    const ivarp::IDouble t0 = ivarp::square(r2);
+    const ivarp::IDouble x0 = 2.0 * t0;
+    const ivarp::IDouble x1 = 2.0 * alpha;
+    ivarp::IDouble x2, x4;
+    std::tie(x2, x4) = ivarp::sincos(x1);
+    const ivarp::IDouble x3 = 2.0 * r2;
+    const ivarp::IDouble t2 = ivarp::fma(x0, x4, -x0);
+    const ivarp::IDouble x5 = ivarp::fma(x2, x3, t2);
+    const ivarp::IDouble x6 = x5 - 1.0;
+    const ivarp::IDouble x7 = -ivarp::div_pos(ivarp::IDouble(1.0), -x6);
+    const ivarp::IDouble x8 = ivarp::cos(alpha);
+    const ivarp::IDouble t5 = ivarp::fma(x8, -2.0, x5);
+    const ivarp::IDouble x9 = t5 + 1.0;
+    const ivarp::IDouble t7 = ivarp::mul_nonneg(-x7, x9);
+    const ivarp::IDouble x10 = ivarp::sqrt(t7);
+    const ivarp::IDouble t8 = 0.5 * alpha;
+    const ivarp::IDouble t9 = ivarp::tan(t8);
+    const ivarp::IDouble t10 = x10 - t9;
+    const ivarp::IDouble t11 = x10 * t10;
+    const ivarp::IDouble t12 = x8 - 1.0;
+    const ivarp::IDouble t13 = t11 * t12;
+    const ivarp::IDouble t15 = ivarp::fma(x3, x4, x2);
+    const ivarp::IDouble t16 = t15 - x3;
+    const ivarp::IDouble t18 = -ivarp::mul_nonneg(x3, -x6);
+    const ivarp::IDouble t19 = -ivarp::mul_nonneg(x9, -t18);
+    const ivarp::IDouble t20 = ivarp::fma(t13, t16, t19);
+    const ivarp::IDouble t21 = ivarp::mul_nonneg(-x7, -t20);
+    const ivarp::IDouble value = -ivarp::div_pos(t21, x9);
+    return value;
+}
+
+/// diff_restweight_by_r2 for n argument tuples, from the arrays of the arguments to the arrays of the outputs.
+inline void diff_restweight_by_r2(const ivarp::IDouble* alpha, const ivarp::IDouble* r2, ivarp::IDouble* value, std::size_t n) noexcept {
+    for(std::size_t i = 0; i < n; ++i) {
+        value[i] = diff_restweight_by_r2(alpha[i], r2[i]);
+    }
+}
+
+/**
+ * dΔ/dα; with its derivative d²Δ/dα² for checking the monotonicity of dΔ/dα.
+ */
+inline ivarp::IDouble diff_restweight_by_alpha(ivarp::IDouble alpha) noexcept {
+    ivarp::IDouble x0, x7;
+    std::tie(x0, x7) = ivarp::sincos(alpha);
+    const ivarp::IDouble x1 = 2.0 * alpha;
+    ivarp::IDouble x3, x2;
+    std::tie(x3, x2) = ivarp::sincos(x1);
+    const ivarp::IDouble t0 = ivarp::fma(x3, 2.0, x2);
+    const ivarp::IDouble x5 = t0 - 3.0;
+    const ivarp::IDouble x6 = -ivarp::div_pos(ivarp::IDouble(1.0), -x5);
+    const ivarp::IDouble t2 = ivarp::fma(x7, 4.0, -t0);
+    const ivarp::IDouble x8 = t2 - 1.0;
+    const ivarp::IDouble x9 = ivarp::square(x0);
+    const ivarp::IDouble x10 = 0.5 * alpha;
+    const ivarp::IDouble t3 = ivarp::mul_nonneg(-x6, -x8);
+    const ivarp::IDouble x11 = ivarp::sqrt(t3);
+    const ivarp::IDouble t4 = ivarp::tan(x10);
+    const ivarp::IDouble x12 = x11 - t4;
+    const ivarp::IDouble t5 = ivarp::square(x12);
+    const ivarp::IDouble x13 = t5 + 2.0;
+    const ivarp::IDouble x14 = ivarp::mul_nonneg(-x5, -x8);
+    const ivarp::IDouble t6 = 2.0 * x14;
+    const ivarp::IDouble x15 = ivarp::mul_nonneg(x7, t6);
+    const ivarp::IDouble x16 = 3.0 * alpha;
+    const ivarp::IDouble t8 = ivarp::fma(x9, x13, ivarp::IDouble(-1.0));
+    const ivarp::IDouble t10 = x0 * x12;
+    const ivarp::IDouble t11 = 2.0 * x11;
+    const ivarp::IDouble t13 = 8.0 * x2;
+    const ivarp::IDouble t14 = ivarp::fma(x0, 9.0, t13);
+    const ivarp::IDouble t16 = ivarp::fma(x3, 4.0, -t14);
+    const ivarp::IDouble t18 = ivarp::fma(x7, 6.0, t16);
+    ivarp::IDouble t19, t21;
+    std::tie(t19, t21) = ivarp::sincos(x16);
+    const ivarp::IDouble t20 = t18 - t19;
+    const ivarp::IDouble t23 = ivarp::fma(t21, 2.0, t20);
+    const ivarp::IDouble t25 = ivarp::cos(x10);
+    const ivarp::IDouble t26 = ivarp::square(t25);
+    const ivarp::IDouble t27 = ivarp::div_pos(x14, t26);
+    const ivarp::IDouble t28 = ivarp::fma(t11, t23, t27);
+    const ivarp::IDouble t30 = ivarp::mul_nonneg(x13, x15);
+    const ivarp::IDouble t31 = ivarp::fma(t10, t28, -t30);
+    const ivarp::IDouble t32 = -ivarp::mul_nonneg(x9, -t31);
+    const ivarp::IDouble t33 = ivarp::fma(x15, t8, t32);
+    const ivarp::IDouble t34 = ivarp::mul_nonneg(-x6, -t33);
+    const ivarp::IDouble t35 = ivarp::cube(x0);
+    const ivarp::IDouble t36 = 4.0 * t35;
+    const ivarp::IDouble t37 = -ivarp::mul_nonneg(-x8, t36);
+    const ivarp::IDouble value = -ivarp::div_pos(t34, -t37);
+    return value;
+}
+
+/// diff_restweight_by_alpha for n argument tuples, from the arrays of the arguments to the arrays of the outputs.
+inline void diff_restweight_by_alpha(const ivarp::IDouble* alpha, ivarp::IDouble* value, std::size_t n) noexcept {
+    for(std::size_t i = 0; i < n; ++i) {
+        value[i] = diff_restweight_by_alpha(alpha[i]);
+    }
+}
+
+struct DiffRestweightByAlphaWithDerivatives {
+    ivarp::IDouble value;
+    ivarp::IDouble d_value_d_alpha;
+};
+
+/// diff_restweight_by_alpha and its partial derivatives for alpha (forward mode).
+inline DiffRestweightByAlphaWithDerivatives diff_restweight_by_alpha_with_derivatives(ivarp::IDouble alpha) noexcept {
+    ivarp::IDouble x0, x7;
+    std::tie(x0, x7) = ivarp::sincos(alpha);
+    const ivarp::IDouble x1 = 2.0 * alpha;
+    ivarp::IDouble x3, x2;
+    std::tie(x3, x2) = ivarp::sincos(x1);
+    const ivarp::IDouble x4 = 2.0 * x3;
+    const ivarp::IDouble t0 = x2 + x4;
+    const ivarp::IDouble x5 = t0 - 3.0;
+    const ivarp::IDouble x6 = -ivarp::div_pos(ivarp::IDouble(1.0), -x5);
+    const ivarp::IDouble t2 = ivarp::fma(x7, 4.0, -t0);
+    const ivarp::IDouble x8 = t2 - 1.0;
+    const ivarp::IDouble x9 = ivarp::square(x0);
+    const ivarp::IDouble x10 = 0.5 * alpha;
+    const ivarp::IDouble t3 = ivarp::mul_nonneg(-x6, -x8);
+    const ivarp::IDouble x11 = ivarp::sqrt(t3);
+    const ivarp::IDouble t4 = ivarp::tan(x10);
+    const ivarp::IDouble x12 = x11 - t4;
+    const ivarp::IDouble t5 = ivarp::square(x12);
+    const ivarp::IDouble x13 = t5 + 2.0;
+    const ivarp::IDouble x14 = ivarp::mul_nonneg(-x5, -x8);
+    const ivarp::IDouble t6 = 2.0 * x14;
+    const ivarp::IDouble x15 = ivarp::mul_nonneg(x7, t6);
+    const ivarp::IDouble x16 = 3.0 * alpha;
+    const ivarp::IDouble t8 = ivarp::fma(x9, x13, ivarp::IDouble(-1.0));
+    const ivarp::IDouble t10 = x0 * x12;
+    const ivarp::IDouble t11 = 2.0 * x11;
+    const ivarp::IDouble t13 = 8.0 * x2;
+    const ivarp::IDouble t14 = ivarp::fma(x0, 9.0, t13);
+    const ivarp::IDouble t16 = ivarp::fma(x3, 4.0, -t14);
+    const ivarp::IDouble t18 = ivarp::fma(x7, 6.0, t16);
+    ivarp::IDouble t19, t21;
+    std::tie(t19, t21) = ivarp::sincos(x16);
+    const ivarp::IDouble t20 = t18 - t19;
+    const ivarp::IDouble t23 = ivarp::fma(t21, 2.0, t20);
+    ivarp::IDouble t86, t25;
+    std::tie(t86, t25) = ivarp::sincos(x10);
+    const ivarp::IDouble t26 = ivarp::square(t25);
+    const ivarp::IDouble t27 = ivarp::div_pos(x14, t26);
+    const ivarp::IDouble t28 = ivarp::fma(t11, t23, t27);
+    const ivarp::IDouble t30 = ivarp::mul_nonneg(x13, x15);
+    const ivarp::IDouble t31 = ivarp::fma(t10, t28, -t30);
+    const ivarp::IDouble t32 = -ivarp::mul_nonneg(x9, -t31);
+    const ivarp::IDouble t33 = ivarp::fma(x15, t8, t32);
+    const ivarp::IDouble t34 = ivarp::mul_nonneg(-x6, -t33);
+    const ivarp::IDouble t35 = ivarp::cube(x0);
+    const ivarp::IDouble t36 = 4.0 * t35;
+    const ivarp::IDouble t37 = -ivarp::mul_nonneg(-x8, t36);
+    const ivarp::IDouble value = -ivarp::div_pos(t34, -t37);
+    const ivarp::IDouble t39 = ivarp::fma(x2, 4.0, -x4);
+    const ivarp::IDouble t40 = ivarp::mul_nonneg(-x6, -t39);
+    const ivarp::IDouble t41 = -ivarp::div_pos(t40, -x5);
+    const ivarp::IDouble t43 = ivarp::fma(x0, 4.0, t39);
+    const ivarp::IDouble t45 = -ivarp::mul_nonneg(-x5, t43);
+    const ivarp::IDouble t46 = ivarp::fma(x8, t39, -t45);
+    const ivarp::IDouble t47 = 2.0 * t46;
+    const ivarp::IDouble t48 = ivarp::mul_nonneg(x0, t6);
+    const ivarp::IDouble t50 = ivarp::fma(x7, t47, -t48);
+    const ivarp::IDouble t51 = 2.0 * x0;
+    const ivarp::IDouble t52 = ivarp::mul_nonneg(x7, t51);
+    const ivarp::IDouble t54 = -ivarp::mul_nonneg(-x6, t43);
+    const ivarp::IDouble t55 = ivarp::fma(x8, t41, t54);
+    const ivarp::IDouble t56 = ivarp::div_pos(t55, x11);
+    const ivarp::IDouble t58 = ivarp::square(t4);
+    const ivarp::IDouble t59 = t58 + 1.0;
+    const ivarp::IDouble t60 = 0.5 * t59;
+    const ivarp::IDouble t61 = ivarp::fma(t56, 0.5, t60);
+    const ivarp::IDouble t62 = 2.0 * x12;
+    const ivarp::IDouble t63 = t61 * t62;
+    const ivarp::IDouble t65 = x9 * t63;
+    const ivarp::IDouble t66 = ivarp::fma(x13, t52, -t65);
+    const ivarp::IDouble t68 = ivarp::mul_nonneg(x15, t66);
+    const ivarp::IDouble t69 = ivarp::fma(t8, t50, t68);
+    const ivarp::IDouble t71 = x0 * t61;
+    const ivarp::IDouble t72 = ivarp::fma(x7, x12, -t71);
+    const ivarp::IDouble t74 = 16.0 * x3;
+    const ivarp::IDouble t75 = ivarp::fma(x7, 9.0, -t74);
+    const ivarp::IDouble t76 = t13 - t75;
+    const ivarp::IDouble t78 = ivarp::fma(x0, -6.0, t76);
+    const ivarp::IDouble t80 = ivarp::fma(t21, -3.0, t78);
+    const ivarp::IDouble t82 = ivarp::fma(t19, -6.0, t80);
+    const ivarp::IDouble t83 = t23 * t56;
+    const ivarp::IDouble t85 = ivarp::fma(t11, t82, -t83);
+    const ivarp::IDouble t87 = 0.5 * t86;
+    const ivarp::IDouble t88 = 2.0 * t25;
+    const ivarp::IDouble t89 = ivarp::mul_nonneg(t87, t88);
+    const ivarp::IDouble t91 = ivarp::fma(t27, t89, t46);
+    const ivarp::IDouble t92 = ivarp::div_pos(t91, t26);
+    const ivarp::IDouble t93 = t85 + t92;
+    const ivarp::IDouble t95 = t10 * t93;
+    const ivarp::IDouble t96 = ivarp::fma(t28, t72, t95);
+    const ivarp::IDouble t97 = x15 * t63;
+    const ivarp::IDouble t99 = ivarp::fma(x13, t50, -t97);
+    const ivarp::IDouble t100 = t96 - t99;
+    const ivarp::IDouble t102 = -ivarp::mul_nonneg(x9, -t100);
+    const ivarp::IDouble t103 = ivarp::fma(t31, t52, t102);
+    const ivarp::IDouble t104 = t69 + t103;
+    const ivarp::IDouble t105 = ivarp::mul_nonneg(-t33, -t41);
+    const ivarp::IDouble t107 = ivarp::fma(x6, t104, -t105);
+    const ivarp::IDouble t108 = 3.0 * x9;
+    const ivarp::IDouble t109 = ivarp::mul_nonneg(x7, t108);
+    const ivarp::IDouble t110 = 4.0 * t109;
+    const ivarp::IDouble t111 = ivarp::mul_nonneg(t36, t43);
+    const ivarp::IDouble t113 = ivarp::fma(x8, t110, -t111);
+    const ivarp::IDouble t115 = ivarp::fma(-value, t113, t107);
+    const ivarp::IDouble d_value_d_alpha = -ivarp::div_pos(t115, -t37);
+    return DiffRestweightByAlphaWithDerivatives{value, d_value_d_alpha};
+}
+
+namespace reference_kernels {
+/// diff_restweight_by_r1 as plain interval operations in the order of the expression file.
+inline ivarp::IDouble diff_restweight_by_r1(ivarp::IDouble alpha, ivarp::IDouble r1, ivarp::IDouble r2) noexcept {
+    const ivarp::IDouble t0 = ivarp::square(r1);
+    const ivarp::IDouble x0 = 8.0 * t0;
+    const ivarp::IDouble t1 = ivarp::square(r2);
+    const ivarp::IDouble x1 = 2.0 * t1;
+    const ivarp::IDouble x2 = ivarp::cos(alpha);
+    const ivarp::IDouble x3 = 2.0 * alpha;
+    const ivarp::IDouble t2 = 2.0 * r2;
+    const ivarp::IDouble t3 = ivarp::sin(x3);
+    const ivarp::IDouble x4 = t2 * t3;
+    const ivarp::IDouble t4 = ivarp::cos(x3);
+    const ivarp::IDouble x5 = x1 * t4;
+    const ivarp::IDouble t5 = x0 * x2;
+    const ivarp::IDouble t6 = t5 - x0;
+    const ivarp::IDouble t7 = x1 + t6;
+    const ivarp::IDouble t8 = t7 - x4;
+    const ivarp::IDouble t9 = t8 - x5;
+    const ivarp::IDouble x6 = t9 + 1.0;
+    const ivarp::IDouble t10 = x4 - x1;
+    const ivarp::IDouble t11 = x5 + t10;
+    const ivarp::IDouble t12 = t11 - 1.0;
+    const ivarp::IDouble t13 = x6 / t12;
+    const ivarp::IDouble x7 = ivarp::sqrt(t13);
+    const ivarp::IDouble t14 = 2.0 * r1;
+    const ivarp::IDouble t15 = 2.0 * x7;
+    const ivarp::IDouble t16 = x2 - 1.0;
+    const ivarp::IDouble t17 = t15 * t16;
+    const ivarp::IDouble t18 = 0.5 * alpha;
+    const ivarp::IDouble t19 = ivarp::tan(t18);
+    const ivarp::IDouble t20 = x7 - t19;
+    const ivarp::IDouble t21 = t17 * t20;
+    const ivarp::IDouble t22 = x6 + t21;
+    const ivarp::IDouble t23 = t14 * t22;
+    const ivarp::IDouble t24 = t23 / x6;
+    const ivarp::IDouble value = -t24;
+    return value;
+}
+
+/// diff_restweight_by_r2 as plain interval operations in the order of the expression file.
+inline ivarp::IDouble diff_restweight_by_r2(ivarp::IDouble alpha, ivarp::IDouble r2) noexcept {
+    const ivarp::IDouble t0 = ivarp::square(r2);
+    const ivarp::IDouble x0 = 2.0 * t0;
+    const ivarp::IDouble x1 = 2.0 * alpha;
+    const ivarp::IDouble x2 = ivarp::sin(x1);
+    const ivarp::IDouble x3 = 2.0 * r2;
+    const ivarp::IDouble x4 = ivarp::cos(x1);
+    const ivarp::IDouble t1 = x0 * x4;
+    const ivarp::IDouble t2 = t1 - x0;
+    const ivarp::IDouble t3 = x2 * x3;
+    const ivarp::IDouble x5 = t2 + t3;
+    const ivarp::IDouble x6 = x5 - 1.0;
+    const ivarp::IDouble x7 = 1.0 / x6;
+    const ivarp::IDouble x8 = ivarp::cos(alpha);
+    const ivarp::IDouble t4 = 2.0 * x8;
+    const ivarp::IDouble t5 = x5 - t4;
+    const ivarp::IDouble x9 = t5 + 1.0;
+    const ivarp::IDouble t6 = x7 * x9;
+    const ivarp::IDouble t7 = -t6;
+    const ivarp::IDouble x10 = ivarp::sqrt(t7);
+    const ivarp::IDouble t8 = 0.5 * alpha;
+    const ivarp::IDouble t9 = ivarp::tan(t8);
+    const ivarp::IDouble t10 = x10 - t9;
+    const ivarp::IDouble t11 = x10 * t10;
+    const ivarp::IDouble t12 = x8 - 1.0;
+    const ivarp::IDouble t13 = t11 * t12;
+    const ivarp::IDouble t14 = x3 * x4;
+    const ivarp::IDouble t15 = x2 + t14;
+    const ivarp::IDouble t16 = t15 - x3;
+    const ivarp::IDouble t17 = t13 * t16;
+    const ivarp::IDouble t18 = x3 * x6;
+    const ivarp::IDouble t19 = x9 * t18;
+    const ivarp::IDouble t20 = t17 + t19;
+    const ivarp::IDouble t21 = x7 * t20;
+    const ivarp::IDouble t22 = t21 / x9;
+    const ivarp::IDouble value = -t22;
+    return value;
+}
+
+/// diff_restweight_by_alpha as plain interval operations in the order of the expression file.
+inline ivarp::IDouble diff_restweight_by_alpha(ivarp::IDouble alpha) noexcept {
+    const ivarp::IDouble x0 = ivarp::sin(alpha);
+    const ivarp::IDouble x1 = 2.0 * alpha;
+    const ivarp::IDouble x2 = ivarp::cos(x1);
+    const ivarp::IDouble x3 = ivarp::sin(x1);
+    const ivarp::IDouble x4 = 2.0 * x3;
+    const ivarp::IDouble t0 = x2 + x4;
+    const ivarp::IDouble x5 = t0 - 3.0;
+    const ivarp::IDouble x6 = 1.0 / x5;
+    const ivarp::IDouble x7 = ivarp::cos(alpha);
+    const ivarp::IDouble t1 = 4.0 * x7;
+    const ivarp::IDouble t2 = t1 - t0;
+    const ivarp::IDouble x8 = t2 - 1.0;
+    const ivarp::IDouble x9 = ivarp::square(x0);
+    const ivarp::IDouble x10 = 0.5 * alpha;
+    const ivarp::IDouble t3 = x6 * x8;
+    const ivarp::IDouble x11 = ivarp::sqrt(t3);
+    const ivarp::IDouble t4 = ivarp::tan(x10);
+    const ivarp::IDouble x12 = x11 - t4;
+    const ivarp::IDouble t5 = ivarp::square(x12);
+    const ivarp::IDouble x13 = t5 + 2.0;
+    const ivarp::IDouble x14 = x5 * x8;
+    const ivarp::IDouble t6 = 2.0 * x14;
+    const ivarp::IDouble x15 = x7 * t6;
+    const ivarp::IDouble x16 = 3.0 * alpha;
+    const ivarp::IDouble t7 = x9 * x13;
+    const ivarp::IDouble t8 = t7 - 1.0;
+    const ivarp::IDouble t9 = x15 * t8;
+    const ivarp::IDouble t10 = x0 * x12;
+    const ivarp::IDouble t11 = 2.0 * x11;
+    const ivarp::IDouble t12 = 9.0 * x0;
+    const ivarp::IDouble t13 = 8.0 * x2;
+    const ivarp::IDouble t14 = t12 + t13;
+    const ivarp::IDouble t15 = 4.0 * x3;
+    const ivarp::IDouble t16 = t15 - t14;
+    const ivarp::IDouble t17 = 6.0 * x7;
+    const ivarp::IDouble t18 = t16 + t17;
+    const ivarp::IDouble t19 = ivarp::sin(x16);
+    const ivarp::IDouble t20 = t18 - t19;
+    const ivarp::IDouble t21 = ivarp::cos(x16);
+    const ivarp::IDouble t22 = 2.0 * t21;
+    const ivarp::IDouble t23 = t20 + t22;
+    const ivarp::IDouble t24 = t11 * t23;
+    const ivarp::IDouble t25 = ivarp::cos(x10);
+    const ivarp::IDouble t26 = ivarp::square(t25);
+    const ivarp::IDouble t27 = x14 / t26;
+    const ivarp::IDouble t28 = t24 + t27;
+    const ivarp::IDouble t29 = t10 * t28;
+    const ivarp::IDouble t30 = x13 * x15;
+    const ivarp::IDouble t31 = t29 - t30;
+    const ivarp::IDouble t32 = x9 * t31;
+    const ivarp::IDouble t33 = t9 + t32;
+    const ivarp::IDouble t34 = x6 * t33;
+    const ivarp::IDouble t35 = ivarp::cube(x0);
+    const ivarp::IDouble t36 = 4.0 * t35;
+    const ivarp::IDouble t37 = x8 * t36;
+    const ivarp::IDouble value = t34 / t37;
+    return value;
+}
+}
@@ -0,0 +1,151 @@
+// Generated by generate_kernels.py from r1_in_center.kernels; do not edit.
+
+#pragma once
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <cstddef>
+#include <tuple>
+
+struct R1InCenterChi1 {
+    ivarp::IDouble chi_1;
+    ivarp::IDouble sin_half_alpha;
+    ivarp::IDouble cos_half_alpha;
+};
+
+/**
+ * The distance chi_1 from the apex at which r_1 must be centered, with sin(α/2) and cos(α/2).
+ */
+inline R1InCenterChi1 r1_in_center_chi1(ivarp::IDouble alpha, ivarp::IDouble r1) noexcept {
+    const ivarp::IDouble x0 = 0.5 * alpha;
+    ivarp::IDouble sin_half_alpha, cos_half_alpha;
+    std::tie(sin_half_alpha, cos_half_alpha) = ivarp::sincos(x0);
+    const ivarp::IDouble x2 = sin_half_alpha + 1.0;
+    const ivarp::IDouble x3 = ivarp::div_pos(ivarp::IDouble(1.0), x2);
+    const ivarp::IDouble t1 = ivarp::fma(r1, sin_half_alpha, r1);
+    const ivarp::IDouble t3 = ivarp::fma(cos_half_alpha, -0.5, t1);
+    const ivarp::IDouble chi_1 = x3 * t3;
+    return R1InCenterChi1{chi_1, sin_half_alpha, cos_half_alpha};
+}
+
+struct R1InCenterRemainingSizes {
+    ivarp::IDouble r1_squared;
+    ivarp::IDouble remaining_triangle_half_base;
+    ivarp::IDouble remaining_triangle_height;
+    ivarp::IDouble remaining_pocket_width;
+    ivarp::IDouble remaining_pocket_height;
+};
+
+/**
+ * The remaining triangle and pocket below r_1, given the trigonometric values of α.
+ */
+inline R1InCenterRemainingSizes r1_in_center_remaining_sizes(ivarp::IDouble sin_half_alpha, ivarp::IDouble cos_half_alpha, ivarp::IDouble tan_half_alpha, ivarp::IDouble cos_alpha, ivarp::IDouble r1) noexcept {
+    const ivarp::IDouble x2 = sin_half_alpha + 1.0;
+    const ivarp::IDouble x3 = ivarp::div_pos(ivarp::IDouble(1.0), x2);
+    const ivarp::IDouble r1_squared = ivarp::square(r1);
+    const ivarp::IDouble x8 = 8.0 * r1_squared;
+    const ivarp::IDouble x9 = 4.0 * r1_squared;
+    const ivarp::IDouble t0 = ivarp::square(tan_half_alpha);
+    const ivarp::IDouble x10 = x9 * t0;
+    const ivarp::IDouble t1 = 16.0 * sin_half_alpha;
+    const ivarp::IDouble t3 = cos_alpha * x10;
+    const ivarp::IDouble t4 = ivarp::fma(r1_squared, t1, t3);
+    const ivarp::IDouble t5 = x10 + t4;
+    const ivarp::IDouble t6 = t5 - cos_alpha;
+    const ivarp::IDouble t7 = x8 + t6;
+    const ivarp::IDouble t8 = t7 - 1.0;
+    const ivarp::IDouble t9 = cos_alpha + 1.0;
+    const ivarp::IDouble t10 = ivarp::div_pos(t8, t9);
+    const ivarp::IDouble t11 = ivarp::sqrt(t10);
+    const ivarp::IDouble x11 = cos_half_alpha * t11;
+    const ivarp::IDouble x12 = sin_half_alpha - 1.0;
+    const ivarp::IDouble x13 = -ivarp::mul_nonneg(tan_half_alpha, -x12);
+    const ivarp::IDouble t12 = 2.0 * cos_half_alpha;
+    const ivarp::IDouble x14 = ivarp::div_pos(ivarp::IDouble(1.0), t12);
+    const ivarp::IDouble x15 = ivarp::square(cos_half_alpha);
+    const ivarp::IDouble t13 = x2 - x11;
+    const ivarp::IDouble x16 = ivarp::mul_nonneg(x14, t13);
+    const ivarp::IDouble t14 = x2 + x11;
+    const ivarp::IDouble t16 = ivarp::fma(x13, t14, cos_half_alpha);
+    const ivarp::IDouble remaining_triangle_half_base = ivarp::mul_nonneg(x14, t16);
+    const ivarp::IDouble remaining_triangle_height = ivarp::div_pos(remaining_triangle_half_base, tan_half_alpha);
+    const ivarp::IDouble t17 = 1.0 - sin_half_alpha;
+    const ivarp::IDouble remaining_pocket_width = ivarp::mul_nonneg(x16, t17);
+    const ivarp::IDouble t19 = x9 * x15;
+    const ivarp::IDouble t20 = ivarp::fma(sin_half_alpha, x8, -t19);
+    const ivarp::IDouble t21 = t20 - x15;
+    const ivarp::IDouble t22 = x8 + t21;
+    const ivarp::IDouble t23 = ivarp::sqrt(t22);
+    const ivarp::IDouble t24 = x2 - t23;
+    const ivarp::IDouble t25 = x3 * t24;
+    const ivarp::IDouble t26 = 0.5 * t25;
+    const ivarp::IDouble t28 = ivarp::mul_nonneg(-x13, x16);
+    const ivarp::IDouble remaining_pocket_height = (ivarp::max)(t26, t28);
+    return R1InCenterRemainingSizes{r1_squared, remaining_triangle_half_base, remaining_triangle_height, remaining_pocket_width, remaining_pocket_height};
+}
+
+namespace reference_kernels {
+/// r1_in_center_chi1 as plain interval operations in the order of the expression file.
+inline ::R1InCenterChi1 r1_in_center_chi1(ivarp::IDouble alpha, ivarp::IDouble r1) noexcept {
+    const ivarp::IDouble x0 = 0.5 * alpha;
+    const ivarp::IDouble sin_half_alpha = ivarp::sin(x0);
+    const ivarp::IDouble x2 = sin_half_alpha + 1.0;
+    const ivarp::IDouble x3 = 1.0 / x2;
+    const ivarp::IDouble cos_half_alpha = ivarp::cos(x0);
+    const ivarp::IDouble t0 = r1 * sin_half_alpha;
+    const ivarp::IDouble t1 = r1 + t0;
+    const ivarp::IDouble t2 = 0.5 * cos_half_alpha;
+    const ivarp::IDouble t3 = t1 - t2;
+    const ivarp::IDouble chi_1 = x3 * t3;
+    return ::R1InCenterChi1{chi_1, sin_half_alpha, cos_half_alpha};
+}
+
+/// r1_in_center_remaining_sizes as plain interval operations in the order of the expression file.
+inline ::R1InCenterRemainingSizes r1_in_center_remaining_sizes(ivarp::IDouble sin_half_alpha, ivarp::IDouble cos_half_alpha, ivarp::IDouble tan_half_alpha, ivarp::IDouble cos_alpha, ivarp::IDouble r1) noexcept {
+    const ivarp::IDouble x2 = sin_half_alpha + 1.0;
+    const ivarp::IDouble x3 = 1.0 / x2;
+    const ivarp::IDouble r1_squared = ivarp::square(r1);
+    const ivarp::IDouble x8 = 8.0 * r1_squared;
+    const ivarp::IDouble x9 = 4.0 * r1_squared;
+    const ivarp::IDouble t0 = ivarp::square(tan_half_alpha);
+    const ivarp::IDouble x10 = x9 * t0;
+    const ivarp::IDouble t1 = 16.0 * sin_half_alpha;
+    const ivarp::IDouble t2 = r1_squared * t1;
+    const ivarp::IDouble t3 = cos_alpha * x10;
+    const ivarp::IDouble t4 = t2 + t3;
+    const ivarp::IDouble t5 = x10 + t4;
+    const ivarp::IDouble t6 = t5 - cos_alpha;
+    const ivarp::IDouble t7 = x8 + t6;
+    const ivarp::IDouble t8 = t7 - 1.0;
+    const ivarp::IDouble t9 = cos_alpha + 1.0;
+    const ivarp::IDouble t10 = t8 / t9;
+    const ivarp::IDouble t11 = ivarp::sqrt(t10);
+    const ivarp::IDouble x11 = cos_half_alpha * t11;
+    const ivarp::IDouble x12 = sin_half_alpha - 1.0;
+    const ivarp::IDouble x13 = tan_half_alpha * x12;
+    const ivarp::IDouble t12 = 2.0 * cos_half_alpha;
+    const ivarp::IDouble x14 = 1.0 / t12;
+    const ivarp::IDouble x15 = ivarp::square(cos_half_alpha);
+    const ivarp::IDouble t13 = x2 - x11;
+    const ivarp::IDouble x16 = x14 * t13;
+    const ivarp::IDouble t14 = x2 + x11;
+    const ivarp::IDouble t15 = x13 * t14;
+    const ivarp::IDouble t16 = cos_half_alpha + t15;
+    const ivarp::IDouble remaining_triangle_half_base = x14 * t16;
+    const ivarp::IDouble remaining_triangle_height = remaining_triangle_half_base / tan_half_alpha;
+    const ivarp::IDouble t17 = 1.0 - sin_half_alpha;
+    const ivarp::IDouble remaining_pocket_width = x16 * t17;
+    const ivarp::IDouble t18 = sin_half_alpha * x8;
+    const ivarp::IDouble t19 = x9 * x15;
+    const ivarp::IDouble t20 = t18 - t19;
+    const ivarp::IDouble t21 = t20 - x15;
+    const ivarp::IDouble t22 = x8 + t21;
+    const ivarp::IDouble t23 = ivarp::sqrt(t22);
+    const ivarp::IDouble t24 = x2 - t23;
+    const ivarp::IDouble t25 = x3 * t24;
+    const ivarp::IDouble t26 = 0.5 * t25;
+    const ivarp::IDouble t27 = x13 * x16;
+    const ivarp::IDouble t28 = -t27;
+    const ivarp::IDouble remaining_pocket_height = (ivarp::max)(t26, t28);
+    return ::R1InCenterRemainingSizes{r1_squared, remaining_triangle_half_base, remaining_triangle_height, remaining_pocket_width, remaining_pocket_height};
+}
+}
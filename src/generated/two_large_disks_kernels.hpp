@@ -0,0 +1,83 @@
+// Generated by generate_kernels.py from two_large_disks.kernels; do not edit.
+
+#pragma once
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <cstddef>
+#include <tuple>
+
+/**
+ * The argument of the square root in the top intersections; r_1 meets the top edge iff it is non-negative.
+ */
+inline ivarp::IDouble two_large_disks_top_discriminant(ivarp::IDouble r1sq, ivarp::IDouble r1hsq, ivarp::IDouble r1wsq, ivarp::IDouble r1w, ivarp::IDouble r1h, ivarp::IDouble tan_half_alpha) noexcept {
+    const ivarp::IDouble x3 = 2.0 * r1h;
+    const ivarp::IDouble x5 = ivarp::mul_nonneg(r1w, tan_half_alpha);
+    const ivarp::IDouble x6 = ivarp::square(tan_half_alpha);
+    const ivarp::IDouble t1 = ivarp::fma(r1wsq, x6, r1hsq);
+    const ivarp::IDouble t3 = ivarp::fma(r1sq, x6, -t1);
+    const ivarp::IDouble t4 = r1sq + t3;
+    const ivarp::IDouble t6 = ivarp::fma(-x3, x5, t4);
+    const ivarp::IDouble t7 = x3 + t6;
+    const ivarp::IDouble t9 = ivarp::fma(x5, 2.0, t7);
+    const ivarp::IDouble value = t9 - 1.0;
+    return value;
+}
+
+struct TwoLargeDisksTopIntersections {
+    ivarp::IDouble right_x_u;
+    ivarp::IDouble left_x_u;
+};
+
+/**
+ * The x-coordinates of the intersections of r_1 with the top edge, given the non-negative discriminant.
+ */
+inline TwoLargeDisksTopIntersections two_large_disks_top_intersections(ivarp::IDouble alpha, ivarp::IDouble r1w, ivarp::IDouble r1h, ivarp::IDouble tan_half_alpha, ivarp::IDouble discriminant) noexcept {
+    const ivarp::IDouble x0 = 0.5 * alpha;
+    const ivarp::IDouble t0 = ivarp::cos(x0);
+    const ivarp::IDouble x1 = ivarp::square(t0);
+    const ivarp::IDouble x7 = ivarp::sqrt(discriminant);
+    const ivarp::IDouble t2 = ivarp::fma(-r1h, tan_half_alpha, r1w);
+    const ivarp::IDouble x8 = tan_half_alpha + t2;
+    const ivarp::IDouble t3 = x8 - x7;
+    const ivarp::IDouble right_x_u = x1 * t3;
+    const ivarp::IDouble t4 = x7 + x8;
+    const ivarp::IDouble left_x_u = ivarp::mul_nonneg(x1, t4);
+    return TwoLargeDisksTopIntersections{right_x_u, left_x_u};
+}
+
+namespace reference_kernels {
+/// two_large_disks_top_discriminant as plain interval operations in the order of the expression file.
+inline ivarp::IDouble two_large_disks_top_discriminant(ivarp::IDouble r1sq, ivarp::IDouble r1hsq, ivarp::IDouble r1wsq, ivarp::IDouble r1w, ivarp::IDouble r1h, ivarp::IDouble tan_half_alpha) noexcept {
+    const ivarp::IDouble x3 = 2.0 * r1h;
+    const ivarp::IDouble x5 = r1w * tan_half_alpha;
+    const ivarp::IDouble x6 = ivarp::square(tan_half_alpha);
+    const ivarp::IDouble t0 = r1wsq * x6;
+    const ivarp::IDouble t1 = r1hsq + t0;
+    const ivarp::IDouble t2 = r1sq * x6;
+    const ivarp::IDouble t3 = t2 - t1;
+    const ivarp::IDouble t4 = r1sq + t3;
+    const ivarp::IDouble t5 = x3 * x5;
+    const ivarp::IDouble t6 = t4 - t5;
+    const ivarp::IDouble t7 = x3 + t6;
+    const ivarp::IDouble t8 = 2.0 * x5;
+    const ivarp::IDouble t9 = t7 + t8;
+    const ivarp::IDouble value = t9 - 1.0;
+    return value;
+}
+
+/// two_large_disks_top_intersections as plain interval operations in the order of the expression file.
+inline ::TwoLargeDisksTopIntersections two_large_disks_top_intersections(ivarp::IDouble alpha, ivarp::IDouble r1w, ivarp::IDouble r1h, ivarp::IDouble tan_half_alpha, ivarp::IDouble discriminant) noexcept {
+    const ivarp::IDouble x0 = 0.5 * alpha;
+    const ivarp::IDouble t0 = ivarp::cos(x0);
+    const ivarp::IDouble x1 = ivarp::square(t0);
+    const ivarp::IDouble x7 = ivarp::sqrt(discriminant);
+    const ivarp::IDouble t1 = r1h * tan_half_alpha;
+    const ivarp::IDouble t2 = r1w - t1;
+    const ivarp::IDouble x8 = tan_half_alpha + t2;
+    const ivarp::IDouble t3 = x8 - x7;
+    const ivarp::IDouble right_x_u = x1 * t3;
+    const ivarp::IDouble t4 = x7 + x8;
+    const ivarp::IDouble left_x_u = x1 * t4;
+    return ::TwoLargeDisksTopIntersections{right_x_u, left_x_u};
+}
+}
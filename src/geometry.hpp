@@ -103,9 +103,10 @@ inline IntersectionResult line_circle_intersection(Point anchor, Point orientati
     IDouble x7 = c_x * d_x;
     IDouble x8 = 2.0 * x7;
     IDouble x9 = square(r);
-    IDouble x10sq = -square(a_x) * x1 + 2*a_x*c_x*x1 - square(a_y)*x0 + 2*a_y*c_y*x0 -
-                    square(c_x)*x1 - square(c_y)*x0 +
-                    x0*x9 + x1*x9 + x3*x5 - x3*x8 - x5*x6 + x6*x8;
+    const IDouble x10sq_lhs[] = {-square(a_x), 2*a_x*c_x, -square(a_y), 2*a_y*c_y,
+                                 -square(c_x), -square(c_y), x0, x1, x3, -x3, -x5, x6};
+    const IDouble x10sq_rhs[] = {x1, x1, x0, x0, x1, x0, x9, x9, x5, x8, x6, x8};
+    IDouble x10sq = ivarp::dot(x10sq_lhs, x10sq_rhs);
     IBool x10sqnonneg = (x10sq >= 0);
     if(!possibly(x10sqnonneg)) {
         return result;
@@ -116,9 +117,9 @@ inline IntersectionResult line_circle_intersection(Point anchor, Point orientati
     result.exists = or_exists && x10sqnonneg;
     IDouble mu_first = x2 * (x11 - x10);
     IDouble mu_second = x2 * (x10 + x11);
-    result.first_on_line.x = a_x + mu_first * d_x;
-    result.first_on_line.y = a_y + mu_first * d_y;
-    result.second_on_line.x = a_x + mu_second * d_x;
-    result.second_on_line.y = a_y + mu_second * d_y;
+    result.first_on_line.x = fma(mu_first, d_x, a_x);
+    result.first_on_line.y = fma(mu_first, d_y, a_y);
+    result.second_on_line.x = fma(mu_second, d_x, a_x);
+    result.second_on_line.y = fma(mu_second, d_y, a_y);
     return result;
 }
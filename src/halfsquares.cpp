@@ -25,6 +25,8 @@
 #include <sstream>
 #include "basic_variable_set.hpp"
 #include "prover.hpp"
+#include "trace_registry.hpp"
+#include "corpus_replay.hpp"
 #include "rectangle_cover.hpp"
 
 using IDouble = ivarp::IDouble;
@@ -120,13 +122,18 @@ std::ostream& operator<<(std::ostream& out, const HalfsquaresVariablesCase3& var
 	return out;
 }
 
+static void setup_halfsquares_case3(Prover<HalfsquaresVariablesCase3>& prover_halfsquares3) {
+    prover_halfsquares3.set_name("halfsquares_case3");
+    prover_halfsquares3.emplace_constraint<HalfsquaresCase3WeightInsufficient>();
+    prover_halfsquares3.abort_on_satisfiable();
+    prover_halfsquares3.abort_at_height(100);
+}
+
 bool proof_halfsquares_case3() {
     Prover<HalfsquaresVariablesCase3> prover_halfsquares3;
+    setup_halfsquares_case3(prover_halfsquares3);
     HalfsquaresVariablesCase3 variables;
     prover_halfsquares3.add_variable_set(variables);
-    prover_halfsquares3.emplace_constraint<HalfsquaresCase3WeightInsufficient>();
-    prover_halfsquares3.abort_on_satisfiable();
-    prover_halfsquares3.abort_at_height(100);
     return prover_halfsquares3.prove();
 }
 
@@ -138,3 +145,11 @@ bool proof_halfsquares() {
 	return true;
 }
 
+
+void register_halfsquares_trace_renderers() {
+    register_trace_renderer<HalfsquaresVariablesCase3>("halfsquares_case3");
+}
+
+void register_halfsquares_corpus_replayers() {
+    register_corpus_replayer<HalfsquaresVariablesCase3>("halfsquares_case3", &setup_halfsquares_case3);
+}
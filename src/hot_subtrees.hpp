@@ -0,0 +1,121 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "proof_stats.hpp"
+
+/**
+ * Process-wide options for the hot-subtree report; if depth is non-zero,
+ * each prover counts the nodes below each box at that depth and
+ * prints the top_k boxes with the most nodes after the proof.
+ */
+struct HotSubtreeOptions {
+    std::uint64_t depth = 0;
+    std::size_t top_k = 10;
+};
+
+inline HotSubtreeOptions& default_hot_subtree_options() noexcept {
+    static HotSubtreeOptions options;
+    return options;
+}
+
+/**
+ * A subtree of the search tree, rooted at a box of the configured depth
+ * (or deeper, for initial boxes that are already below that depth).
+ */
+template<typename VariableSet> struct HotSubtree {
+    VariableSet domain;
+    std::uint64_t depth;
+    std::uint64_t nodes = 0;
+    std::uint64_t undecided = 0;           //< satisfiable or undecided leaves
+    std::vector<std::uint64_t> decided_by; //< leaves refuted or emptied, per constraint
+
+    explicit HotSubtree(const VariableSet& domain, std::uint64_t depth, std::size_t num_constraints) :
+        domain(domain), depth(depth), decided_by(num_constraints, 0)
+    {}
+};
+
+/**
+ * Order the subtrees by descending node count and keep the first top_k.
+ */
+template<typename VariableSet>
+    std::vector<HotSubtree<VariableSet>> select_hottest_subtrees(std::vector<HotSubtree<VariableSet>> subtrees,
+                                                                 std::size_t top_k)
+{
+    std::size_t k = (std::min)(top_k, subtrees.size());
+    std::partial_sort(subtrees.begin(), subtrees.begin() + k, subtrees.end(),
+                      [] (const HotSubtree<VariableSet>& a, const HotSubtree<VariableSet>& b) {
+                          return a.nodes > b.nodes;
+                      });
+    subtrees.erase(subtrees.begin() + k, subtrees.end());
+    return subtrees;
+}
+
+template<typename VariableSet>
+    void print_hot_subtrees(std::ostream& output, const std::vector<HotSubtree<VariableSet>>& hottest,
+                            std::size_t num_subtrees, std::uint64_t depth, const ProofStats& stats)
+{
+    std::ios_base::fmtflags flags = output.flags();
+    std::streamsize precision = output.precision();
+    output << std::fixed << std::setprecision(2);
+    std::uint64_t covered = 0;
+    for(const auto& s : hottest) {
+        covered += s.nodes;
+    }
+    double total = double((std::max)(stats.nodes, std::uint64_t(1)));
+    output << "Hottest " << hottest.size() << " of " << num_subtrees << " subtrees at depth " << depth
+           << " (" << 100.0 * double(covered) / total << "% of " << stats.nodes << " nodes):\n";
+    for(std::size_t i = 0; i < hottest.size(); ++i) {
+        const HotSubtree<VariableSet>& s = hottest[i];
+        output << '#' << (i + 1) << ": " << s.nodes << " nodes (" << 100.0 * double(s.nodes) / total
+               << "%), depth " << s.depth << ", leaves decided by";
+        // constraints in descending order of the number of leaves they decided
+        std::vector<std::size_t> order;
+        for(std::size_t c = 0; c < s.decided_by.size(); ++c) {
+            if(s.decided_by[c] != 0) {
+                order.push_back(c);
+            }
+        }
+        std::sort(order.begin(), order.end(), [&] (std::size_t a, std::size_t b) {
+            return s.decided_by[a] > s.decided_by[b];
+        });
+        for(std::size_t c : order) {
+            output << (c == order.front() ? " " : ", ") << '\'' << stats.constraints[c].name << "' ("
+                   << s.decided_by[c] << ')';
+        }
+        if(order.empty()) {
+            output << " none";
+        }
+        if(s.undecided) {
+            output << ", " << s.undecided << " undecided leaves";
+        }
+        // the variable set is printed in the format of the caller
+        output.flags(flags);
+        output.precision(precision);
+        output << '\n' << s.domain << '\n';
+        output << std::fixed << std::setprecision(2);
+    }
+    output.flags(flags);
+    output.precision(precision);
+}
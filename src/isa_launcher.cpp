@@ -0,0 +1,139 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ivarp_ia/isa.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <sys/wait.h>
+
+/*
+ * triangle_cover_by_disks is built once per instruction set level (triangle_cover_by_disks_<level>,
+ * next to this launcher). The launcher is compiled for the baseline instruction set; it selects
+ * the highest level supported by the CPU for which a build exists, up to avx2, runs the self-test
+ * of that build (falling back to lower levels if it fails) and then replaces itself by that build.
+ * The avx512 build is only used if requested: although its interval kernels are faster in
+ * isolation, it ran the below-45 proof slower than the avx2 build (251s vs. 187s).
+ * The level can be forced with --isa LEVEL or the environment variable IVARP_IA_ISA;
+ * "auto" selects the level automatically.
+ */
+
+/**
+ * The highest instruction set level selected automatically.
+ */
+static constexpr ivarp::ISALevel automatic_isa_limit = ivarp::ISALevel::AVX2;
+
+static std::string launcher_directory() {
+    std::vector<char> buffer(4096);
+    ssize_t length = ::readlink("/proc/self/exe", buffer.data(), buffer.size() - 1);
+    if(length <= 0) {
+        return ".";
+    }
+    std::string path(buffer.data(), std::size_t(length));
+    std::size_t slash = path.rfind('/');
+    return slash == std::string::npos ? std::string(".") : path.substr(0, slash);
+}
+
+static std::string build_path(const std::string& directory, ivarp::ISALevel level) {
+    return directory + "/triangle_cover_by_disks_" + ivarp::isa_level_name(level);
+}
+
+/**
+ * Run the self-test of the given build in a child process; a build
+ * that crashes (e.g., with an illegal instruction) fails the test.
+ */
+static bool run_self_test(const std::string& path) {
+    pid_t pid = ::fork();
+    if(pid < 0) {
+        std::cerr << "Could not fork: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if(pid == 0) {
+        const char* args[] = {path.c_str(), "--isa-self-test", nullptr};
+        ::execv(path.c_str(), const_cast<char* const*>(args));
+        std::_Exit(127);
+    }
+    int status;
+    while(::waitpid(pid, &status, 0) < 0) {
+        if(errno != EINTR) {
+            return false;
+        }
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char** argv) {
+    const char* requested = std::getenv("IVARP_IA_ISA");
+    std::vector<char*> forwarded;
+    for(int i = 0; i < argc; ++i) {
+        if(i > 0 && std::strcmp(argv[i], "--isa") == 0 && i + 1 < argc) {
+            requested = argv[++i];
+        } else {
+            forwarded.push_back(argv[i]);
+        }
+    }
+    forwarded.push_back(nullptr);
+
+    ivarp::ISALevel supported = ivarp::supported_isa_level();
+    std::vector<ivarp::ISALevel> candidates;
+    if(requested && *requested && std::strcmp(requested, "auto") != 0) {
+        ivarp::ISALevel level;
+        if(!ivarp::parse_isa_level(requested, level)) {
+            std::cerr << "Unknown instruction set level '" << requested << "' (expected auto, sse42, avx2 or avx512)" << std::endl;
+            return 2;
+        }
+        if(static_cast<int>(level) > static_cast<int>(supported)) {
+            std::cerr << "Instruction set level " << ivarp::isa_level_name(level) << " is not supported by this CPU "
+                      << "(the highest supported level is " << ivarp::isa_level_name(supported) << ")" << std::endl;
+            return 2;
+        }
+        candidates.push_back(level);
+    } else {
+        int highest = (std::min)(static_cast<int>(supported), static_cast<int>(automatic_isa_limit));
+        for(int l = highest; l >= 0; --l) {
+            candidates.push_back(static_cast<ivarp::ISALevel>(l));
+        }
+    }
+
+    std::string directory = launcher_directory();
+    for(ivarp::ISALevel level : candidates) {
+        std::string path = build_path(directory, level);
+        if(::access(path.c_str(), X_OK) != 0) {
+            continue;
+        }
+        if(!run_self_test(path)) {
+            std::cerr << "Self-test of " << path << " failed";
+            if(candidates.size() > 1) {
+                std::cerr << ", trying the next lower instruction set level";
+            }
+            std::cerr << std::endl;
+            continue;
+        }
+        forwarded[0] = const_cast<char*>(path.c_str());
+        ::execv(path.c_str(), forwarded.data());
+        std::cerr << "Could not execute " << path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    std::cerr << "No usable build of triangle_cover_by_disks found in " << directory << std::endl;
+    return 1;
+}
@@ -0,0 +1,820 @@
+#!/usr/bin/env python3
+# Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+#
+#Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+#and associated documentation files (the "Software"), to deal in the Software without restriction,
+#including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+#and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+#subject to the following conditions:
+#
+#The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+#
+#THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+#OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+#LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+"""
+Generate interval kernels (C++ functions on ivarp::IDouble) from expression files.
+
+An expression file contains kernels in the syntax of sympy.cse output:
+
+    # Doc comment of the kernel (comment lines directly above 'kernel').
+    kernel name
+        input alpha [0.76, 0.79]        # argument; the range is only a hint
+        x0 = 8*r1**2                    # common subexpression
+        output value = -2*r1*x0/x6      # result; several outputs give a struct
+        derivative r1                   # also emit name_with_derivatives (forward mode)
+        batch                           # also emit an overload on arrays
+
+Expressions are exact: numbers are rationals, and constants that are not doubles
+are enclosed at runtime. The generator merges common subexpressions, simplifies, and selects
+interval kernels: fused multiply-adds for products used once in sums, sincos for sine and
+cosine of the same argument, and mul_nonneg/div_pos where the input ranges fix the signs
+of the operands (these kernels are correct for all operands, so the ranges cannot make the
+result wrong, only slower). Each kernel is also emitted unoptimized in namespace reference_kernels.
+
+The generated headers are checked in as src/generated/<name>_kernels.hpp; with --check,
+nothing is written and the exit status is 1 if OUTPUT.hpp differs from the generator output
+(the build runs this check for each expression file).
+
+Usage: generate_kernels.py [--check] INPUT.kernels OUTPUT.hpp
+"""
+
+import ast
+import math
+import os
+import re
+import sys
+from fractions import Fraction
+
+
+class KernelError(Exception):
+    pass
+
+
+class Range:
+    """Approximate range of a subexpression; only used to select kernels."""
+
+    def __init__(self, lo, hi):
+        self.lo = lo
+        self.hi = hi
+
+    @staticmethod
+    def everything():
+        return Range(-math.inf, math.inf)
+
+    def padded(self):
+        def pad(x, d):
+            if math.isinf(x) or math.isnan(x):
+                return x
+            return x + d * (abs(x) * 1e-9 + 1e-300)
+        if math.isnan(self.lo) or math.isnan(self.hi):
+            return Range.everything()
+        return Range(pad(self.lo, -1), pad(self.hi, 1))
+
+    def nonneg(self):
+        return self.lo >= 0.0
+
+    def nonpos(self):
+        return self.hi <= 0.0
+
+    def positive(self):
+        return self.lo > 0.0
+
+    def negative(self):
+        return self.hi < 0.0
+
+
+def _products(a, b):
+    result = []
+    for x in (a.lo, a.hi):
+        for y in (b.lo, b.hi):
+            p = x * y
+            result.append(0.0 if math.isnan(p) else p)
+    return result
+
+
+def children_of(kind, args):
+    if kind in ('const', 'input'):
+        return ()
+    if kind == 'pow':
+        return args[:1]
+    return args
+
+
+def range_of(kind, args, ranges):
+    if kind == 'const':
+        return Range(float(args[0]), float(args[0])).padded()
+    if kind == 'input':
+        return ranges['input', args[0]]
+    r = [ranges[a] for a in children_of(kind, args)]
+    if kind == 'add':
+        return Range(r[0].lo + r[1].lo, r[0].hi + r[1].hi).padded()
+    if kind == 'sub':
+        return Range(r[0].lo - r[1].hi, r[0].hi - r[1].lo).padded()
+    if kind == 'neg':
+        return Range(-r[0].hi, -r[0].lo)
+    if kind == 'mul':
+        p = _products(r[0], r[1])
+        return Range(min(p), max(p)).padded()
+    if kind == 'div':
+        if r[1].lo <= 0.0 <= r[1].hi:
+            return Range.everything()
+        q = _products(r[0], Range(1.0 / r[1].hi, 1.0 / r[1].lo))
+        return Range(min(q), max(q)).padded()
+    if kind == 'pow':
+        n = args[1]
+        vals = [x ** n for x in (r[0].lo, r[0].hi) if not math.isinf(x)]
+        if len(vals) < 2:
+            return Range.everything() if n % 2 else Range(0.0, math.inf)
+        lo, hi = min(vals), max(vals)
+        if n % 2 == 0 and r[0].lo < 0.0 < r[0].hi:
+            lo = 0.0
+        return Range(lo, hi).padded()
+    if kind == 'sqrt':
+        return Range(math.sqrt(max(r[0].lo, 0.0)), math.sqrt(max(r[0].hi, 0.0))).padded()
+    if kind in ('sin', 'cos'):
+        if math.isinf(r[0].lo) or math.isinf(r[0].hi) or r[0].hi - r[0].lo >= 2 * math.pi:
+            return Range(-1.0, 1.0)
+        f = math.sin if kind == 'sin' else math.cos
+        vals = [f(r[0].lo), f(r[0].hi)]
+        k = math.ceil(r[0].lo / (0.5 * math.pi))
+        while k * 0.5 * math.pi <= r[0].hi:
+            vals.append(f(k * 0.5 * math.pi))
+            k += 1
+        return Range(max(-1.0, min(vals)), min(1.0, max(vals))).padded()
+    if kind == 'tan':
+        if r[0].lo <= -0.5 * math.pi or r[0].hi >= 0.5 * math.pi:
+            return Range.everything()
+        return Range(math.tan(r[0].lo), math.tan(r[0].hi)).padded()
+    if kind == 'max':
+        return Range(max(r[0].lo, r[1].lo), max(r[0].hi, r[1].hi))
+    if kind == 'min':
+        return Range(min(r[0].lo, r[1].lo), min(r[0].hi, r[1].hi))
+    raise KernelError("unknown node kind " + kind)
+
+
+def is_double(value):
+    """Whether the rational value is exactly a (normal, finite) double."""
+    try:
+        return Fraction(float(value)) == value
+    except OverflowError:
+        return False
+
+
+def double_literal(value):
+    text = repr(float(value))
+    if 'e' not in text and '.' not in text:
+        text += '.0'
+    return text
+
+
+class Graph:
+    """Expression DAG with hash-consing; equal subexpressions are represented by the same node."""
+
+    COMMUTATIVE = ('add', 'mul', 'max', 'min')
+
+    def __init__(self, input_ranges):
+        self.nodes = []
+        self.index = {}
+        self.ranges = {('input', name): r for name, r in input_ranges.items()}
+
+    def kind(self, n):
+        return self.nodes[n][0]
+
+    def args(self, n):
+        return self.nodes[n][1]
+
+    def children(self, n):
+        return children_of(*self.nodes[n])
+
+    def const_value(self, n):
+        return self.args(n)[0] if self.kind(n) == 'const' else None
+
+    def range(self, n):
+        return self.ranges[n]
+
+    def intern(self, kind, *args):
+        if kind in Graph.COMMUTATIVE:
+            args = tuple(sorted(args))
+        key = (kind, args)
+        n = self.index.get(key)
+        if n is None:
+            n = len(self.nodes)
+            self.nodes.append(key)
+            self.index[key] = n
+            self.ranges[n] = range_of(kind, args, self.ranges)
+        return n
+
+    def const(self, value):
+        return self.intern('const', Fraction(value))
+
+    def input(self, name):
+        return self.intern('input', name)
+
+    def add(self, a, b):
+        ca, cb = self.const_value(a), self.const_value(b)
+        if ca is not None and cb is not None:
+            return self.const(ca + cb)
+        if ca == 0:
+            return b
+        if cb == 0:
+            return a
+        if self.kind(b) == 'neg':
+            return self.sub(a, self.args(b)[0])
+        if self.kind(a) == 'neg':
+            return self.sub(b, self.args(a)[0])
+        if cb is not None and cb < 0:
+            return self.sub(a, self.const(-cb))
+        if ca is not None and ca < 0:
+            return self.sub(b, self.const(-ca))
+        return self.intern('add', a, b)
+
+    def sub(self, a, b):
+        ca, cb = self.const_value(a), self.const_value(b)
+        if ca is not None and cb is not None:
+            return self.const(ca - cb)
+        if cb == 0:
+            return a
+        if ca == 0:
+            return self.neg(b)
+        if a == b:
+            return self.const(0)
+        if self.kind(b) == 'neg':
+            return self.add(a, self.args(b)[0])
+        if cb is not None and cb < 0:
+            return self.add(a, self.const(-cb))
+        if self.kind(a) == 'neg':
+            return self.neg(self.add(self.args(a)[0], b))
+        return self.intern('sub', a, b)
+
+    def neg(self, a):
+        ca = self.const_value(a)
+        if ca is not None:
+            return self.const(-ca)
+        if self.kind(a) == 'neg':
+            return self.args(a)[0]
+        if self.kind(a) == 'sub':
+            x, y = self.args(a)
+            return self.sub(y, x)
+        return self.intern('neg', a)
+
+    def mul(self, a, b):
+        ca, cb = self.const_value(a), self.const_value(b)
+        if ca is not None and cb is not None:
+            return self.const(ca * cb)
+        if cb is not None:
+            a, b, ca, cb = b, a, cb, ca
+        if ca is not None:
+            if ca == 0:
+                return self.const(0)
+            if ca == 1:
+                return b
+            if ca == -1:
+                return self.neg(b)
+            if ca < 0:
+                return self.neg(self.mul(self.const(-ca), b))
+            if self.kind(b) == 'neg':
+                return self.neg(self.mul(a, self.args(b)[0]))
+            if self.kind(b) == 'mul':
+                x, y = self.args(b)
+                if self.const_value(y) is not None:
+                    x, y = y, x
+                if self.const_value(x) is not None:
+                    return self.mul(self.const(ca * self.const_value(x)), y)
+            if not is_double(ca):
+                return self.div(self.mul(self.const(ca.numerator), b), self.const(ca.denominator))
+            return self.intern('mul', a, b)
+        if self.kind(a) == 'neg':
+            return self.neg(self.mul(self.args(a)[0], b))
+        if self.kind(b) == 'neg':
+            return self.neg(self.mul(a, self.args(b)[0]))
+        if a == b:
+            return self.pow(a, 2)
+        return self.intern('mul', a, b)
+
+    def div(self, a, b):
+        ca, cb = self.const_value(a), self.const_value(b)
+        if cb == 0:
+            raise KernelError("division by zero")
+        if ca is not None and cb is not None:
+            return self.const(ca / cb)
+        if cb is not None:
+            if is_double(1 / cb):
+                return self.mul(self.const(1 / cb), a)
+            if cb < 0:
+                return self.neg(self.div(a, self.const(-cb)))
+        if self.kind(a) == 'neg':
+            return self.neg(self.div(self.args(a)[0], b))
+        if self.kind(b) == 'neg':
+            return self.neg(self.div(a, self.args(b)[0]))
+        if ca == 0:
+            return self.const(0)
+        if ca is not None and ca < 0:
+            return self.neg(self.div(self.const(-ca), b))
+        return self.intern('div', a, b)
+
+    def pow(self, a, n):
+        ca = self.const_value(a)
+        if n == Fraction(1, 2):
+            return self.sqrt(a)
+        if n.denominator != 1:
+            raise KernelError("only integer powers and square roots are supported")
+        n = int(n)
+        if ca is not None and (n >= 0 or ca != 0):
+            return self.const(ca ** n)
+        if n == 0:
+            return self.const(1)
+        if n == 1:
+            return a
+        if n < 0:
+            return self.div(self.const(1), self.pow(a, Fraction(-n)))
+        if self.kind(a) == 'neg':
+            p = self.pow(self.args(a)[0], Fraction(n))
+            return p if n % 2 == 0 else self.neg(p)
+        return self.intern('pow', a, n)
+
+    def sqrt(self, a):
+        return self.intern('sqrt', a)
+
+    def call(self, name, args):
+        if name in ('sin', 'cos', 'tan', 'sqrt'):
+            if len(args) != 1:
+                raise KernelError(name + " takes one argument")
+            if name == 'sqrt':
+                return self.sqrt(args[0])
+            return self.intern(name, args[0])
+        if name in ('max', 'min', 'Max', 'Min'):
+            if len(args) != 2:
+                raise KernelError(name + " takes two arguments")
+            return self.intern(name.lower(), args[0], args[1])
+        raise KernelError("unknown function " + name)
+
+    def derivative(self, n, var, memo):
+        """Forward-mode derivative of node n with respect to the input var."""
+        if n in memo:
+            return memo[n]
+        kind, args = self.nodes[n]
+        zero = self.const(0)
+        if kind == 'const':
+            d = zero
+        elif kind == 'input':
+            d = self.const(1 if args[0] == var else 0)
+        elif kind in ('add', 'sub'):
+            da, db = self.derivative(args[0], var, memo), self.derivative(args[1], var, memo)
+            d = self.add(da, db) if kind == 'add' else self.sub(da, db)
+        elif kind == 'neg':
+            d = self.neg(self.derivative(args[0], var, memo))
+        elif kind == 'mul':
+            a, b = args
+            da, db = self.derivative(a, var, memo), self.derivative(b, var, memo)
+            d = self.add(self.mul(da, b), self.mul(a, db))
+        elif kind == 'div':
+            a, b = args
+            da, db = self.derivative(a, var, memo), self.derivative(b, var, memo)
+            d = self.div(self.sub(da, self.mul(n, db)), b)
+        elif kind == 'pow':
+            a, k = args
+            da = self.derivative(a, var, memo)
+            d = self.mul(self.mul(self.const(k), self.pow(a, Fraction(k - 1))), da)
+        elif kind == 'sqrt':
+            da = self.derivative(args[0], var, memo)
+            d = self.mul(self.const(Fraction(1, 2)), self.div(da, n))
+        elif kind == 'sin':
+            d = self.mul(self.intern('cos', args[0]), self.derivative(args[0], var, memo))
+        elif kind == 'cos':
+            d = self.neg(self.mul(self.intern('sin', args[0]), self.derivative(args[0], var, memo)))
+        elif kind == 'tan':
+            d = self.mul(self.add(self.const(1), self.pow(n, Fraction(2))), self.derivative(args[0], var, memo))
+        else:
+            da, db = self.derivative(args[0], var, memo), self.derivative(args[1], var, memo)
+            if da != zero or db != zero:
+                raise KernelError(kind + " is not differentiable")
+            d = zero
+        memo[n] = d
+        return d
+
+
+class Kernel:
+    def __init__(self, name, doc):
+        self.name = name
+        self.doc = doc
+        self.inputs = []
+        self.input_ranges = {}
+        self.statements = []
+        self.derivatives = []
+        self.batch = False
+        self.result_name = None
+
+
+def parse_range(text, line_no):
+    m = re.fullmatch(r'\[\s*([^,\]]+)\s*,\s*([^\]]+)\s*\]', text.strip())
+    if not m:
+        raise KernelError("line {}: expected a range [lb, ub]".format(line_no))
+    return Range(float(Fraction(m.group(1).strip())), float(Fraction(m.group(2).strip())))
+
+
+def parse_file(path):
+    kernels = []
+    doc = []
+    current = None
+    with open(path) as f:
+        for line_no, raw in enumerate(f, 1):
+            line = raw.split('#', 1)[0].strip()
+            comment = raw.strip()[1:].strip() if raw.strip().startswith('#') else None
+            if not line:
+                if comment is not None:
+                    doc.append(comment)
+                else:
+                    doc = []
+                continue
+            words = line.split(None, 1)
+            if words[0] == 'kernel':
+                current = Kernel(words[1].strip(), doc)
+                kernels.append(current)
+            elif current is None:
+                raise KernelError("line {}: statement outside of a kernel".format(line_no))
+            elif words[0] == 'input':
+                name, _, rng = words[1].partition(' ')
+                current.inputs.append(name)
+                current.input_ranges[name] = parse_range(rng, line_no) if rng.strip() else Range.everything()
+            elif words[0] == 'derivative':
+                current.derivatives.extend(w.strip() for w in words[1].split(','))
+            elif words[0] == 'batch':
+                current.batch = True
+            elif words[0] == 'result':
+                current.result_name = words[1].strip()
+            elif words[0] == 'output':
+                name, _, expr = words[1].partition('=')
+                current.statements.append(('output', name.strip(), expr.strip(), line_no))
+            else:
+                name, eq, expr = line.partition('=')
+                if not eq:
+                    raise KernelError("line {}: expected 'name = expression'".format(line_no))
+                current.statements.append(('let', name.strip(), expr.strip(), line_no))
+            doc = []
+    return kernels
+
+
+def build(graph, expr, env, line_no):
+    def visit(node):
+        if isinstance(node, ast.Expression):
+            return visit(node.body)
+        if isinstance(node, ast.Constant) and isinstance(node.value, (int, float)):
+            return graph.const(Fraction(str(node.value)))
+        if isinstance(node, ast.Name):
+            if node.id not in env:
+                raise KernelError("line {}: unknown name {}".format(line_no, node.id))
+            return env[node.id]
+        if isinstance(node, ast.UnaryOp) and isinstance(node.op, (ast.USub, ast.UAdd)):
+            x = visit(node.operand)
+            return graph.neg(x) if isinstance(node.op, ast.USub) else x
+        if isinstance(node, ast.BinOp):
+            if isinstance(node.op, ast.Pow):
+                exponent = graph.const_value(visit(node.right))
+                if exponent is None:
+                    raise KernelError("line {}: exponents must be constant".format(line_no))
+                return graph.pow(visit(node.left), exponent)
+            a, b = visit(node.left), visit(node.right)
+            ops = {ast.Add: graph.add, ast.Sub: graph.sub, ast.Mult: graph.mul, ast.Div: graph.div}
+            for op_type, op in ops.items():
+                if isinstance(node.op, op_type):
+                    return op(a, b)
+        if isinstance(node, ast.Call) and isinstance(node.func, ast.Name) and not node.keywords:
+            return graph.call(node.func.id, [visit(a) for a in node.args])
+        raise KernelError("line {}: unsupported expression {}".format(line_no, ast.dump(node)))
+
+    try:
+        return visit(ast.parse(expr, mode='eval'))
+    except SyntaxError as e:
+        raise KernelError("line {}: {}".format(line_no, e))
+
+
+class Emitter:
+    """Emit the body of one kernel variant: one local per node, in topological order."""
+
+    def __init__(self, graph, names, roots, optimize):
+        self.graph = graph
+        self.optimize = optimize
+        self.lines = []
+        self.names = {}
+        self.fused = set()
+        used = set(names.values())
+        reachable = set()
+        stack = list(roots)
+        uses = {}
+        while stack:
+            n = stack.pop()
+            if n in reachable:
+                continue
+            reachable.add(n)
+            for a in graph.children(n):
+                uses[a] = uses.get(a, 0) + 1
+                stack.append(a)
+        for r in roots:
+            uses[r] = uses.get(r, 0) + 2
+        self.order = sorted(reachable)
+        counter = 0
+        for n in self.order:
+            if graph.kind(n) == 'input':
+                self.names[n] = graph.args(n)[0]
+            elif graph.kind(n) != 'const':
+                if n in names:
+                    self.names[n] = names[n]
+                else:
+                    while 't{}'.format(counter) in used:
+                        counter += 1
+                    self.names[n] = 't{}'.format(counter)
+                    counter += 1
+        if optimize:
+            for n in self.order:
+                if graph.kind(n) in ('add', 'sub'):
+                    for a in graph.args(n):
+                        if graph.kind(a) == 'mul' and uses.get(a, 0) == 1 and a not in self.fused:
+                            self.fused.add(a)
+                            break
+        self.negated = set()
+        if optimize:
+            for n in self.order:
+                if graph.kind(n) == 'neg':
+                    a = graph.args(n)[0]
+                    if graph.kind(a) in ('mul', 'div') and uses.get(a, 0) == 1 and a not in self.fused:
+                        self.negated.add(a)
+        self.sincos = {}
+        if optimize:
+            for n in self.order:
+                if graph.kind(n) == 'sin':
+                    c = graph.index.get(('cos', graph.args(n)))
+                    if c is not None and c in reachable:
+                        self.sincos[n] = (n, c)
+                        self.sincos[c] = (n, c)
+
+    def ref(self, n):
+        c = self.graph.const_value(n)
+        if c is not None:
+            if is_double(c):
+                return 'ivarp::IDouble({})'.format(double_literal(c))
+            return '(ivarp::IDouble({}) / {})'.format(double_literal(c.numerator), double_literal(c.denominator))
+        return self.names[n]
+
+    def scalar_or_ref(self, n):
+        c = self.graph.const_value(n)
+        if c is not None and is_double(c):
+            return double_literal(c)
+        return self.ref(n)
+
+    def signed(self, n, negate):
+        return '-' + self.ref(n) if negate else self.ref(n)
+
+    def mul_expr(self, a, b):
+        g = self.graph
+        if not self.optimize or g.const_value(a) is not None or g.const_value(b) is not None:
+            if g.const_value(b) is not None:
+                a, b = b, a
+            return '{} * {}'.format(self.scalar_or_ref(a), self.ref(b))
+        ra, rb = g.range(a), g.range(b)
+        if (ra.nonneg() or ra.nonpos()) and (rb.nonneg() or rb.nonpos()):
+            na, nb = not ra.nonneg(), not rb.nonneg()
+            e = 'ivarp::mul_nonneg({}, {})'.format(self.signed(a, na), self.signed(b, nb))
+            return '-' + e if na != nb else e
+        return '{} * {}'.format(self.ref(a), self.ref(b))
+
+    def div_expr(self, a, b):
+        g = self.graph
+        rb = g.range(b)
+        if self.optimize and g.const_value(b) is None and (rb.positive() or rb.negative()):
+            e = 'ivarp::div_pos({}, {})'.format(self.ref(a), self.signed(b, rb.negative()))
+            return '-' + e if rb.negative() else e
+        return '{} / {}'.format(self.scalar_or_ref(a), self.scalar_or_ref(b))
+
+    def fma_expr(self, m, z, negate_product):
+        x, y = self.graph.args(m)
+        if self.graph.const_value(x) is not None:
+            x, y = y, x
+        if negate_product:
+            x_text = self.signed(x, True)
+            if self.graph.const_value(y) is not None:
+                y_text, x_text = double_literal(-self.graph.const_value(y)), self.ref(x)
+            else:
+                y_text = self.ref(y)
+        else:
+            x_text, y_text = self.ref(x), self.scalar_or_ref(y)
+        return 'ivarp::fma({}, {}, {})'.format(x_text, y_text, z)
+
+    def expr(self, n):
+        g = self.graph
+        kind, args = g.nodes[n]
+        if kind == 'add':
+            a, b = args
+            for m, other in ((a, b), (b, a)):
+                if m in self.fused:
+                    return self.fma_expr(m, self.ref(other), False)
+            if g.const_value(a) is not None:
+                a, b = b, a
+            return '{} + {}'.format(self.ref(a), self.scalar_or_ref(b))
+        if kind == 'sub':
+            a, b = args
+            if a in self.fused:
+                c = g.const_value(b)
+                z = 'ivarp::IDouble({})'.format(double_literal(-c)) if c is not None and is_double(c) else '-' + self.ref(b)
+                return self.fma_expr(a, z, False)
+            if b in self.fused:
+                return self.fma_expr(b, self.ref(a), True)
+            return '{} - {}'.format(self.scalar_or_ref(a), self.scalar_or_ref(b))
+        if kind == 'neg':
+            if args[0] in self.negated:
+                e = self.expr(args[0])
+                return e[1:] if e.startswith('-') else '-' + e
+            return '-' + self.ref(args[0])
+        if kind == 'mul':
+            return self.mul_expr(*args)
+        if kind == 'div':
+            return self.div_expr(*args)
+        if kind == 'pow':
+            a, k = args
+            if k == 2:
+                return 'ivarp::square({})'.format(self.ref(a))
+            if k == 3:
+                return 'ivarp::cube({})'.format(self.ref(a))
+            return 'ivarp::fixed_pow<{}>({})'.format(k, self.ref(a))
+        if kind in ('max', 'min'):
+            return '(ivarp::{})({}, {})'.format(kind, self.ref(args[0]), self.ref(args[1]))
+        return 'ivarp::{}({})'.format(kind, self.ref(args[0]))
+
+    def emit(self, indent):
+        for n in self.order:
+            kind = self.graph.kind(n)
+            if kind in ('const', 'input') or n in self.fused or n in self.negated:
+                continue
+            if n in self.sincos:
+                s, c = self.sincos[n]
+                if n == min(s, c):
+                    self.lines.append('{}ivarp::IDouble {}, {};'.format(indent, self.names[s], self.names[c]))
+                    self.lines.append('{}std::tie({}, {}) = ivarp::sincos({});'.format(
+                        indent, self.names[s], self.names[c], self.ref(self.graph.args(s)[0])))
+                continue
+            self.lines.append('{}const ivarp::IDouble {} = {};'.format(indent, self.names[n], self.expr(n)))
+        return self.lines
+
+
+def camel_case(name):
+    return ''.join(part.capitalize() for part in name.split('_'))
+
+
+def generate_kernel(kernel, out):
+    graph = Graph(kernel.input_ranges)
+    env = {}
+    names = {}
+    outputs = []
+    for name in kernel.inputs:
+        env[name] = graph.input(name)
+    for kind, name, expr, line_no in kernel.statements:
+        n = build(graph, expr, env, line_no)
+        if kind == 'let':
+            env[name] = n
+            names.setdefault(n, name)
+        else:
+            outputs.append((name, n))
+    if not outputs:
+        raise KernelError("kernel {} has no outputs".format(kernel.name))
+    output_names = {}
+    for name, n in outputs:
+        output_names.setdefault(n, name)
+
+    derivative_outputs = []
+    for var in kernel.derivatives:
+        if var not in kernel.inputs:
+            raise KernelError("kernel {}: derivative for unknown input {}".format(kernel.name, var))
+        memo = {}
+        for name, n in outputs:
+            derivative_outputs.append(('d_{}_d_{}'.format(name, var), graph.derivative(n, var, memo)))
+
+    single = len(outputs) == 1
+    result = kernel.result_name or (camel_case(kernel.name) + 'Result')
+    params = ', '.join('ivarp::IDouble {}'.format(i) for i in kernel.inputs)
+
+    def local_names(all_outputs):
+        merged = dict(names)
+        for name, n in all_outputs:
+            if graph.kind(n) not in ('const', 'input') and n not in output_names:
+                merged.setdefault(n, name)
+        for n, name in output_names.items():
+            if graph.kind(n) not in ('const', 'input'):
+                merged[n] = name
+        return merged
+
+    def body(all_outputs, optimize, struct_name):
+        emitter = Emitter(graph, local_names(all_outputs), [n for _, n in all_outputs], optimize)
+        lines = emitter.emit('    ')
+        if struct_name is None:
+            lines.append('    return {};'.format(emitter.ref(all_outputs[0][1])))
+        else:
+            lines.append('    return {}{{{}}};'.format(struct_name, ', '.join(emitter.ref(n) for _, n in all_outputs)))
+        return lines
+
+    def struct(struct_name, fields):
+        out.append('struct {} {{'.format(struct_name))
+        for name, _ in fields:
+            out.append('    ivarp::IDouble {};'.format(name))
+        out.append('};')
+        out.append('')
+
+    if not single:
+        struct(result, outputs)
+    ret = 'ivarp::IDouble' if single else result
+    if kernel.doc:
+        out.append('/**')
+        out.extend((' * ' + d).rstrip() for d in kernel.doc)
+        out.append(' */')
+    out.append('inline {} {}({}) noexcept {{'.format(ret, kernel.name, params))
+    out.extend(body(outputs, True, None if single else result))
+    out.append('}')
+    out.append('')
+
+    if kernel.batch:
+        in_params = ['const ivarp::IDouble* {}'.format(i) for i in kernel.inputs]
+        out_params = ['ivarp::IDouble* {}'.format(name) for name, _ in outputs]
+        out.append('/// {} for n argument tuples, from the arrays of the arguments to the arrays of the outputs.'
+                   .format(kernel.name))
+        out.append('inline void {}({}, std::size_t n) noexcept {{'.format(kernel.name, ', '.join(in_params + out_params)))
+        out.append('    for(std::size_t i = 0; i < n; ++i) {')
+        call = '{}({})'.format(kernel.name, ', '.join('{}[i]'.format(i) for i in kernel.inputs))
+        if single:
+            out.append('        {}[i] = {};'.format(outputs[0][0], call))
+        else:
+            out.append('        {} r = {};'.format(result, call))
+            for name, _ in outputs:
+                out.append('        {}[i] = r.{};'.format(name, name))
+        out.append('    }')
+        out.append('}')
+        out.append('')
+
+    if derivative_outputs:
+        with_derivatives = camel_case(kernel.name) + 'WithDerivatives'
+        all_outputs = outputs + derivative_outputs
+        struct(with_derivatives, all_outputs)
+        out.append('/// {} and its partial derivatives for {} (forward mode).'.format(
+            kernel.name, ', '.join(kernel.derivatives)))
+        out.append('inline {} {}_with_derivatives({}) noexcept {{'.format(with_derivatives, kernel.name, params))
+        out.extend(body(all_outputs, True, with_derivatives))
+        out.append('}')
+        out.append('')
+
+    reference = []
+    reference.append('/// {} as plain interval operations in the order of the expression file.'.format(kernel.name))
+    reference.append('inline {} {}({}) noexcept {{'.format(ret if single else '::' + result, kernel.name, params))
+    reference.extend(body(outputs, False, None if single else '::' + result))
+    reference.append('}')
+    reference.append('')
+    return reference
+
+
+def generate(input_path, output_path, check=False):
+    """Write the kernels of input_path to output_path unless it is up to date; return whether it was."""
+    kernels = parse_file(input_path)
+    out = ['// Generated by generate_kernels.py from {}; do not edit.'.format(os.path.basename(input_path)), '',
+           '#pragma once', '', '#include <ivarp_ia/ivarp_ia.hpp>', '#include <cstddef>', '#include <tuple>', '']
+    reference = []
+    for kernel in kernels:
+        try:
+            reference.extend(generate_kernel(kernel, out))
+        except KernelError as e:
+            raise KernelError("{}: kernel {}: {}".format(input_path, kernel.name, e))
+    out.append('namespace reference_kernels {')
+    out.extend(reference[:-1])
+    out.append('}')
+    text = '\n'.join(out).rstrip() + '\n'
+    try:
+        with open(output_path) as f:
+            if f.read() == text:
+                return True
+    except OSError:
+        pass
+    if check:
+        return False
+    os.makedirs(os.path.dirname(os.path.abspath(output_path)), exist_ok=True)
+    with open(output_path, 'w') as f:
+        f.write(text)
+    return True
+
+
+def main(argv):
+    check = len(argv) > 1 and argv[1] == '--check'
+    args = argv[2:] if check else argv[1:]
+    if len(args) != 2:
+        sys.stderr.write("Usage: {} [--check] INPUT.kernels OUTPUT.hpp\n".format(argv[0]))
+        return 2
+    try:
+        if not generate(args[0], args[1], check):
+            sys.stderr.write("{} is out of date with {}; regenerate it with: {} {} {}\n".format(
+                args[1], args[0], argv[0], args[0], args[1]))
+            return 1
+    except (KernelError, OSError) as e:
+        sys.stderr.write("{}\n".format(e))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -16,22 +16,259 @@
  */
 
 #include <ivarp_ia/ivarp_ia.hpp>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "progress.hpp"
+#include "binary_trace.hpp"
+#include "box_corpus.hpp"
+#include "perf_counters.hpp"
+#include "timeline.hpp"
+#include "hot_subtrees.hpp"
+#include "sharding.hpp"
+#include "checkpoint.hpp"
+#include "prover_options.hpp"
+#include "proof_registry.hpp"
+#include "below_45_isoceles.hpp"
 
-extern bool proof_acute_isoceles();
-extern bool proof_equilateral();
-extern bool proof_halfsquares();
+/**
+ * The proofs selected on the command line (all proofs in registry order if none)
+ * and the output files that are not written by the provers themselves.
+ */
+struct DriverOptions {
+    std::vector<std::string> proofs;
+    bool list_proofs = false;
+    std::string stats_json_file;
+    bool isa_self_test = false;     //< only run the ivarp_ia self-test (used by the launcher)
+};
+
+static DriverOptions& driver_options() {
+    static DriverOptions options;
+    return options;
+}
+
+static void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--list-proofs] [--proof NAME]... [--threads N]\n"
+              << "       [--max-depth HEIGHT] [--min-width WIDTH] [--split round-robin|widest] [--adaptive-order]\n"
+              << "       [--stats-json FILE] [--certificate DIRECTORY] [--trace PROOF]\n"
+              << "       [--checkpoint FILE [--checkpoint-interval SECONDS] [--resume]]\n"
+              << "       [--quiet] [--progress-interval SECONDS] [--progress-file FILE] [--trace-dir DIRECTORY]\n"
+              << "       [--corpus-dir DIRECTORY [--corpus-sample N]] [--perf-counters]\n"
+              << "       [--timeline FILE [--timeline-sample N] [--timeline-threshold MICROSECONDS]]\n"
+              << "       [--hot-subtrees DEPTH [--hot-subtrees-top K]]\n"
+              << "       [--shard I/N [--shard-expansion BOXES] [--shard-result FILE]]\n"
+              << "       [--coordinator SOCKET [--workers K] [--offload-interval SECONDS]] [--isa-self-test]" << std::endl;
+}
+
+static bool parse_arguments(int argc, char** argv) {
+    ProgressOptions& options = default_progress_options();
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--proof") == 0 && i + 1 < argc) {
+            driver_options().proofs.push_back(argv[++i]);
+        } else if(std::strcmp(argv[i], "--list-proofs") == 0) {
+            driver_options().list_proofs = true;
+        } else if(std::strcmp(argv[i], "--isa-self-test") == 0) {
+            driver_options().isa_self_test = true;
+        } else if(std::strcmp(argv[i], "--stats-json") == 0 && i + 1 < argc) {
+            driver_options().stats_json_file = argv[++i];
+        } else if(std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            default_shard_options().threads = (std::max)(std::strtoull(argv[++i], nullptr, 10), 1ull);
+        } else if(std::strcmp(argv[i], "--max-depth") == 0 && i + 1 < argc) {
+            default_prover_options().max_height = std::strtoull(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--min-width") == 0 && i + 1 < argc) {
+            default_prover_options().min_width = std::atof(argv[++i]);
+        } else if(std::strcmp(argv[i], "--split") == 0 && i + 1 < argc) {
+            std::string policy = argv[++i];
+            if(policy == "round-robin") {
+                default_prover_options().split_policy = SplitPolicy::ROUND_ROBIN;
+            } else if(policy == "widest") {
+                default_prover_options().split_policy = SplitPolicy::WIDEST;
+            } else {
+                std::cerr << "Invalid split policy '" << policy << "'" << std::endl;
+                return false;
+            }
+        } else if(std::strcmp(argv[i], "--adaptive-order") == 0) {
+            default_prover_options().adaptive_order = true;
+        } else if(std::strcmp(argv[i], "--certificate") == 0 && i + 1 < argc) {
+            default_prover_options().certificate_directory = argv[++i];
+        } else if(std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            default_prover_options().trace_proof = argv[++i];
+        } else if(std::strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            default_checkpoint_options().file = argv[++i];
+        } else if(std::strcmp(argv[i], "--checkpoint-interval") == 0 && i + 1 < argc) {
+            default_checkpoint_options().interval = std::atof(argv[++i]);
+        } else if(std::strcmp(argv[i], "--resume") == 0) {
+            default_checkpoint_options().resume = true;
+        } else if(std::strcmp(argv[i], "--quiet") == 0) {
+            options.print_progress = false;
+        } else if(std::strcmp(argv[i], "--progress-interval") == 0 && i + 1 < argc) {
+            options.print_interval = options.file_interval = std::atof(argv[++i]);
+        } else if(std::strcmp(argv[i], "--progress-file") == 0 && i + 1 < argc) {
+            options.progress_file = argv[++i];
+        } else if(std::strcmp(argv[i], "--trace-dir") == 0 && i + 1 < argc) {
+            default_trace_options().trace_directory = argv[++i];
+        } else if(std::strcmp(argv[i], "--timeline") == 0 && i + 1 < argc) {
+            default_timeline_options().file = argv[++i];
+        } else if(std::strcmp(argv[i], "--timeline-sample") == 0 && i + 1 < argc) {
+            default_timeline_options().node_sample_interval = std::strtoull(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--timeline-threshold") == 0 && i + 1 < argc) {
+            default_timeline_options().constraint_threshold_us = std::atof(argv[++i]);
+        } else if(std::strcmp(argv[i], "--hot-subtrees") == 0 && i + 1 < argc) {
+            default_hot_subtree_options().depth = std::strtoull(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--hot-subtrees-top") == 0 && i + 1 < argc) {
+            default_hot_subtree_options().top_k = std::strtoull(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--perf-counters") == 0) {
+            default_perf_counter_options().enabled = true;
+        } else if(std::strcmp(argv[i], "--corpus-dir") == 0 && i + 1 < argc) {
+            default_corpus_options().corpus_directory = argv[++i];
+        } else if(std::strcmp(argv[i], "--corpus-sample") == 0 && i + 1 < argc) {
+            default_corpus_options().sample_interval = std::strtoull(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--shard") == 0 && i + 1 < argc) {
+            ShardOptions& shard = default_shard_options();
+            if(!parse_shard_spec(argv[++i], shard.index, shard.count)) {
+                std::cerr << "Invalid shard specification '" << argv[i] << "'" << std::endl;
+                return false;
+            }
+        } else if(std::strcmp(argv[i], "--shard-expansion") == 0 && i + 1 < argc) {
+            default_shard_options().expansion = std::strtoull(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--shard-result") == 0 && i + 1 < argc) {
+            default_shard_options().result_file = argv[++i];
+        } else if(std::strcmp(argv[i], "--coordinator") == 0 && i + 1 < argc) {
+            default_distributed_options().socket_path = argv[++i];
+        } else if(std::strcmp(argv[i], "--worker") == 0 && i + 1 < argc) {
+            default_distributed_options().socket_path = argv[++i];
+            default_distributed_options().worker = true;
+        } else if(std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            default_distributed_options().workers = std::strtoull(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--offload-interval") == 0 && i + 1 < argc) {
+            default_distributed_options().offload_interval = std::atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return false;
+        }
+    }
+    if(default_checkpoint_options().resume && default_checkpoint_options().file.empty()) {
+        std::cerr << "--resume requires --checkpoint FILE" << std::endl;
+        return false;
+    }
+    if(default_shard_options().threads > 1 && !default_checkpoint_options().file.empty()) {
+        std::cerr << "--checkpoint is not supported with more than one thread" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static const ProofEntry* find_proof(const std::string& name) {
+    for(const ProofEntry& entry : proof_registry()) {
+        if(entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Run the selected proofs in order, skipping those a resumed checkpoint lists as completed.
+ */
+static int run_selected_proofs() {
+    std::vector<const ProofEntry*> selected;
+    if(driver_options().proofs.empty()) {
+        for(const ProofEntry& entry : proof_registry()) {
+            selected.push_back(&entry);
+        }
+    } else {
+        for(const std::string& name : driver_options().proofs) {
+            const ProofEntry* entry = find_proof(name);
+            if(!entry) {
+                std::cerr << "Unknown proof '" << name << "' (see --list-proofs)" << std::endl;
+                return 2;
+            }
+            selected.push_back(entry);
+        }
+    }
+    const CheckpointOptions& checkpoint = default_checkpoint_options();
+    if(checkpoint.resume) {
+        if(std::ifstream(checkpoint.file)) {
+            resumed_checkpoint() = Checkpoint::read(checkpoint.file);
+        } else {
+            std::cerr << "Checkpoint file '" << checkpoint.file << "' does not exist, starting from scratch" << std::endl;
+        }
+    }
+    int result = 0;
+    for(const ProofEntry* entry : selected) {
+        if(resumed_checkpoint().is_completed(entry->name)) {
+            std::cout << "Skipping " << entry->name << " (completed according to checkpoint)" << std::endl;
+            continue;
+        }
+        if(!entry->run()) {
+            result = 1;
+            break;
+        }
+    }
+    if(!driver_options().stats_json_file.empty()) {
+        std::ofstream output(driver_options().stats_json_file, std::ios::out | std::ios::trunc);
+        write_proof_run_records_json(output);
+        if(!output) {
+            std::cerr << "Could not write '" << driver_options().stats_json_file << "'" << std::endl;
+            return result ? result : 1;
+        }
+    }
+    return result;
+}
+
+/**
+ * Check that this build can run on this machine and that its interval kernels work.
+ */
+static bool check_isa() {
+    ivarp::ISALevel compiled = ivarp::compiled_isa_level();
+    if(static_cast<int>(compiled) > static_cast<int>(ivarp::supported_isa_level())) {
+        std::cerr << "This build requires " << ivarp::isa_level_name(compiled) << ", which this CPU does not support; "
+                  << "use the triangle_cover_by_disks launcher to select a suitable build" << std::endl;
+        return false;
+    }
+    if(const char* failed = ivarp::isa_self_test()) {
+        std::cerr << "Self-test of the " << ivarp::isa_level_name(compiled) << " build failed: " << failed << std::endl;
+        return false;
+    }
+    return true;
+}
 
 int main(int argc, char** argv) {
+    if(!parse_arguments(argc, argv)) {
+        return 2;
+    }
+    if(driver_options().list_proofs) {
+        for(const ProofEntry& entry : proof_registry()) {
+            std::cout << entry.name << '\n';
+        }
+        return 0;
+    }
+    install_status_signal_handler();
+    if(default_distributed_options().worker && !default_timeline_options().file.empty()) {
+        default_timeline_options().file += ".worker-" + std::to_string(::getpid());
+    }
+    if(timeline().active()) {
+        install_timeline_signal_handlers();
+        timeline().name_thread(default_distributed_options().worker ? "worker" : "main");
+    }
     ivarp::setup_floating_point_environment();
-    if(!proof_equilateral()) {
-        return 1;
+    if(!check_isa()) {
+        return 3;
+    }
+    if(driver_options().isa_self_test) {
+        return 0;
     }
-    if(!proof_halfsquares()) {
-        return 1;
+    if(default_distributed_options().worker) {
+        return run_below45_worker(default_distributed_options());
     }
-    if(!proof_acute_isoceles()) {
-        return 1;
+    if(default_shard_options().active()) {
+        // only the below-45 case is large enough to be worth sharding
+        return prove_acute_isoceles_below45_shard(default_shard_options()) ? 0 : 1;
     }
-    return 0;
+    return run_selected_proofs();
 }
 
@@ -0,0 +1,266 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * Process-wide option to collect performance counters in all provers.
+ */
+struct PerfCounterOptions {
+    bool enabled = false;
+};
+
+inline PerfCounterOptions& default_perf_counter_options() noexcept {
+    static PerfCounterOptions options;
+    return options;
+}
+
+/**
+ * The hardware events that are counted, if the kernel and CPU allow it.
+ */
+enum class PerfEvent : std::size_t {
+    CYCLES = 0,
+    INSTRUCTIONS,
+    BRANCH_MISSES,
+    L1D_MISSES,
+    LLC_MISSES,
+    COUNT
+};
+
+constexpr std::size_t num_perf_events = std::size_t(PerfEvent::COUNT);
+
+inline const char* perf_event_name(std::size_t event) noexcept {
+    static const char* names[num_perf_events] = {
+        "cycles", "instructions", "branch-misses", "L1d-misses", "LLC-misses"
+    };
+    return names[event];
+}
+
+/**
+ * The phases of the prover main loop that counters are attributed to.
+ */
+enum class ProverPhase : std::size_t {
+    PROPAGATE = 0,
+    CHECK,
+    PROPAGATE_AS_CHECK,
+    SPLIT,
+    REPORT,
+    COUNT
+};
+
+constexpr std::size_t num_prover_phases = std::size_t(ProverPhase::COUNT);
+
+inline const char* prover_phase_name(std::size_t phase) noexcept {
+    static const char* names[num_prover_phases] = {
+        "propagate", "check", "propagate-as-check", "split", "report"
+    };
+    return names[phase];
+}
+
+/**
+ * A snapshot (or difference) of the wall clock and the event counts;
+ * time_enabled and time_running are the kernel's times (in ns) during which the
+ * counter group was enabled and actually scheduled on the PMU, respectively.
+ */
+struct CounterValues {
+    std::uint64_t nanoseconds = 0;
+    std::uint64_t time_enabled = 0;
+    std::uint64_t time_running = 0;
+    std::uint64_t events[num_perf_events] = {};
+};
+
+/**
+ * Counters accumulated over a number of measured sections.
+ * If the kernel multiplexes the counter group with other events, a section may
+ * only have been counted for part of its time; its event counts are then scaled
+ * by the ratio of enabled to running time. Sections during which the group was
+ * not scheduled at all contribute no event counts.
+ */
+struct CounterTotals {
+    std::uint64_t count = 0;
+    std::uint64_t scaled = 0;      //< sections whose event counts were scaled
+    std::uint64_t unscheduled = 0; //< sections without event counts
+    CounterValues sum;
+
+    void add(const CounterValues& begin, const CounterValues& end) noexcept {
+        ++count;
+        sum.nanoseconds += end.nanoseconds - begin.nanoseconds;
+        std::uint64_t enabled = end.time_enabled - begin.time_enabled;
+        std::uint64_t running = end.time_running - begin.time_running;
+        sum.time_enabled += enabled;
+        sum.time_running += running;
+        if(running == enabled) {
+            for(std::size_t i = 0; i < num_perf_events; ++i) {
+                sum.events[i] += end.events[i] - begin.events[i];
+            }
+        } else if(running == 0) {
+            ++unscheduled;
+        } else {
+            ++scaled;
+            double factor = double(enabled) / double(running);
+            for(std::size_t i = 0; i < num_perf_events; ++i) {
+                sum.events[i] += std::uint64_t(double(end.events[i] - begin.events[i]) * factor + 0.5);
+            }
+        }
+    }
+};
+
+/**
+ * A group of hardware counters of the calling thread (user space only),
+ * opened with perf_event_open and read with a single read call.
+ * Events the kernel or CPU do not support are left out; if none are
+ * available (no PMU, e.g., in many VMs, or a restrictive perf_event_paranoid),
+ * only the wall clock is measured.
+ */
+class PerfCounters {
+public:
+    PerfCounters() {
+        static const std::pair<std::uint32_t, std::uint64_t> configs[num_perf_events] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+            {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES}
+        };
+        for(std::size_t i = 0; i < num_perf_events; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = configs[i].first;
+            attr.config = configs[i].second;
+            attr.disabled = (m_leader < 0);
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            int fd = int(::syscall(SYS_perf_event_open, &attr, 0, -1, m_leader, 0));
+            if(fd < 0) {
+                continue;
+            }
+            if(m_leader < 0) {
+                m_leader = fd;
+            }
+            m_fds.push_back(fd);
+            m_slot[i] = int(m_fds.size());
+        }
+        if(m_leader >= 0) {
+            ::ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters &operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+        for(int fd : m_fds) {
+            ::close(fd);
+        }
+    }
+
+    bool hardware_available() const noexcept {
+        return m_leader >= 0;
+    }
+
+    bool event_available(std::size_t event) const noexcept {
+        return m_slot[event] != 0;
+    }
+
+    void read(CounterValues& values) noexcept {
+        values.nanoseconds = std::uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        if(m_leader < 0) {
+            return;
+        }
+        // the number of events, the enabled and running times,
+        // followed by the event values in the order of opening
+        std::uint64_t buffer[3 + num_perf_events];
+        if(::read(m_leader, buffer, sizeof(buffer)) < ssize_t(3 * sizeof(std::uint64_t))) {
+            return;
+        }
+        values.time_enabled = buffer[1];
+        values.time_running = buffer[2];
+        for(std::size_t i = 0; i < num_perf_events; ++i) {
+            if(m_slot[i] != 0 && std::uint64_t(m_slot[i]) <= buffer[0]) {
+                values.events[i] = buffer[2 + m_slot[i]];
+            }
+        }
+    }
+
+    /**
+     * Whether the counter group has ever been scheduled on the PMU;
+     * a group that never was (e.g., because other users hold all counters)
+     * counted nothing and should be treated as unavailable.
+     */
+    bool ever_scheduled() noexcept {
+        if(m_leader < 0) {
+            return false;
+        }
+        CounterValues values;
+        read(values);
+        return values.time_running != 0;
+    }
+
+private:
+    int m_leader = -1;
+    std::vector<int> m_fds;
+    int m_slot[num_perf_events] = {}; //< 1 + position of the event in the group, or 0 if unavailable
+};
+
+/**
+ * Counters attributed to the prover phases and to each constraint;
+ * a constraint is measured whenever it is evaluated or propagated,
+ * so the constraint counters are contained in the phase counters.
+ */
+struct PerfReport {
+    bool enabled = false;
+    bool event_available[num_perf_events] = {};
+    CounterTotals phases[num_prover_phases];
+    std::vector<CounterTotals> constraints;
+};
+
+inline void print_counter_totals(std::ostream& output, const PerfReport& report, const CounterTotals& totals) {
+    output << totals.count << " calls, "
+           << (totals.count ? double(totals.sum.nanoseconds) / double(totals.count) : 0.0) << " ns/call";
+    if(totals.scaled != 0 || totals.unscheduled != 0) {
+        output << " (multiplexed: " << totals.scaled << " calls scaled, " << totals.unscheduled << " not counted)";
+    }
+    for(std::size_t e = 0; e < num_perf_events; ++e) {
+        if(report.event_available[e]) {
+            output << ", " << perf_event_name(e) << ' ' << totals.sum.events[e];
+        }
+    }
+    std::uint64_t cycles = totals.sum.events[std::size_t(PerfEvent::CYCLES)];
+    if(report.event_available[std::size_t(PerfEvent::INSTRUCTIONS)] && cycles != 0) {
+        output << " (IPC " << std::setprecision(2)
+               << double(totals.sum.events[std::size_t(PerfEvent::INSTRUCTIONS)]) / double(cycles)
+               << std::setprecision(0) << ')';
+    }
+    output << '\n';
+}
@@ -0,0 +1,357 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <csignal>
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include "proof_stats.hpp"
+
+/**
+ * Process-wide options for the progress output of running proofs.
+ */
+struct ProgressOptions {
+    bool print_progress = true;      //< print rate-limited progress lines to std::cerr
+    double print_interval = 10.0;    //< minimum number of seconds between two progress lines
+    std::string progress_file;       //< if non-empty, machine-readable progress is written to this file
+    double file_interval = 10.0;     //< minimum number of seconds between two updates of the progress file
+};
+
+inline ProgressOptions& default_progress_options() noexcept {
+    static ProgressOptions options;
+    return options;
+}
+
+inline volatile std::sig_atomic_t& status_requested() noexcept {
+    static volatile std::sig_atomic_t requested = 0;
+    return requested;
+}
+
+/**
+ * Install a SIGUSR1 handler; on receiving the signal,
+ * the running prover dumps a full status snapshot to std::cerr.
+ */
+inline void install_status_signal_handler() {
+    std::signal(SIGUSR1, [] (int) { status_requested() = 1; });
+}
+
+/**
+ * Tracks the progress of a single proof.
+ * Each box on height h makes up 2^-h of the volume of its root box;
+ * the volume that is not yet discharged is thus the sum of 2^-h over all open boxes,
+ * divided by the same sum over the boxes the proof started with. It is handled in log2-space,
+ * since it quickly drops below the range of double for deep proofs.
+ * The clock is only consulted every check_interval nodes.
+ */
+class ProgressMonitor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Start tracking a proof; the volume is reported relative to the boxes
+     * given by initial_by_height (the number of boxes on each height).
+     */
+    void start(const std::string& name, const std::vector<std::uint64_t>& initial_by_height) {
+        m_options = default_progress_options();
+        m_name = name.empty() ? std::string("proof") : name;
+        m_initial_log2 = unnormalized_log2_volume(initial_by_height);
+        if(!std::isfinite(m_initial_log2)) {
+            m_initial_log2 = 0.0;
+        }
+        m_active = m_options.print_progress || !m_options.progress_file.empty();
+        m_start = m_last_print = m_last_file = m_last_rate = Clock::now();
+        m_nodes = m_nodes_at_last_rate = 0;
+        m_open_by_height.clear();
+        m_leaves_by_height.clear();
+        m_unproven_by_height.clear();
+        m_remaining_log2 = m_remaining_at_last_rate = 0.0;
+        m_node_rate = m_discharge_rate = 0.0;
+    }
+
+    /**
+     * Count a node; returns true if report should be called.
+     */
+    bool node_processed() noexcept {
+        ++m_nodes;
+        if(status_requested()) {
+            return true;
+        }
+        return m_active && (m_nodes & (check_interval - 1)) == 0 && due(Clock::now());
+    }
+
+    /**
+     * Count a box that was decided (refuted, satisfiable or given up on).
+     */
+    void leaf(std::uint64_t height) {
+        count_height(m_leaves_by_height, height);
+    }
+
+    /**
+     * Count a box whose volume was not proved: a satisfiable or undecided leaf,
+     * or an open box abandoned when the proof was aborted.
+     */
+    void unproven(std::uint64_t height) {
+        count_height(m_unproven_by_height, height);
+    }
+
+    /**
+     * Begin collecting the heights of the open boxes for a report.
+     */
+    void begin_open_boxes() noexcept {
+        std::fill(m_open_by_height.begin(), m_open_by_height.end(), std::uint64_t(0));
+    }
+
+    void open_box(std::uint64_t height) {
+        count_height(m_open_by_height, height);
+    }
+
+    /**
+     * Count a box on the given height in a histogram by height.
+     */
+    static void count_height(std::vector<std::uint64_t>& by_height, std::uint64_t height) {
+        if(height >= by_height.size()) {
+            by_height.resize(height + 1, 0);
+        }
+        ++by_height[height];
+    }
+
+    /**
+     * Print progress, write the progress file or dump the status, whatever is due;
+     * the open boxes must have been collected before.
+     */
+    void report(std::uint64_t height_limit, const ProofStats& stats) {
+        Clock::time_point now = Clock::now();
+        update_rates(now);
+        if(status_requested()) {
+            status_requested() = 0;
+            print_status(height_limit, stats, now);
+        }
+        if(m_options.print_progress && seconds(m_last_print, now) >= m_options.print_interval) {
+            print_line(now);
+            m_last_print = now;
+        }
+        if(!m_options.progress_file.empty() && seconds(m_last_file, now) >= m_options.file_interval) {
+            write_file(now, false);
+            m_last_file = now;
+        }
+    }
+
+    /**
+     * Called once the proof has ended, with no boxes left open; prints the outcome
+     * and writes the final progress file. Unless the proof succeeded, the volume of
+     * the unproven boxes is reported as not discharged.
+     */
+    void finish(bool proved) {
+        begin_open_boxes();
+        Clock::time_point now = Clock::now();
+        update_rates(now);
+        m_remaining_log2 = log2_volume(m_unproven_by_height);
+        if(m_options.print_progress) {
+            print_outcome(proved, now);
+        }
+        if(!m_options.progress_file.empty()) {
+            write_file(now, true, proved);
+        }
+    }
+
+private:
+    static constexpr std::uint64_t check_interval = 1024;
+    static constexpr double rate_smoothing = 0.3;
+
+    static double seconds(Clock::time_point begin, Clock::time_point end) noexcept {
+        return std::chrono::duration<double>(end - begin).count();
+    }
+
+    bool due(Clock::time_point now) const noexcept {
+        return (m_options.print_progress && seconds(m_last_print, now) >= m_options.print_interval) ||
+               (!m_options.progress_file.empty() && seconds(m_last_file, now) >= m_options.file_interval);
+    }
+
+    std::uint64_t open_boxes() const noexcept {
+        std::uint64_t result = 0;
+        for(std::uint64_t c : m_open_by_height) {
+            result += c;
+        }
+        return result;
+    }
+
+    double log2_volume(const std::vector<std::uint64_t>& by_height) const noexcept {
+        return unnormalized_log2_volume(by_height) - m_initial_log2;
+    }
+
+    static double unnormalized_log2_volume(const std::vector<std::uint64_t>& by_height) noexcept {
+        std::size_t min_height = 0;
+        while(min_height < by_height.size() && by_height[min_height] == 0) {
+            ++min_height;
+        }
+        if(min_height == by_height.size()) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        // sum relative to the smallest height, which contributes at least 1
+        double sum = 0.0;
+        for(std::size_t h = min_height; h < by_height.size(); ++h) {
+            sum += std::ldexp(double(by_height[h]), -int((std::min)(h - min_height, std::size_t(2000))));
+        }
+        return std::log2(sum) - double(min_height);
+    }
+
+    void update_rates(Clock::time_point now) noexcept {
+        m_remaining_log2 = log2_volume(m_open_by_height);
+        double dt = seconds(m_last_rate, now);
+        if(dt <= 0.0) {
+            return;
+        }
+        double node_rate = double(m_nodes - m_nodes_at_last_rate) / dt;
+        double discharge_rate = (std::exp2(m_remaining_at_last_rate) - std::exp2(m_remaining_log2)) / dt;
+        if(m_nodes_at_last_rate == 0) {
+            m_node_rate = node_rate;
+            m_discharge_rate = discharge_rate;
+        } else {
+            m_node_rate += rate_smoothing * (node_rate - m_node_rate);
+            m_discharge_rate += rate_smoothing * (discharge_rate - m_discharge_rate);
+        }
+        m_last_rate = now;
+        m_nodes_at_last_rate = m_nodes;
+        m_remaining_at_last_rate = m_remaining_log2;
+    }
+
+    double discharged_fraction() const noexcept {
+        // the sum over all boxes may exceed 1 by a rounding error
+        return (std::max)(0.0, 1.0 - std::exp2(m_remaining_log2));
+    }
+
+    double eta() const noexcept {
+        if(m_discharge_rate <= 0.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        return std::exp2(m_remaining_log2) / m_discharge_rate;
+    }
+
+    void print_line(Clock::time_point now) const {
+        std::ios_base::fmtflags flags = std::cerr.flags();
+        std::streamsize precision = std::cerr.precision();
+        double e = eta();
+        std::cerr << std::fixed << std::setprecision(1) << '[' << m_name << "] " << seconds(m_start, now) << "s, "
+                  << m_nodes << " nodes (" << std::setprecision(0) << m_node_rate << "/s), "
+                  << open_boxes() << " open, remaining volume 2^" << std::setprecision(2) << m_remaining_log2
+                  << " (" << std::setprecision(4) << 100.0 * discharged_fraction() << "% done), ETA ";
+        if(std::isfinite(e)) {
+            std::cerr << std::setprecision(0) << e << 's';
+        } else {
+            std::cerr << "unknown";
+        }
+        std::cerr << std::endl;
+        std::cerr.flags(flags);
+        std::cerr.precision(precision);
+    }
+
+    void print_outcome(bool proved, Clock::time_point now) const {
+        std::ios_base::fmtflags flags = std::cerr.flags();
+        std::streamsize precision = std::cerr.precision();
+        std::cerr << std::fixed << std::setprecision(1) << '[' << m_name << "] "
+                  << (proved ? "proved" : "not proved") << " after " << seconds(m_start, now) << "s, "
+                  << m_nodes << " nodes";
+        if(!proved) {
+            std::cerr << ", unproven volume 2^" << std::setprecision(2) << m_remaining_log2
+                      << " (" << std::setprecision(4) << 100.0 * discharged_fraction() << "% discharged)";
+        }
+        std::cerr << std::endl;
+        std::cerr.flags(flags);
+        std::cerr.precision(precision);
+    }
+
+    static void print_histogram(const char* title, const std::vector<std::uint64_t>& histogram) {
+        std::cerr << title << ':';
+        for(std::size_t h = 0; h < histogram.size(); ++h) {
+            if(histogram[h] != 0) {
+                std::cerr << ' ' << h << ':' << histogram[h];
+            }
+        }
+        std::cerr << '\n';
+    }
+
+    void print_status(std::uint64_t height_limit, const ProofStats& stats, Clock::time_point now) const {
+        std::ios_base::fmtflags flags = std::cerr.flags();
+        std::streamsize precision = std::cerr.precision();
+        std::cerr << std::fixed << std::setprecision(1)
+                  << "Status of " << m_name << " after " << seconds(m_start, now) << "s:\n"
+                  << "Nodes: " << m_nodes << " (" << m_node_rate << "/s)\n"
+                  << "Remaining volume: 2^" << std::setprecision(4) << m_remaining_log2
+                  << ", ETA " << std::setprecision(0) << eta() << "s\n";
+        std::cerr.flags(flags);
+        std::cerr.precision(precision);
+        if(height_limit != std::numeric_limits<std::uint64_t>::max()) {
+            std::cerr << "Height limit of current pass: " << height_limit << '\n';
+        }
+        print_histogram("Open boxes by height", m_open_by_height);
+        print_histogram("Leaves by height", m_leaves_by_height);
+        std::cerr << stats << std::flush;
+    }
+
+    static void write_number(std::ostream& output, double value) {
+        if(std::isfinite(value)) {
+            output << value;
+        } else {
+            output << "null";
+        }
+    }
+
+    void write_file(Clock::time_point now, bool done, bool proved = false) const {
+        // write to a temporary file first, so the monitor never reads a partial file
+        std::string tmp_name = m_options.progress_file + ".tmp";
+        {
+            std::ofstream output(tmp_name, std::ios::out | std::ios::trunc);
+            output << std::setprecision(17)
+                   << "{\"proof\": \"" << m_name << "\", \"done\": " << (done ? "true" : "false");
+            if(done) {
+                output << ", \"proved\": " << (proved ? "true" : "false");
+            }
+            output << ", \"elapsed_seconds\": " << seconds(m_start, now)
+                   << ", \"nodes\": " << m_nodes << ", \"nodes_per_second\": ";
+            write_number(output, m_node_rate);
+            output << ", \"open_boxes\": " << open_boxes() << ", \"remaining_volume_log2\": ";
+            write_number(output, m_remaining_log2);
+            output << ", \"discharged_fraction\": " << discharged_fraction() << ", \"eta_seconds\": ";
+            // an unproven proof that has ended will never finish
+            write_number(output, !done ? eta() : proved ? 0.0 : std::numeric_limits<double>::infinity());
+            output << "}\n";
+        }
+        std::rename(tmp_name.c_str(), m_options.progress_file.c_str());
+    }
+
+    ProgressOptions m_options;
+    std::string m_name;
+    double m_initial_log2 = 0.0;
+    bool m_active = false;
+    Clock::time_point m_start, m_last_print, m_last_file, m_last_rate;
+    std::uint64_t m_nodes = 0, m_nodes_at_last_rate = 0;
+    std::vector<std::uint64_t> m_open_by_height;
+    std::vector<std::uint64_t> m_leaves_by_height;
+    std::vector<std::uint64_t> m_unproven_by_height;
+    double m_remaining_log2 = 0.0, m_remaining_at_last_rate = 0.0;
+    double m_node_rate = 0.0, m_discharge_rate = 0.0;
+};
@@ -0,0 +1,39 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include "proof_registry.hpp"
+#include "below_45_isoceles.hpp"
+
+extern bool proof_equilateral();
+extern bool proof_halfsquares_case3();
+extern bool prove_r1_diff_negative();
+extern bool prove_r2_diff_negative();
+extern bool prove_alpha_diff_negative();
+
+const std::vector<ProofEntry>& proof_registry() {
+    static const std::vector<ProofEntry> proofs{
+        {"equilateral", &proof_equilateral},
+        {"halfsquares_case3", &proof_halfsquares_case3},
+        {"below45_r1_diff", &prove_r1_diff_negative},
+        {"below45_r2_diff", &prove_r2_diff_negative},
+        {"below45_alpha_diff", &prove_alpha_diff_negative},
+        {"below45", &prove_below45_main_case}
+    };
+    return proofs;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include "perf_counters.hpp"
+
+/**
+ * Per-constraint counters collected by the prover.
+ * Costs are measured in time stamp counter ticks.
+ */
+struct ConstraintStats {
+    std::string name;
+    std::uint64_t evaluations = 0;
+    std::uint64_t refutations = 0;
+    std::uint64_t definitely_satisfied = 0;
+    std::uint64_t guard_skips = 0;     //< skipped because the box is outside the declared guard
+    std::uint64_t inherited_skips = 0; //< skipped because the constraint was definitely satisfied on an ancestor
+    std::uint64_t cost = 0;
+
+    double average_cost() const noexcept {
+        return evaluations ? double(cost) / double(evaluations) : 0.0;
+    }
+
+    std::uint64_t skips() const noexcept {
+        return guard_skips + inherited_skips;
+    }
+
+    /**
+     * Estimated cost saved by skipping, assuming a skipped evaluation
+     * would have cost as much as an average evaluation.
+     */
+    double saved_cost() const noexcept {
+        return double(skips()) * average_cost();
+    }
+};
+
+struct ProofStats {
+    std::uint64_t nodes = 0;
+    std::uint64_t peak_open_boxes = 0;
+    std::vector<ConstraintStats> constraints;
+    PerfReport counters; //< only collected if enabled
+};
+
+/**
+ * Combine the statistics of provers that proved disjoint parts of the same proof
+ * with identical constraints; peak_open_boxes becomes the sum of the individual peaks.
+ * Performance counters are not combined.
+ */
+inline void merge_proof_stats(ProofStats& into, const ProofStats& from) {
+    into.nodes += from.nodes;
+    into.peak_open_boxes += from.peak_open_boxes;
+    if(into.constraints.size() < from.constraints.size()) {
+        into.constraints.resize(from.constraints.size());
+    }
+    for(std::size_t i = 0; i < from.constraints.size(); ++i) {
+        ConstraintStats& c = into.constraints[i];
+        const ConstraintStats& f = from.constraints[i];
+        c.name = f.name;
+        c.evaluations += f.evaluations;
+        c.refutations += f.refutations;
+        c.definitely_satisfied += f.definitely_satisfied;
+        c.guard_skips += f.guard_skips;
+        c.inherited_skips += f.inherited_skips;
+        c.cost += f.cost;
+    }
+}
+
+/**
+ * Summary of a completed call to Prover::prove; every prover
+ * appends one to proof_run_records(), so tools such as the proof
+ * benchmark can inspect proofs run by the proof functions.
+ */
+struct ProofRunRecord {
+    std::string name;
+    bool proved;
+    std::uint64_t nodes;
+    std::uint64_t peak_open_boxes;
+    double seconds;
+    bool budget_exceeded;
+    std::vector<ConstraintStats> constraints;
+};
+
+inline std::vector<ProofRunRecord>& proof_run_records() {
+    static std::vector<ProofRunRecord> records;
+    return records;
+}
+
+inline std::mutex& proof_run_records_mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+/**
+ * Append a record; provers may run concurrently in different threads.
+ */
+inline void add_proof_run_record(ProofRunRecord record) {
+    std::lock_guard<std::mutex> lock(proof_run_records_mutex());
+    proof_run_records().push_back(std::move(record));
+}
+
+/**
+ * Write all proof run records, including their per-constraint counters, as JSON.
+ */
+inline void write_proof_run_records_json(std::ostream& output) {
+    auto quoted = [] (const std::string& s) {
+        std::string result = "\"";
+        for(char c : s) {
+            if(c == '"' || c == '\\') {
+                result += '\\';
+            }
+            result += c;
+        }
+        return result + "\"";
+    };
+    std::lock_guard<std::mutex> lock(proof_run_records_mutex());
+    output << std::setprecision(6) << "{\n  \"proofs\": [\n";
+    const std::vector<ProofRunRecord>& records = proof_run_records();
+    for(std::size_t i = 0; i < records.size(); ++i) {
+        const ProofRunRecord& r = records[i];
+        output << "    {\"name\": " << quoted(r.name) << ", \"proved\": " << (r.proved ? "true" : "false")
+               << ", \"nodes\": " << r.nodes << ", \"peak_open_boxes\": " << r.peak_open_boxes
+               << ", \"seconds\": " << r.seconds << ", \"budget_exceeded\": " << (r.budget_exceeded ? "true" : "false")
+               << ",\n     \"constraints\": [";
+        for(std::size_t j = 0; j < r.constraints.size(); ++j) {
+            const ConstraintStats& c = r.constraints[j];
+            output << (j ? ",\n" : "\n") << "       {\"name\": " << quoted(c.name)
+                   << ", \"evaluations\": " << c.evaluations << ", \"refutations\": " << c.refutations
+                   << ", \"definitely_satisfied\": " << c.definitely_satisfied
+                   << ", \"guard_skips\": " << c.guard_skips << ", \"inherited_skips\": " << c.inherited_skips
+                   << ", \"cost\": " << c.cost << "}";
+        }
+        output << "]}" << (i + 1 < records.size() ? ",\n" : "\n");
+    }
+    output << "  ]\n}\n";
+}
+
+inline std::ostream& operator<<(std::ostream& output, const ProofStats& stats) {
+    std::ios_base::fmtflags flags = output.flags();
+    std::streamsize precision = output.precision();
+    output << std::fixed << std::setprecision(0);
+    output << "Nodes: " << stats.nodes << ", peak open boxes: " << stats.peak_open_boxes << '\n';
+    for(const ConstraintStats& c : stats.constraints) {
+        output << "Constraint '" << c.name << "': "
+               << c.evaluations << " evaluations, "
+               << c.refutations << " refutations, "
+               << c.definitely_satisfied << " definitely satisfied, "
+               << c.guard_skips << " guard skips, "
+               << c.inherited_skips << " inherited skips, "
+               << c.average_cost() << " ticks/evaluation, "
+               << c.saved_cost() << " ticks saved\n";
+    }
+    if(stats.counters.enabled) {
+        bool hardware = false;
+        for(bool a : stats.counters.event_available) {
+            hardware = hardware || a;
+        }
+        output << "Performance counters" << (hardware ? "" : " (hardware counters unavailable, timers only)") << ":\n";
+        for(std::size_t p = 0; p < num_prover_phases; ++p) {
+            output << "  Phase " << prover_phase_name(p) << ": ";
+            print_counter_totals(output, stats.counters, stats.counters.phases[p]);
+        }
+        for(std::size_t i = 0; i < stats.counters.constraints.size() && i < stats.constraints.size(); ++i) {
+            output << "  Constraint '" << stats.constraints[i].name << "': ";
+            print_counter_totals(output, stats.counters, stats.counters.constraints[i]);
+        }
+    }
+    output.flags(flags);
+    output.precision(precision);
+    return output;
+}
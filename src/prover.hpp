@@ -16,7 +16,23 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <x86intrin.h>
 #include "constraint.hpp"
+#include "proof_stats.hpp"
+#include "constraint_order.hpp"
+#include "progress.hpp"
+#include "binary_trace.hpp"
+#include "box_corpus.hpp"
+#include "sharding.hpp"
+#include "timeline.hpp"
+#include "hot_subtrees.hpp"
+#include "ablation.hpp"
+#include "checkpoint.hpp"
+#include "prover_options.hpp"
 
 template<typename VariableSet> class Prover {
 public:
@@ -39,28 +55,43 @@ public:
     constexpr static bool tracing_supported = supports_tracing_fn<VariableSet>(0);
 
     struct StackElement {
-        StackElement(const Prover& prover, VariableSet domain, std::uint64_t id) :
+        StackElement(const Prover& prover, VariableSet domain, std::uint64_t id, std::uint64_t height = 0) :
             domain(std::move(domain)),
-            height(0),
-            id(id), parent_id(0)
+            height(height),
+            id(id), parent_id(0),
+            satisfied_checkers(0),
+            subtree(no_subtree)
         {}
 
         StackElement(VariableSet domain, const StackElement& parent, std::uint64_t id) :
             domain(std::move(domain)),
             height(parent.height + 1u),
             id(id),
-            parent_id(parent.id)
+            parent_id(parent.id),
+            satisfied_checkers(parent.satisfied_checkers),
+            subtree(parent.subtree)
         {}
 
         VariableSet domain;
         std::uint64_t height;
         std::uint64_t id, parent_id;
+        // bit i is set if checker i is definitely satisfied on this box (learned on an ancestor)
+        std::uint64_t satisfied_checkers;
+        // index of the hot-subtree entry of the ancestor at the hot-subtree depth
+        std::size_t subtree;
     };
 
+    static constexpr std::size_t no_subtree = std::numeric_limits<std::size_t>::max();
+
     explicit Prover() = default;
 
-    void add_variable_set(const VariableSet& vars) {
+    /**
+     * Add an initial box; boxes that result from splitting at the given height
+     * can be added with that height to continue splitting in the same way.
+     */
+    void add_variable_set(const VariableSet& vars, std::uint64_t height = 0) {
         m_basic.push_back(vars);
+        m_basic_heights.push_back(height);
     }
 
     void add_constraint(ConstrPtr m) {
@@ -81,103 +112,857 @@ public:
         m_abort_height = height;
     }
 
+    /**
+     * Evaluate the checkers in an order that adapts to their observed
+     * refutation rate and cost (bucketed by height), re-sorting every
+     * resort_interval nodes. By default, checkers are evaluated in the
+     * order in which they were added.
+     */
+    void adaptive_constraint_order(bool active = true, std::uint64_t resort_interval = 4096) noexcept {
+        m_adaptive_order = active;
+        m_resort_interval = resort_interval;
+    }
+
+    /**
+     * Stop splitting the variable with the given index once its width is at most
+     * max(absolute_width, relative_width * initial width); variables that cannot
+     * be bisected in floating-point arithmetic are not split either.
+     * Boxes on which no variable can be split are reported like boxes at the abort height.
+     */
+    void resolution_limit(std::size_t index, double absolute_width, double relative_width = 0.0) {
+        m_resolution_limited = true;
+        m_absolute_width_limit[index] = absolute_width;
+        m_relative_width_limit[index] = relative_width;
+    }
+
+    /**
+     * Iterative deepening: the first pass only subdivides boxes up to the given initial height;
+     * each further pass only revisits the boxes left undecided by the previous pass,
+     * with the height limit increased by height_step, until the abort height is reached.
+     */
+    void iterative_deepening(std::uint64_t initial_height, std::uint64_t height_step) noexcept {
+        m_deepening_initial = initial_height;
+        m_deepening_step = (std::max)(height_step, std::uint64_t(1));
+    }
+
+    /**
+     * Only prove the part of the domain assigned to shard index of count:
+     * the initial boxes are expanded breadth-first into at least expansion boxes,
+     * of which this prover handles those with an index congruent to index modulo count.
+     * A count of 0 disables sharding.
+     */
+    void shard(std::size_t index, std::size_t count, std::size_t expansion) noexcept {
+        m_shard_index = index;
+        m_shard_count = count;
+        m_shard_expansion = expansion;
+    }
+
+    /**
+     * The expanded boxes handled by this shard (valid after prove()).
+     */
+    const std::vector<ShardResult::Box>& shard_boxes() const noexcept {
+        return m_shard_boxes;
+    }
+
+    /**
+     * The number of boxes of the expansion (valid after prove()).
+     */
+    std::size_t shard_total_boxes() const noexcept {
+        return m_shard_total_boxes;
+    }
+
+    /**
+     * Every interval_seconds, remove the bottom half of the open stack (the boxes closest
+     * to the root) and pass it to the handler, which becomes responsible for proving them.
+     * The handler is also called (with no boxes) if the stack is too small to be split.
+     */
+    template<typename Callable>
+        void set_offload_handler(double interval_seconds, Callable&& handler)
+    {
+        m_offload_interval = interval_seconds;
+        m_offload_handler = std::forward<Callable>(handler);
+    }
+
+    /**
+     * Set the name under which progress of this proof is reported.
+     */
+    void set_name(std::string name) {
+        m_name = std::move(name);
+    }
+
+    /**
+     * Distinguish provers of the same proof running concurrently (e.g., in-process shards);
+     * the suffix is appended to the name in progress output, run records and output file names,
+     * while options and registries still refer to the proof by its name.
+     */
+    void set_instance(std::string suffix) {
+        m_instance = std::move(suffix);
+    }
+
+    /**
+     * Continue existing certificate and corpus files instead of truncating them;
+     * used by workers that prove many boxes of the same proof one after another.
+     * Proofs resumed from a checkpoint always continue their certificate.
+     */
+    void append_outputs(bool append = true) noexcept {
+        m_append_outputs = append;
+    }
+
+    /**
+     * Choose the variable to split; see SplitPolicy.
+     */
+    void split_policy(SplitPolicy policy) noexcept {
+        m_split_policy = policy;
+    }
+
+    /**
+     * Write a certificate to the given file (empty to disable): one record for each leaf
+     * of the search tree, with the box and the constraint that refuted it (result VIOLATED)
+     * or made it empty by propagation (result EMPTIED, with the box before propagation).
+     * It has the format of a box corpus, so constraint_replay can re-check it.
+     * If no file is given, the certificate directory in default_prover_options() is used, if set.
+     */
+    void certificate(std::string filename) {
+        m_certificate_file = std::move(filename);
+    }
+
     void trace(bool active = true) noexcept {
         m_trace = active && tracing_supported;
     }
 
+    /**
+     * Write a binary trace with one record per node to the given file (empty to disable);
+     * use the trace_decode tool to render it as text.
+     * If no file is given, the trace directory in default_trace_options() is used, if set.
+     */
+    void binary_trace(std::string filename) {
+        m_binary_trace_file = std::move(filename);
+    }
+
+    /**
+     * Write every sample_interval-th box passed to each checker, together with
+     * the result of the check, to the given corpus file (empty to disable);
+     * use the constraint_replay tool to benchmark a constraint on the corpus.
+     * If no file is given, the corpus directory in default_corpus_options() is used, if set.
+     */
+    void capture_corpus(std::string filename, std::uint64_t sample_interval) {
+        m_corpus_file = std::move(filename);
+        m_corpus_interval = (std::max)(sample_interval, std::uint64_t(1));
+    }
+
+    /**
+     * Measure hardware performance counters (if available, otherwise only time)
+     * per phase of the main loop and per constraint; they are reported in stats().counters.
+     * This adds a system call per measured section, so it slows the proof down.
+     * Also enabled by default_perf_counter_options().
+     */
+    void performance_counters(bool active = true) noexcept {
+        m_perf_requested = active;
+    }
+
+    /**
+     * Count the nodes in each subtree rooted at the given depth and keep
+     * the top_k subtrees with the most nodes, together with the constraints
+     * that decided their leaves (see hottest_subtrees()). A depth of 0 disables this.
+     * Also enabled (and printed after the proof) by default_hot_subtree_options().
+     */
+    void hot_subtrees(std::uint64_t depth, std::size_t top_k = 10) noexcept {
+        m_hot_depth = depth;
+        m_hot_top_k = top_k;
+    }
+
+    /**
+     * The subtrees with the most nodes, in descending order (valid after prove()).
+     */
+    const std::vector<HotSubtree<VariableSet>>& hottest_subtrees() const noexcept {
+        return m_hottest;
+    }
+
+    /**
+     * Leave out the constraint with the given index (in the order of addition);
+     * used to check whether a constraint is needed.
+     */
+    void disable_constraint(std::size_t index) {
+        m_disabled.push_back(index);
+    }
+
+    /**
+     * Give up (and fail) after processing max_nodes nodes or running for max_seconds (0: no limit).
+     */
+    void budget(std::uint64_t max_nodes, double max_seconds = 0.0) noexcept {
+        m_max_nodes = max_nodes;
+        m_max_seconds = max_seconds;
+    }
+
+    /**
+     * Whether the last proof failed because it exceeded its budget.
+     */
+    bool budget_exceeded() const noexcept {
+        return m_budget_exceeded;
+    }
+
+    const std::vector<ConstrPtr>& constraints() const noexcept {
+        return m_constraints;
+    }
+
     template<typename Callable>
         void set_reporter(Callable&& callable)
     {
         m_reporter = std::forward<Callable>(callable);
     }
 
+    const ProofStats& stats() const noexcept {
+        return m_stats;
+    }
+
     bool prove() {
+        auto start = std::chrono::steady_clock::now();
         setup_proof();
         bool result = true;
-        while(!m_stack.empty()) {
+        while(!m_stack.empty() || !m_deferred.empty()) {
+            if(m_checkpointing && (m_stats.nodes & (offload_check_interval - 1)) == 0) {
+                periodic_checkpoint();
+            }
+            if(m_stack.empty()) {
+                // start the next deepening pass on the boxes left undecided by this one
+                m_height_limit = (std::min)(m_height_limit + m_deepening_step, m_abort_height);
+                m_stack.swap(m_deferred);
+            }
+            if(m_progress.node_processed()) {
+                TimelineSpan span("progress report", "io");
+                measured(ProverPhase::REPORT, [&] () { report_progress(); return true; });
+            }
+            if(m_offload_handler && (m_stats.nodes & (offload_check_interval - 1)) == 0) {
+                offload();
+            }
+            if(m_budgeted && budget_exhausted(start)) {
+                m_budget_exceeded = true;
+                result = false;
+                abandon_open_boxes();
+                break;
+            }
             StackElement element = m_stack.back();
             m_stack.pop_back();
+            ++m_stats.nodes;
+            m_deciding = -1;
+            if(m_timeline) {
+                begin_timeline_node();
+            }
+            if(m_hot_active) {
+                count_hot_node(element);
+            }
             trace_node(element);
-            if(run_propagators(element)) {
+            if(measured(ProverPhase::PROPAGATE, [&] () { return run_propagators(element); })) {
                 if(m_trace) {
-                    *m_tracer << "Empty after propagation!" << std::endl;
+                    *m_tracer << "Empty after propagation!" << '\n';
                 }
+                node_done(element, TraceOutcome::EMPTY_AFTER_PROPAGATION);
                 continue;
             }
-            ivarp::IBool cresult = run_checkers(element);
+            ivarp::IBool cresult = measured(ProverPhase::CHECK, [&] () { return run_checkers(element); });
             if(!possibly(cresult)) {
                 if(m_trace) {
-                    *m_tracer << "Constraints violated!" << std::endl;
+                    *m_tracer << "Constraints violated!" << '\n';
                 }
+                node_done(element, TraceOutcome::REFUTED);
                 continue;
             }
             bool def = definitely(cresult);
             if(def) {
-                cresult &= run_propagators_as_checkers(element);
+                cresult &= measured(ProverPhase::PROPAGATE_AS_CHECK,
+                                    [&] () { return run_propagators_as_checkers(element); });
                 if(!possibly(cresult)) {
                     if(m_trace) {
-                        *m_tracer << "Constraints violated!" << std::endl;
+                        *m_tracer << "Constraints violated!" << '\n';
                     }
+                    node_done(element, TraceOutcome::REFUTED);
                     continue;
                 }
                 def = definitely(cresult);
             }
             if(def) {
                 result = false;
+                node_done(element, TraceOutcome::SATISFIABLE);
                 report_satisfiable(element.domain, true);
                 if(m_abort_satisfiable) {
-                    m_stack.clear();
+                    abandon_open_boxes();
                 }
                 assert(all_possible(element));
             } else {
-                if(element.height == m_abort_height) {
+                std::size_t split_index = 0;
+                if(element.height >= m_abort_height || !find_split_variable(element, split_index)) {
                     result = false;
+                    node_done(element, TraceOutcome::UNDECIDED);
                     report_satisfiable(element.domain, false);
                     if(m_abort_satisfiable) {
-                        m_stack.clear();
+                        abandon_open_boxes();
                     }
                     assert(all_possible(element));
                 } else {
+                    node_done(element, TraceOutcome::SPLIT);
+                    // beyond the height limit of the current deepening pass, children wait for the next pass
+                    std::vector<StackElement>& target = (element.height >= m_height_limit) ? m_deferred : m_stack;
                     auto split_callback = [&] (VariableSet split_domain) {
-                        m_stack.push_back(StackElement(split_domain, element, ++m_id_counter));
+                        target.push_back(StackElement(split_domain, element, ++m_id_counter));
                     };
-                    element.domain.split(split_callback, element.height);
+                    measured(ProverPhase::SPLIT, [&] () {
+                        if(m_resolution_limited || m_split_policy != SplitPolicy::DEFAULT) {
+                            element.domain.split_variable(split_callback, split_index);
+                        } else {
+                            element.domain.split(split_callback, element.height);
+                        }
+                        return true;
+                    });
+                    m_stats.peak_open_boxes = (std::max)(m_stats.peak_open_boxes,
+                                                         std::uint64_t(m_stack.size() + m_deferred.size()));
                 }
             }
         }
+        m_progress.finish(result);
+        m_binary_tracer.reset();
+        m_corpus.reset();
+        finish_perf_counters();
+        m_certificate.reset();
+        if(m_hot_active) {
+            finish_hot_subtrees();
+        }
+        if(m_timeline) {
+            timeline().complete("proof " + display_name(), "proof", m_proof_begin_us, timeline().now_us(),
+                                "\"nodes\": " + std::to_string(m_stats.nodes) +
+                                ", \"proved\": " + (result ? "true" : "false"));
+            timeline().flush();
+        }
+        add_proof_run_record(ProofRunRecord{display_name(), result, m_stats.nodes, m_stats.peak_open_boxes,
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+            m_budget_exceeded, m_stats.constraints});
+        if(m_checkpointing) {
+            final_checkpoint(result);
+        }
+        if(m_trace) {
+            m_tracer->flush();
+        }
         return result;
     }
 
 private:
+    using GuardBox = typename Constr::GuardBox;
+
+    struct CheckerEntry {
+        explicit CheckerEntry(Constr* constraint, std::int32_t index, ConstraintStats* stats, std::uint64_t mask_bit) :
+            constraint(constraint), index(index), stats(stats), mask_bit(mask_bit),
+            has_guard(constraint->guard(guard))
+        {}
+
+        Constr* constraint;
+        std::int32_t index;
+        ConstraintStats* stats;
+        std::uint64_t mask_bit;
+        GuardBox guard;
+        bool has_guard;
+    };
+
 #ifndef NDEBUG
     bool all_possible(const StackElement& element) noexcept {
-        ivarp::IBool props = run_checker_collection(element, m_propagators);
-        ivarp::IBool cstrs = run_checker_collection(element, m_checkers);
-        return possibly(props && cstrs);
+        ivarp::IBool result{true, true};
+        for(const auto& c : m_constraints) {
+            result &= c->satisfied(element.domain);
+        }
+        return possibly(result);
     }
 #endif
 
     void setup_proof() {
         m_checkers.clear();
         m_propagators.clear();
-        for(const auto& c : m_constraints) {
+        m_stats = ProofStats{};
+        m_stats.constraints.resize(m_constraints.size());
+        const AblationOptions& ablation = default_ablation_options();
+        std::vector<std::size_t> disabled = m_disabled;
+        if(!ablation.proof.empty() && ablation.proof == m_name) {
+            disabled.insert(disabled.end(), ablation.disabled_constraints.begin(), ablation.disabled_constraints.end());
+        }
+        for(std::size_t i = 0; i < m_constraints.size(); ++i) {
+            Constr* c = m_constraints[i].get();
+            ConstraintStats* s = &m_stats.constraints[i];
+            s->name = c->name();
+            if(std::find(disabled.begin(), disabled.end(), i) != disabled.end()) {
+                continue;
+            }
             if(c->can_propagate()) {
-                m_propagators.push_back(c.get());
+                m_propagators.emplace_back(c, std::int32_t(i), s, 0);
             } else {
-                m_checkers.push_back(c.get());
+                std::size_t index = m_checkers.size();
+                std::uint64_t mask_bit = (index < 64) ? (std::uint64_t(1) << index) : 0;
+                m_checkers.emplace_back(c, std::int32_t(i), s, mask_bit);
             }
         }
+        apply_prover_options();
+        m_order.reset(m_checkers.size(), m_resort_interval);
+        if(ablation.max_nodes != 0 || ablation.max_seconds != 0.0) {
+            m_max_nodes = ablation.max_nodes;
+            m_max_seconds = ablation.max_seconds;
+        }
+        m_budgeted = (m_max_nodes != 0 || m_max_seconds != 0.0);
+        m_budget_exceeded = false;
         m_stack.clear();
-        for(const VariableSet& v : m_basic) {
-            m_stack.push_back(StackElement(*this, v, ++m_id_counter));
+        m_deferred.clear();
+        m_height_limit = (m_deepening_step == 0) ? m_abort_height : (std::min)(m_deepening_initial, m_abort_height);
+        for(std::size_t i = 0; i < VariableSet::num_vars; ++i) {
+            m_initial_width[i] = 0.0;
+            for(const VariableSet& v : m_basic) {
+                ivarp::IDouble x = v.get_variable(i);
+                m_initial_width[i] = (std::max)(m_initial_width[i], x.ub() - x.lb());
+            }
+        }
+        if(m_shard_count == 0) {
+            for(std::size_t i = 0; i < m_basic.size(); ++i) {
+                m_stack.push_back(StackElement(*this, m_basic[i], ++m_id_counter, m_basic_heights[i]));
+            }
+        } else {
+            setup_shard();
+        }
+        setup_checkpointing();
+        m_stats.peak_open_boxes = m_stack.size() + m_deferred.size();
+        m_progress.start(display_name(), initial_boxes_by_height());
+        setup_binary_trace();
+        setup_corpus();
+        setup_certificate();
+        setup_perf_counters();
+        setup_hot_subtrees();
+        m_timeline = timeline().active();
+        m_proof_begin_us = m_timeline ? timeline().now_us() : 0.0;
+        m_timeline_node = false;
+        m_last_offload = std::chrono::steady_clock::now();
+    }
+
+    std::string display_name() const {
+        return m_name + m_instance;
+    }
+
+    void apply_prover_options() {
+        const ProverOptions& options = default_prover_options();
+        if(options.max_height != 0) {
+            m_abort_height = options.max_height;
+        }
+        if(options.min_width > 0.0) {
+            m_resolution_limited = true;
+            for(std::size_t i = 0; i < VariableSet::num_vars; ++i) {
+                m_absolute_width_limit[i] = (std::max)(m_absolute_width_limit[i], options.min_width);
+            }
+        }
+        if(options.split_policy != SplitPolicy::DEFAULT) {
+            m_split_policy = options.split_policy;
+        }
+        if(options.adaptive_order) {
+            m_adaptive_order = true;
+        }
+        if(!options.trace_proof.empty() && options.trace_proof == m_name) {
+            trace(true);
+        }
+    }
+
+    /**
+     * Continue from the open boxes of a resumed checkpoint, if it was taken during this proof.
+     */
+    /**
+     * The boxes progress is measured against: the boxes this run starts with (e.g., the boxes
+     * of a shard or the box handed to a worker), or the whole domain when resuming a checkpoint.
+     */
+    std::vector<std::uint64_t> initial_boxes_by_height() const {
+        std::vector<std::uint64_t> by_height;
+        if(m_resumed) {
+            for(std::uint64_t height : m_basic_heights) {
+                ProgressMonitor::count_height(by_height, height);
+            }
+        } else {
+            for(const StackElement& e : m_stack) {
+                ProgressMonitor::count_height(by_height, e.height);
+            }
+            for(const StackElement& e : m_deferred) {
+                ProgressMonitor::count_height(by_height, e.height);
+            }
+        }
+        return by_height;
+    }
+
+    void setup_checkpointing() {
+        const CheckpointOptions& options = default_checkpoint_options();
+        m_checkpointing = !options.file.empty();
+        m_last_checkpoint = std::chrono::steady_clock::now();
+        m_resumed = false;
+        Checkpoint& resumed = resumed_checkpoint();
+        if(!options.resume || resumed.proof_name != m_name || m_basic.empty()) {
+            return;
+        }
+        m_stack.clear();
+        m_deferred.clear();
+        for(const Checkpoint::Box& box : resumed.boxes) {
+            if(box.bounds.size() != 2 * VariableSet::num_vars) {
+                throw std::runtime_error("Checkpoint box does not match the variables of proof '" + m_name + "'");
+            }
+            VariableSet domain = m_basic.front();
+            domain.assign_values(box.bounds.data());
+            (box.deferred ? m_deferred : m_stack).push_back(StackElement(*this, domain, 0, box.height));
+        }
+        m_stats.nodes = resumed.nodes;
+        m_id_counter = resumed.id_counter;
+        for(StackElement& e : m_stack) {
+            e.id = ++m_id_counter;
+        }
+        for(StackElement& e : m_deferred) {
+            e.id = ++m_id_counter;
+        }
+        m_height_limit = resumed.height_limit;
+        // the saved boxes are used only once
+        resumed.proof_name.clear();
+        resumed.boxes.clear();
+        m_resumed = true;
+    }
+
+    std::vector<std::string> completed_proofs() const {
+        std::vector<std::string> completed = resumed_checkpoint().completed;
+        std::lock_guard<std::mutex> lock(proof_run_records_mutex());
+        for(const ProofRunRecord& r : proof_run_records()) {
+            if(r.proved) {
+                completed.push_back(r.name);
+            }
+        }
+        return completed;
+    }
+
+    void periodic_checkpoint() {
+        auto now = std::chrono::steady_clock::now();
+        if(std::chrono::duration<double>(now - m_last_checkpoint).count() < default_checkpoint_options().interval) {
+            return;
+        }
+        m_last_checkpoint = now;
+        Checkpoint checkpoint;
+        checkpoint.completed = completed_proofs();
+        checkpoint.proof_name = m_name;
+        checkpoint.nodes = m_stats.nodes;
+        checkpoint.id_counter = m_id_counter;
+        checkpoint.height_limit = m_height_limit;
+        for(const StackElement& e : m_stack) {
+            checkpoint.boxes.push_back(Checkpoint::Box{e.height, false, box_bounds(e.domain)});
+        }
+        for(const StackElement& e : m_deferred) {
+            checkpoint.boxes.push_back(Checkpoint::Box{e.height, true, box_bounds(e.domain)});
+        }
+        if(m_certificate) {
+            // the leaves decided so far must be in the certificate before the checkpoint drops their boxes
+            m_certificate->flush();
+        }
+        checkpoint.write(default_checkpoint_options().file);
+    }
+
+    void final_checkpoint(bool result) {
+        if(!result) {
+            // keep the last checkpoint, so the failed proof can be rerun from there
+            return;
+        }
+        Checkpoint checkpoint;
+        checkpoint.completed = completed_proofs();
+        checkpoint.write(default_checkpoint_options().file);
+    }
+
+    void setup_certificate() {
+        m_certificate.reset();
+        std::string filename = m_certificate_file;
+        const ProverOptions& options = default_prover_options();
+        if(filename.empty() && !options.certificate_directory.empty() && !m_name.empty()) {
+            filename = options.certificate_directory + "/" + display_name() + ".cert";
+        }
+        if(filename.empty()) {
+            return;
+        }
+        TraceFileHeader header{std::uint32_t(VariableSet::num_vars), 0, m_name, {}};
+        for(const auto& c : m_constraints) {
+            header.constraint_names.push_back(c->name());
         }
+        // a resumed proof continues the certificate of the interrupted run
+        m_certificate = std::make_unique<BoxCorpusWriter>(filename, header, m_append_outputs || m_resumed);
     }
 
-    void trace_node(const StackElement& element) const {
+    void certify_leaf(const StackElement& element, TraceOutcome outcome) {
+        CorpusEntry record{};
+        record.constraint = std::uint32_t(m_deciding);
+        record.depth = std::uint32_t(element.height);
+        if(outcome == TraceOutcome::REFUTED) {
+            // the box as refuted by the checker, after propagation
+            record.result = std::uint8_t(CorpusResult::VIOLATED);
+            std::vector<double> bounds = box_bounds(element.domain);
+            m_certificate->push(record, bounds.data());
+        } else {
+            record.result = std::uint8_t(CorpusResult::EMPTIED);
+            m_certificate->push(record, m_certified_bounds);
+        }
+    }
+
+    bool budget_exhausted(std::chrono::steady_clock::time_point start) const {
+        if(m_max_nodes != 0 && m_stats.nodes >= m_max_nodes) {
+            return true;
+        }
+        // the clock is only read every offload_check_interval nodes
+        return m_max_seconds != 0.0 && (m_stats.nodes & (offload_check_interval - 1)) == 0 &&
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= m_max_seconds;
+    }
+
+    void offload() {
+        auto now = std::chrono::steady_clock::now();
+        if(std::chrono::duration<double>(now - m_last_offload).count() < m_offload_interval) {
+            return;
+        }
+        TimelineSpan span("offload", "io");
+        m_last_offload = now;
+        std::vector<ExpandedBox<VariableSet>> boxes;
+        std::size_t count = (m_stack.size() >= 2) ? m_stack.size() / 2 : 0;
+        for(std::size_t i = 0; i < count; ++i) {
+            boxes.push_back(ExpandedBox<VariableSet>{m_stack[i].domain, m_stack[i].height});
+        }
+        m_stack.erase(m_stack.begin(), m_stack.begin() + count);
+        m_offload_handler(std::move(boxes));
+    }
+
+    void setup_shard() {
+        std::vector<ExpandedBox<VariableSet>> expanded = expand_breadth_first(m_basic, m_shard_expansion);
+        m_shard_total_boxes = expanded.size();
+        m_shard_boxes.clear();
+        for(std::size_t k = m_shard_index; k < expanded.size(); k += m_shard_count) {
+            m_stack.push_back(StackElement(*this, expanded[k].domain, ++m_id_counter, expanded[k].height));
+            m_shard_boxes.push_back(ShardResult::Box{k, box_bounds(expanded[k].domain)});
+        }
+    }
+
+    void setup_binary_trace() {
+        m_binary_tracer.reset();
+        std::string filename = m_binary_trace_file;
+        const TraceOptions& options = default_trace_options();
+        if(filename.empty() && !options.trace_directory.empty() && !m_name.empty()) {
+            filename = options.trace_directory + "/" + display_name() + ".trace";
+        }
+        if(filename.empty()) {
+            return;
+        }
+        TraceFileHeader header{std::uint32_t(VariableSet::num_vars), std::uint32_t(sizeof(TraceRecordType)), m_name, {}};
+        for(const auto& c : m_constraints) {
+            header.constraint_names.push_back(c->name());
+        }
+        m_binary_tracer = std::make_unique<BinaryTraceWriter>(filename, header);
+    }
+
+    void setup_perf_counters() {
+        m_perf.reset();
+        if(!m_perf_requested && !default_perf_counter_options().enabled) {
+            return;
+        }
+        m_perf = std::make_unique<PerfCounters>();
+        PerfReport& report = m_stats.counters;
+        report.enabled = true;
+        for(std::size_t e = 0; e < num_perf_events; ++e) {
+            report.event_available[e] = m_perf->event_available(e);
+        }
+        report.constraints.resize(m_constraints.size());
+    }
+
+    void finish_perf_counters() {
+        if(m_perf && !m_perf->ever_scheduled()) {
+            for(bool& a : m_stats.counters.event_available) {
+                a = false;
+            }
+        }
+        m_perf.reset();
+    }
+
+    /**
+     * Run f, attributing the counters to the given phase if counters are enabled.
+     */
+    template<typename Callable> auto measured(ProverPhase phase, Callable&& f) {
+        if(!m_perf) {
+            return f();
+        }
+        CounterValues begin, end;
+        m_perf->read(begin);
+        auto result = f();
+        m_perf->read(end);
+        m_stats.counters.phases[std::size_t(phase)].add(begin, end);
+        return result;
+    }
+
+    void setup_corpus() {
+        m_corpus.reset();
+        std::string filename = m_corpus_file;
+        std::uint64_t interval = m_corpus_interval;
+        const CorpusOptions& options = default_corpus_options();
+        if(filename.empty() && !options.corpus_directory.empty() && !m_name.empty()) {
+            filename = options.corpus_directory + "/" + display_name() + ".corpus";
+            interval = (std::max)(options.sample_interval, std::uint64_t(1));
+        }
+        if(filename.empty()) {
+            return;
+        }
+        TraceFileHeader header{std::uint32_t(VariableSet::num_vars), 0, m_name, {}};
+        for(const auto& c : m_constraints) {
+            header.constraint_names.push_back(c->name());
+        }
+        m_corpus = std::make_unique<BoxCorpusWriter>(filename, header, m_append_outputs);
+        m_corpus_interval = interval;
+        m_corpus_countdown.assign(m_constraints.size(), interval);
+    }
+
+    void sample_corpus(const StackElement& element, const CheckerEntry& entry, ivarp::IBool result) {
+        if(--m_corpus_countdown[entry.index] != 0) {
+            return;
+        }
+        m_corpus_countdown[entry.index] = m_corpus_interval;
+        CorpusEntry record{};
+        record.constraint = std::uint32_t(entry.index);
+        record.depth = std::uint32_t(element.height);
+        record.result = std::uint8_t(corpus_result(result));
+        double bounds[2 * VariableSet::num_vars];
+        for(std::size_t i = 0; i < VariableSet::num_vars; ++i) {
+            ivarp::IDouble x = element.domain.get_variable(i);
+            bounds[2 * i] = x.lb();
+            bounds[2 * i + 1] = x.ub();
+        }
+        m_corpus->push(record, bounds);
+    }
+
+    void setup_hot_subtrees() {
+        const HotSubtreeOptions& options = default_hot_subtree_options();
+        m_hot.clear();
+        m_hottest.clear();
+        m_hot_print = (m_hot_depth == 0 && options.depth != 0);
+        if(m_hot_print) {
+            m_hot_depth = options.depth;
+            m_hot_top_k = options.top_k;
+        }
+        m_hot_active = (m_hot_depth != 0);
+    }
+
+    void count_hot_node(StackElement& element) {
+        if(element.subtree == no_subtree) {
+            if(element.height < m_hot_depth) {
+                return;
+            }
+            element.subtree = m_hot.size();
+            m_hot.emplace_back(element.domain, element.height, m_constraints.size());
+        }
+        ++m_hot[element.subtree].nodes;
+    }
+
+    void hot_leaf(const StackElement& element, TraceOutcome outcome) {
+        HotSubtree<VariableSet>& s = m_hot[element.subtree];
+        if(outcome == TraceOutcome::REFUTED || outcome == TraceOutcome::EMPTY_AFTER_PROPAGATION) {
+            if(m_deciding >= 0) {
+                ++s.decided_by[std::size_t(m_deciding)];
+            }
+        } else {
+            ++s.undecided;
+        }
+    }
+
+    void finish_hot_subtrees() {
+        std::size_t num_subtrees = m_hot.size();
+        m_hottest = select_hottest_subtrees(std::move(m_hot), m_hot_top_k);
+        m_hot.clear();
+        if(m_hot_print) {
+            std::cout << "Proof " << (m_name.empty() ? std::string("(unnamed)") : m_name) << ": ";
+            print_hot_subtrees(std::cout, m_hottest, num_subtrees, m_hot_depth, m_stats);
+            // the options apply again to the next proof
+            m_hot_depth = 0;
+        }
+    }
+
+    void begin_timeline_node() {
+        const TimelineOptions& options = default_timeline_options();
+        m_timeline_node = options.node_sample_interval != 0 && m_stats.nodes % options.node_sample_interval == 0;
+        if(m_timeline_node) {
+            m_timeline_node_begin_us = timeline().now_us();
+        }
+    }
+
+    void end_timeline_node(const StackElement& element, TraceOutcome outcome) {
+        m_timeline_node = false;
+        timeline().complete("node", "node", m_timeline_node_begin_us, timeline().now_us(),
+                            "\"id\": " + std::to_string(element.id) + ", \"depth\": " + std::to_string(element.height) +
+                            ", \"outcome\": \"" + trace_outcome_name(outcome) + "\"");
+    }
+
+    void node_done(const StackElement& element, TraceOutcome outcome) {
+        if(m_certificate && m_deciding >= 0 &&
+           (outcome == TraceOutcome::REFUTED || outcome == TraceOutcome::EMPTY_AFTER_PROPAGATION))
+        {
+            certify_leaf(element, outcome);
+        }
+        if(m_timeline_node) {
+            end_timeline_node(element, outcome);
+        }
+        if(outcome != TraceOutcome::SPLIT) {
+            m_progress.leaf(element.height);
+            if(outcome == TraceOutcome::SATISFIABLE || outcome == TraceOutcome::UNDECIDED) {
+                m_progress.unproven(element.height);
+            }
+            if(m_hot_active && element.subtree != no_subtree) {
+                hot_leaf(element, outcome);
+            }
+        }
+        if(m_binary_tracer) {
+            TraceRecordType record{};
+            record.node.id = element.id;
+            record.node.parent_id = element.parent_id;
+            record.node.depth = std::uint32_t(element.height);
+            record.node.outcome = std::uint8_t(outcome);
+            record.node.deciding_constraint =
+                (outcome == TraceOutcome::REFUTED || outcome == TraceOutcome::EMPTY_AFTER_PROPAGATION) ? m_deciding : -1;
+            for(std::size_t i = 0; i < VariableSet::num_vars; ++i) {
+                record.bounds[2 * i] = m_traced_bounds[i].lb();
+                record.bounds[2 * i + 1] = m_traced_bounds[i].ub();
+            }
+            m_binary_tracer->push(&record);
+        }
+    }
+
+    /**
+     * Drop all open boxes when the proof is aborted; their volume is left unproven.
+     */
+    void abandon_open_boxes() {
+        for(const StackElement& e : m_stack) {
+            m_progress.unproven(e.height);
+        }
+        for(const StackElement& e : m_deferred) {
+            m_progress.unproven(e.height);
+        }
+        m_stack.clear();
+        m_deferred.clear();
+    }
+
+    void report_progress() {
+        m_progress.begin_open_boxes();
+        for(const StackElement& e : m_stack) {
+            m_progress.open_box(e.height);
+        }
+        for(const StackElement& e : m_deferred) {
+            m_progress.open_box(e.height);
+        }
+        m_progress.report(m_height_limit, m_stats);
+    }
+
+    void trace_node(const StackElement& element) {
+        if(m_certificate) {
+            for(std::size_t i = 0; i < VariableSet::num_vars; ++i) {
+                m_certified_bounds[2 * i] = element.domain.get_variable(i).lb();
+                m_certified_bounds[2 * i + 1] = element.domain.get_variable(i).ub();
+            }
+        }
+        if(m_binary_tracer) {
+            for(std::size_t i = 0; i < VariableSet::num_vars; ++i) {
+                m_traced_bounds[i] = element.domain.get_variable(i);
+            }
+        }
         if constexpr(tracing_supported) {
             if(m_trace) {
                 std::string t = element.domain.trace_string(element.id, element.parent_id);
-                *m_tracer << t << std::endl;
+                *m_tracer << t << '\n';
             }
         }
     }
@@ -186,10 +971,18 @@ private:
         PropagateResult any_change;
         do {
             any_change = PropagateResult::UNCHANGED;
-            for(Constr* p : m_propagators) {
-                PropagateResult pr = p->propagate(element.domain);
+            for(const CheckerEntry& p : m_propagators) {
+                CounterValues counters_begin;
+                if(m_perf) {
+                    m_perf->read(counters_begin);
+                }
+                PropagateResult pr = p.constraint->propagate(element.domain);
+                if(m_perf) {
+                    constraint_measured(p, counters_begin);
+                }
                 any_change |= pr;
-                if(pr == PropagateResult::EMPTY) {
+                if((pr & PropagateResult::EMPTY) != PropagateResult::UNCHANGED) {
+                    m_deciding = p.index;
                     break;
                 }
             }
@@ -197,23 +990,134 @@ private:
         return (any_change & PropagateResult::EMPTY) != PropagateResult::UNCHANGED;
     }
 
-    ivarp::IBool run_checker_collection(const StackElement& element, const std::vector<Constr*>& collection) const {
+    void constraint_measured(const CheckerEntry& entry, const CounterValues& begin) {
+        CounterValues end;
+        m_perf->read(end);
+        m_stats.counters.constraints[std::size_t(entry.index)].add(begin, end);
+    }
+
+    bool find_split_variable(const StackElement& element, std::size_t& index) const noexcept {
+        std::size_t first = static_cast<std::size_t>(element.height % VariableSet::num_vars);
+        if(!m_resolution_limited && m_split_policy != SplitPolicy::WIDEST) {
+            index = first;
+            return true;
+        }
+        bool found = false;
+        double widest = 0.0;
+        for(std::size_t k = 0; k < VariableSet::num_vars; ++k) {
+            std::size_t i = (first + k) % VariableSet::num_vars;
+            ivarp::IDouble x = element.domain.get_variable(i);
+            double limit = (std::max)(m_absolute_width_limit[i], m_relative_width_limit[i] * m_initial_width[i]);
+            double c = x.center();
+            if(x.ub() - x.lb() > limit && x.lb() < c && c < x.ub()) {
+                if(m_split_policy != SplitPolicy::WIDEST) {
+                    index = i;
+                    return true;
+                }
+                double relative = (m_initial_width[i] > 0.0) ? (x.ub() - x.lb()) / m_initial_width[i] : 0.0;
+                if(!found || relative > widest) {
+                    found = true;
+                    widest = relative;
+                    index = i;
+                }
+            }
+        }
+        return found;
+    }
+
+    static bool outside_guard(const VariableSet& vars, const GuardBox& guard) noexcept {
+        for(std::size_t i = 0; i < VariableSet::num_vars; ++i) {
+            ivarp::IDouble v = vars.get_variable(i);
+            if(v.ub() < guard[i].lb() || v.lb() > guard[i].ub()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Evaluate a single checker (unless it can be skipped) and combine its result into cresult.
+     * Returns false if the checker refuted the box; the cost of the evaluation is stored in cost.
+     */
+    bool run_checker(StackElement& element, const CheckerEntry& entry, ivarp::IBool& cresult, std::uint64_t& cost) {
+        ConstraintStats& stats = *entry.stats;
+        cost = 0;
+        if(element.satisfied_checkers & entry.mask_bit) {
+            ++stats.inherited_skips;
+            return true;
+        }
+        if(entry.has_guard && outside_guard(element.domain, entry.guard)) {
+            ++stats.guard_skips;
+            element.satisfied_checkers |= entry.mask_bit;
+            return true;
+        }
+        CounterValues counters_begin;
+        if(m_perf) {
+            m_perf->read(counters_begin);
+        }
+        double timeline_begin = m_timeline ? timeline().now_us() : 0.0;
+        std::uint64_t begin = __rdtsc();
+        ivarp::IBool r = entry.constraint->satisfied(element.domain);
+        cost = __rdtsc() - begin;
+        if(m_timeline) {
+            double timeline_end = timeline().now_us();
+            if(timeline_end - timeline_begin >= default_timeline_options().constraint_threshold_us) {
+                timeline().complete(stats.name, "constraint", timeline_begin, timeline_end,
+                                    "\"node\": " + std::to_string(element.id));
+            }
+        }
+        if(m_perf) {
+            constraint_measured(entry, counters_begin);
+        }
+        stats.cost += cost;
+        ++stats.evaluations;
+        if(m_corpus) {
+            sample_corpus(element, entry, r);
+        }
+        cresult &= r;
+        if(!possibly(r)) {
+            ++stats.refutations;
+            m_deciding = entry.index;
+            return false;
+        }
+        if(definitely(r)) {
+            ++stats.definitely_satisfied;
+            element.satisfied_checkers |= entry.mask_bit;
+        }
+        return true;
+    }
+
+    ivarp::IBool run_checker_collection(StackElement& element, const std::vector<CheckerEntry>& collection) {
         ivarp::IBool cresult{true, true};
-        for(Constr* p : collection) {
-            ivarp::IBool r = p->satisfied(element.domain);
-            cresult &= r;
-            if(!possibly(r)) {
+        std::uint64_t cost;
+        for(const CheckerEntry& entry : collection) {
+            if(!run_checker(element, entry, cresult, cost)) {
                 break;
             }
         }
         return cresult;
     }
 
-    ivarp::IBool run_checkers(const StackElement& element) const {
-        return run_checker_collection(element, m_checkers);
+    ivarp::IBool run_checkers(StackElement& element) {
+        if(!m_adaptive_order) {
+            return run_checker_collection(element, m_checkers);
+        }
+        ivarp::IBool cresult{true, true};
+        std::uint64_t cost;
+        for(std::size_t index : m_order.order(element.height)) {
+            bool not_refuted = run_checker(element, m_checkers[index], cresult, cost);
+            if(cost != 0) {
+                m_order.record(element.height, index, cost, !not_refuted);
+            }
+            if(!not_refuted) {
+                break;
+            }
+        }
+        m_order.node_done();
+        return cresult;
     }
 
-    ivarp::IBool run_propagators_as_checkers(const StackElement& element) const {
+    ivarp::IBool run_propagators_as_checkers(StackElement& element) {
         return run_checker_collection(element, m_propagators);
     }
 
@@ -226,14 +1130,73 @@ private:
     }
 
     std::vector<VariableSet> m_basic;
+    std::vector<std::uint64_t> m_basic_heights;
     std::vector<ConstrPtr> m_constraints;
-    std::vector<Constr*> m_propagators;
-    std::vector<Constr*> m_checkers;
+    std::vector<CheckerEntry> m_propagators;
+    std::vector<CheckerEntry> m_checkers;
     std::vector<StackElement> m_stack;
+    std::vector<StackElement> m_deferred;
     std::function<void(const VariableSet&, bool)> m_reporter = &default_report_function;
     bool m_abort_satisfiable = false;
     bool m_trace = false;
     std::ostream *m_tracer = &std::cout;
     std::uint64_t m_abort_height = std::numeric_limits<std::uint64_t>::max();
     std::uint64_t m_id_counter = 0;
+    ProofStats m_stats;
+    bool m_adaptive_order = false;
+    std::uint64_t m_resort_interval = 4096;
+    AdaptiveConstraintOrder m_order;
+    bool m_resolution_limited = false;
+    double m_absolute_width_limit[VariableSet::num_vars] = {};
+    double m_relative_width_limit[VariableSet::num_vars] = {};
+    double m_initial_width[VariableSet::num_vars] = {};
+    std::uint64_t m_deepening_initial = 0;
+    std::uint64_t m_deepening_step = 0;
+    std::string m_name;
+    ProgressMonitor m_progress;
+    using TraceRecordType = TraceRecord<VariableSet::num_vars>;
+    std::string m_binary_trace_file;
+    std::unique_ptr<BinaryTraceWriter> m_binary_tracer;
+    ivarp::IDouble m_traced_bounds[VariableSet::num_vars];
+    std::int32_t m_deciding = -1;
+    std::string m_corpus_file;
+    std::uint64_t m_corpus_interval = 64;
+    std::unique_ptr<BoxCorpusWriter> m_corpus;
+    std::vector<std::uint64_t> m_corpus_countdown;
+    bool m_perf_requested = false;
+    bool m_timeline = false;
+    std::string m_instance;
+    SplitPolicy m_split_policy = SplitPolicy::DEFAULT;
+    bool m_checkpointing = false;
+    bool m_resumed = false;
+    bool m_append_outputs = false;
+    std::chrono::steady_clock::time_point m_last_checkpoint;
+    std::string m_certificate_file;
+    std::unique_ptr<BoxCorpusWriter> m_certificate;
+    double m_certified_bounds[2 * VariableSet::num_vars] = {};
+    std::vector<std::size_t> m_disabled;
+    std::uint64_t m_max_nodes = 0;
+    double m_max_seconds = 0.0;
+    bool m_budgeted = false;
+    bool m_budget_exceeded = false;
+    std::uint64_t m_hot_depth = 0;
+    std::size_t m_hot_top_k = 10;
+    bool m_hot_active = false;
+    bool m_hot_print = false;
+    std::vector<HotSubtree<VariableSet>> m_hot;
+    std::vector<HotSubtree<VariableSet>> m_hottest;
+    bool m_timeline_node = false;
+    double m_proof_begin_us = 0.0;
+    double m_timeline_node_begin_us = 0.0;
+    std::unique_ptr<PerfCounters> m_perf;
+    std::size_t m_shard_index = 0;
+    std::size_t m_shard_count = 0;
+    std::size_t m_shard_expansion = 0;
+    std::size_t m_shard_total_boxes = 0;
+    std::vector<ShardResult::Box> m_shard_boxes;
+    static constexpr std::uint64_t offload_check_interval = 1024;
+    double m_offload_interval = 0.0;
+    std::function<void(std::vector<ExpandedBox<VariableSet>>&&)> m_offload_handler;
+    std::chrono::steady_clock::time_point m_last_offload;
+    std::uint64_t m_height_limit = std::numeric_limits<std::uint64_t>::max();
 };
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * How the prover chooses the variable to bisect.
+ */
+enum class SplitPolicy {
+    DEFAULT,     //< the split of the variable set (round robin by height for all current variable sets)
+    ROUND_ROBIN, //< round robin by height, skipping variables at their resolution limit
+    WIDEST       //< the variable with the largest width relative to its initial width
+};
+
+/**
+ * Process-wide settings that override those of every prover, set from the command line;
+ * zero or empty values leave the settings made by the proof functions in place.
+ */
+struct ProverOptions {
+    std::uint64_t max_height = 0;       //< replaces abort_at_height
+    double min_width = 0.0;             //< absolute resolution limit for all variables
+    SplitPolicy split_policy = SplitPolicy::DEFAULT;
+    bool adaptive_order = false;        //< enable adaptive_constraint_order
+    std::string trace_proof;            //< print a text trace of the proof with this name
+    std::string certificate_directory;  //< write a certificate file per proof to this directory
+};
+
+inline ProverOptions& default_prover_options() noexcept {
+    static ProverOptions options;
+    return options;
+}
@@ -18,6 +18,7 @@
 #pragma once
 #include "constraint.hpp"
 #include "rectangle_cover.hpp"
+#include "generated/r1_in_center_kernels.hpp"
 
 struct R1InCenterChecker {
     using IBool = ivarp::IBool;
@@ -30,8 +31,8 @@ struct R1InCenterChecker {
         r2(vset.get_r2()),
         r3(vset.get_r3()),
         weight(vset.weight),
-        x5(vset.tan_alpha_half),
-        x6(vset.cos_alpha)
+        tan_alpha_half(vset.tan_alpha_half),
+        cos_alpha(vset.cos_alpha)
     {}
 
     IBool routine_fails() {
@@ -96,37 +97,27 @@ struct R1InCenterChecker {
                                      min_weight_for_pockets, IDouble{0.0, r3.ub()});
     }
 
+    // the kernels are generated from kernels/r1_in_center.kernels
     void compute_chi1() {
-        x0 = 0.5 * alpha;
-        x1 = ivarp::sin(x0);
-        x4 = ivarp::cos(x0);
-        x2 = x1 + 1.0;
-        x3 = 1.0 / x2;
-        chi_1 = x3*(r1*x1 + r1 - 0.5 * x4);
+        R1InCenterChi1 result = r1_in_center_chi1(alpha, r1);
+        chi_1 = result.chi_1;
+        sin_alpha_half = result.sin_half_alpha;
+        cos_alpha_half = result.cos_half_alpha;
     }
 
     void compute_remaining_sizes() {
-        x7 = ivarp::square(r1);
-        x8 = 8.0 * x7;
-        x9 = 4.0 * x7;
-        x10 = ivarp::square(x5) * x9;
-        x11 = x4 * ivarp::sqrt((16.0*x1*x7 + x10*x6 + x10 - x6 + x8 - 1.0)/(x6 + 1.0));
-        x12 = x1 - 1.0;
-        x13 = x12 * x5;
-        x14 = 0.5 / x4;
-        x15 = ivarp::square(x4);
-        x16 = x14 * (x2 - x11);
-        remaining_triangle_half_base = x14*(x13*(x11 + x2) + x4);
-        remaining_triangle_height = remaining_triangle_half_base/x5;
-        remaining_pocket_width = -x12*x16;
-        IDouble right_pocket_height = 0.5*x3*(x2 - ivarp::sqrt(x1*x8 - x15*x9 - x15 + x8));
-        IDouble left_pocket_height = -x13*x16;
-        remaining_pocket_height = ivarp::max(right_pocket_height, left_pocket_height);
+        R1InCenterRemainingSizes sizes =
+            r1_in_center_remaining_sizes(sin_alpha_half, cos_alpha_half, tan_alpha_half, cos_alpha, r1);
+        r1sq = sizes.r1_squared;
+        remaining_triangle_half_base = sizes.remaining_triangle_half_base;
+        remaining_triangle_height = sizes.remaining_triangle_height;
+        remaining_pocket_width = sizes.remaining_pocket_width;
+        remaining_pocket_height = sizes.remaining_pocket_height;
         r2sq = ivarp::square(r2);
         r3sq = ivarp::square(r3);
         pocket_weight_bound = 0.25 * (ivarp::square(remaining_pocket_width) + ivarp::square(remaining_pocket_height));
         weight_for_triangle = compute_weight_for_triangle();
-        rw1 = weight - x7;
+        rw1 = weight - r1sq;
         rw2 = rw1 - r2sq;
         rw3 = rw2 - r3sq;
     }
@@ -148,36 +139,11 @@ struct R1InCenterChecker {
     IDouble remaining_triangle_height, remaining_triangle_half_base;
     IDouble remaining_pocket_height;
     IDouble remaining_pocket_width;
-    IDouble x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15, x16;
-    IDouble r2sq, r3sq;
+    IDouble sin_alpha_half, cos_alpha_half, tan_alpha_half, cos_alpha;
+    IDouble r1sq, r2sq, r3sq;
     IDouble pocket_weight_bound, weight_for_triangle;
     IDouble rw1, rw2, rw3;
     IBool r3pocket, r2pocket, r2triangle;
-    /*
-     * sympy.cse([chi_1_v, remaining_triangle_halpha, pocket_height, pocket_width, left_pocket_height])
-     *   ([(x0, alpha/2),
-     *     (x1, sin(x0)),
-     *     (x2, x1 + 1),
-     *     (x3, 1/x2),
-     *     (x4, cos(x0)),
-     *     (x5, tan(x0)),
-     *     (x6, cos(alpha)),
-     *     (x7, r_1**2),
-     *     (x8, 8*x7),
-     *     (x9, 4*x7),
-     *     (x10, x5**2*x9),
-     *     (x11, x4*sqrt((16*x1*x7 + x10*x6 + x10 - x6 + x8 - 1)/(x6 + 1))),
-     *     (x12, x1 - 1),
-     *     (x13, x12*x5),
-     *     (x14, 1/(2*x4)),
-     *     (x15, x4**2),
-     *     (x16, x14*(-x11 + x2))],
-     *    [x3*(r_1*x1 + r_1 - x4/2), #chi_1
-     *     x14*(x13*(x11 + x2) + x4)/x5, #remaining_triangle_height
-     *     x3*(x2 - sqrt(x1*x8 - x15*x9 - x15 + x8))/2, # pocket_height
-     *     -x12*x16, # pocket_width
-     *     -x13*x16]) # left_pocket_height
-     */
 };
 
 
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Helpers shared by the binary record files (traces, corpora and certificates):
+ * each file starts with 8 magic bytes and a TraceFileHeader, followed by fixed-size
+ * records in native byte order until the end of the file.
+ * The header consists of num_vars and record_size (little-endian uint32), the proof name
+ * and the constraint names (each prefixed with its uint32 length).
+ */
+struct TraceFileCloser {
+    void operator()(std::FILE* file) const noexcept {
+        std::fclose(file);
+    }
+};
+
+using TraceFilePtr = std::unique_ptr<std::FILE, TraceFileCloser>;
+
+using RecordFileMagic = char[8];
+
+struct TraceFileHeader {
+    std::uint32_t num_vars;
+    std::uint32_t record_size;
+    std::string proof_name;
+    std::vector<std::string> constraint_names;
+};
+
+namespace impl {
+    inline void write_u32(std::FILE* file, std::uint32_t value) {
+        unsigned char bytes[4] = {
+            static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8),
+            static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24)
+        };
+        std::fwrite(bytes, 1, 4, file);
+    }
+
+    inline void write_string(std::FILE* file, const std::string& s) {
+        write_u32(file, static_cast<std::uint32_t>(s.size()));
+        std::fwrite(s.data(), 1, s.size(), file);
+    }
+
+    inline std::uint32_t read_u32(std::FILE* file, const char* kind) {
+        unsigned char bytes[4];
+        if(std::fread(bytes, 1, 4, file) != 4) {
+            throw std::runtime_error(std::string("Truncated ") + kind + " file header");
+        }
+        return std::uint32_t(bytes[0]) | (std::uint32_t(bytes[1]) << 8) |
+               (std::uint32_t(bytes[2]) << 16) | (std::uint32_t(bytes[3]) << 24);
+    }
+
+    inline std::string read_string(std::FILE* file, const char* kind) {
+        std::string result(read_u32(file, kind), '\0');
+        if(!result.empty() && std::fread(&result[0], 1, result.size(), file) != result.size()) {
+            throw std::runtime_error(std::string("Truncated ") + kind + " file header");
+        }
+        return result;
+    }
+}
+
+/**
+ * Write the magic bytes and the header.
+ */
+inline void write_record_file_header(std::FILE* file, const RecordFileMagic& magic, const TraceFileHeader& header) {
+    std::fwrite(magic, 1, sizeof(RecordFileMagic), file);
+    impl::write_u32(file, header.num_vars);
+    impl::write_u32(file, header.record_size);
+    impl::write_string(file, header.proof_name);
+    impl::write_u32(file, static_cast<std::uint32_t>(header.constraint_names.size()));
+    for(const std::string& n : header.constraint_names) {
+        impl::write_string(file, n);
+    }
+}
+
+/**
+ * Check the magic bytes and read the header; kind ("trace", "corpus", ...) is used in error messages.
+ */
+inline TraceFileHeader read_record_file_header(std::FILE* file, const RecordFileMagic& magic,
+                                               const std::string& filename, const char* kind)
+{
+    char read_magic[sizeof(RecordFileMagic)];
+    if(std::fread(read_magic, 1, sizeof(read_magic), file) != sizeof(read_magic) ||
+       std::memcmp(read_magic, magic, sizeof(read_magic)) != 0)
+    {
+        throw std::runtime_error("'" + filename + "' is not a " + kind + " file");
+    }
+    TraceFileHeader header;
+    header.num_vars = impl::read_u32(file, kind);
+    header.record_size = impl::read_u32(file, kind);
+    header.proof_name = impl::read_string(file, kind);
+    std::uint32_t num_constraints = impl::read_u32(file, kind);
+    for(std::uint32_t i = 0; i < num_constraints; ++i) {
+        header.constraint_names.push_back(impl::read_string(file, kind));
+    }
+    return header;
+}
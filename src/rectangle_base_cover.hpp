@@ -113,7 +113,8 @@ template<typename VariableSet> struct R1R2RectangleBaseCover : Constraint<Variab
         const IDouble alpha = vset.get_alpha(), r1 = vset.get_r1(), r2 = vset.get_r2();
         IDouble r1sq = ivarp::square(r1);
         IDouble r2sq = ivarp::square(r2);
-        IDouble covered_width_sq = -16*(ivarp::square(r1sq) + ivarp::square(r2sq)) + 32*r1sq*r2sq + 8*r1sq + 8*r2sq - 1;
+        IDouble covered_width_sq = fma(ivarp::square(r1sq) + ivarp::square(r2sq), -16,
+                                       fma(32*r1sq, r2sq, fma(r1sq, 8, fma(r2sq, 8, IDouble(-1.0)))));
         IBool can_cover_rect = (covered_width_sq >= 0);
         if(!possibly(can_cover_rect)) {
             return {true, true};
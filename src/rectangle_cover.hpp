@@ -18,6 +18,7 @@
 #pragma once
 
 #include <ivarp_ia/ivarp_ia.hpp>
+#include <cmath>
 
 namespace impl {
     using ivarp::IDouble;
@@ -38,6 +39,25 @@ namespace impl {
         }
 
         IBool check() noexcept {
+            IBool tabulated = check_tabulated();
+            if(definitely(tabulated) || !possibly(tabulated)) {
+                return tabulated;
+            }
+            return check_exact();
+        }
+
+        /**
+         * Check the weight against the minimum of the weights required by Thm 1, Lemma 3 and Lemma 4,
+         * taking Thm 1 and the factor of Lemma 3 from the table; indeterminate if lambda or r1
+         * are not covered by the table (or the result is too close to call).
+         */
+        IBool check_tabulated() const noexcept;
+
+        /**
+         * Check the weight against Thm 1, Lemma 3 and Lemma 4, computing the required weights
+         * on the box; the result of check_tabulated must never contradict this.
+         */
+        IBool check_exact() noexcept {
             compute_thm1_weight();
             IBool thm1 = (weight >= thm1_weight_needed);
             if(definitely(thm1)) {
@@ -50,49 +70,68 @@ namespace impl {
             return check_lem4() || thm1 || lem3;
         }
 
+        /**
+         * The weight required by Thm 1 for a rectangle with normalized side lengths 1 and lambda;
+         * nondecreasing in lambda.
+         */
+        static IDouble thm1_weight(IDouble lambda) noexcept {
+            IBool lambda_switch = (lambda > thm1_lambda_switch_value);
+            if(definitely(lambda_switch)) {
+                return thm1_weight_above_switch(lambda);
+            } else if(!possibly(lambda_switch)) {
+                return thm1_weight_below_switch(lambda);
+            } else {
+                return join(thm1_weight_below_switch(lambda), thm1_weight_above_switch(lambda));
+            }
+        }
+
+        /**
+         * The factor by which Lemma 3 multiplies lambda to obtain the required weight;
+         * nondecreasing in the normalized radius r1 >= 0.
+         */
+        static IDouble lem3_factor(IDouble r1) noexcept {
+            IDouble sigma = (ivarp::max)(square(r1), lem3_sigma_hat);
+            return 0.5 * ivarp::sqrt(ivarp::sqrt(ivarp::square(sigma) + 1.0) + 1.0);
+        }
+
     private:
         static const IDouble thm1_lambda_switch_value;
         static const IDouble lem3_sigma_hat;
         static const IDouble lem4_efficiency;
 
-        IDouble thm1_weight_below_switch() const noexcept {
+        static IDouble thm1_weight_below_switch(IDouble lambda) noexcept {
             IDouble lsq = square(lambda);
-            return (3.0 / 16.0) * lsq + (15.0 / 32.0) + (27.0 / 256.0) / lsq;
+            return fma(lsq, 3.0 / 16.0, (15.0 / 32.0) + (27.0 / 256.0) / lsq);
         }
 
-        IDouble thm1_weight_above_switch() const noexcept {
+        static IDouble thm1_weight_above_switch(IDouble lambda) noexcept {
             IDouble lsq = square(lambda);
             return 0.25 * (lsq + 2.0);
         }
 
         void compute_thm1_weight() noexcept {
-            IBool lambda_switch = (lambda > thm1_lambda_switch_value);
-            if(definitely(lambda_switch)) {
-                thm1_weight_needed = thm1_weight_above_switch();
-            } else if(!possibly(lambda_switch)) {
-                thm1_weight_needed = thm1_weight_below_switch();
-            } else {
-                thm1_weight_needed = join(thm1_weight_below_switch(), thm1_weight_above_switch());
-            }
+            thm1_weight_needed = thm1_weight(lambda);
         }
 
         IBool check_lem3() noexcept {
-            IDouble sigma = (ivarp::max)(square(r1), lem3_sigma_hat);
-            IDouble eff_sigma = 0.5 * ivarp::sqrt(ivarp::sqrt(ivarp::square(sigma) + 1.0) + 1.0);
-            IDouble weight_req = lambda * eff_sigma;
+            IDouble weight_req = lambda * lem3_factor(r1);
             return weight >= weight_req;
         }
 
-        IBool check_lem4() noexcept {
+        IDouble lem4_weight() const noexcept {
             if(r1.ub() <= 0.375) {
-                return weight >= lem4_efficiency * lambda;
+                return lem4_efficiency * lambda;
             } else {
                 IDouble necessary_side_length = r1 / 0.375;
                 IDouble long_side = ivarp::max(necessary_side_length, lambda);
-                return weight >= lem4_efficiency * long_side * necessary_side_length;
+                return lem4_efficiency * long_side * necessary_side_length;
             }
         }
 
+        IBool check_lem4() noexcept {
+            return weight >= lem4_weight();
+        }
+
         // unnormalized values
         IDouble raw_min, raw_max, raw_weight, raw_r1;
         // normalized values
@@ -119,6 +158,77 @@ namespace impl {
                 0.6100000000000000976996261670137755572795867919921875};
 }
 
+namespace impl {
+    /**
+     * Certified enclosures of the weight required by Thm 1 at lambda = 1 + i/resolution
+     * and of the factor of Lemma 3 at r1 = j/resolution. Both functions are nondecreasing,
+     * so the entries at the grid points around an interval bound the function on the interval.
+     */
+    template<typename Ignored> struct RectangleCoverTable {
+        static constexpr int resolution = 1024;
+        static constexpr int lambda_entries = 4 * resolution + 1;   //< lambda in [1, 5]
+        static constexpr int r1_entries = 4 * resolution + 1;       //< r1 in [0, 4]
+
+        IDouble thm1_weight[lambda_entries];
+        IDouble lem3_factor[r1_entries];
+
+        RectangleCoverTable() noexcept {
+            for(int i = 0; i < lambda_entries; ++i) {
+                thm1_weight[i] = RectangleCoverChecker<Ignored>::thm1_weight(IDouble(1.0 + double(i) / resolution));
+            }
+            for(int j = 0; j < r1_entries; ++j) {
+                lem3_factor[j] = RectangleCoverChecker<Ignored>::lem3_factor(IDouble(double(j) / resolution));
+            }
+        }
+
+        /**
+         * The table is built on first use, i.e., in a thread that has already set up
+         * the floating-point environment for interval arithmetic.
+         */
+        static const RectangleCoverTable& get() noexcept {
+            static const RectangleCoverTable table;
+            return table;
+        }
+
+        /**
+         * Find the indices i0 <= i1 of the grid points x0 + i/resolution enclosing x;
+         * returns false if x is not covered by the entries.
+         */
+        static bool grid_range(IDouble x, double x0, int entries, int& i0, int& i1) noexcept {
+            double f0 = std::floor((x.lb() - x0) * resolution);
+            double f1 = std::ceil((x.ub() - x0) * resolution);
+            if(!(f0 >= 0.0) || !(f1 <= double(entries - 1))) {
+                return false;
+            }
+            i0 = static_cast<int>(f0);
+            i1 = static_cast<int>(f1);
+            // the grid points are exact, but f0 and f1 may have been rounded
+            if(x0 + double(i0) / resolution > x.lb()) {
+                --i0;
+            }
+            if(x0 + double(i1) / resolution < x.ub()) {
+                ++i1;
+            }
+            return i0 >= 0 && i1 < entries;
+        }
+    };
+
+    template<typename Ignored> IBool RectangleCoverChecker<Ignored>::check_tabulated() const noexcept {
+        using Table = RectangleCoverTable<Ignored>;
+        int l0, l1, r0, r1_index;
+        if(!(r1.lb() >= 0.0) || !Table::grid_range(lambda, 1.0, Table::lambda_entries, l0, l1) ||
+           !Table::grid_range(r1, 0.0, Table::r1_entries, r0, r1_index))
+        {
+            return {false, true};
+        }
+        const Table& table = Table::get();
+        IDouble thm1_req(table.thm1_weight[l0].lb(), table.thm1_weight[l1].ub());
+        IDouble lem3_req = lambda * IDouble(table.lem3_factor[r0].lb(), table.lem3_factor[r1_index].ub());
+        IDouble required = (ivarp::min)((ivarp::min)(thm1_req, lem3_req), lem4_weight());
+        return weight >= required;
+    }
+}
+
 static inline ivarp::IBool rectangle_cover_works(ivarp::IDouble width, ivarp::IDouble height,
                                                  ivarp::IDouble weight, ivarp::IDouble r1)
 {
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <iostream>
+#include <exception>
+#include <algorithm>
+#include "sharding.hpp"
+#include "below_45_isoceles.hpp"
+
+/**
+ * Combine the result files of a sharded below-45 proof.
+ * Checks that all shards succeeded and that, together, they handled exactly
+ * the boxes of the expansion (recomputed here), which cover the initial domain.
+ */
+static bool merge_shards(const std::vector<ShardResult>& results) {
+    const ShardResult& first = results.front();
+    bool ok = true;
+    for(const ShardResult& r : results) {
+        if(r.proof_name != "below45") {
+            std::cerr << "Unsupported proof '" << r.proof_name << "'" << std::endl;
+            return false;
+        }
+        if(r.shard_count != first.shard_count || r.expansion != first.expansion) {
+            std::cerr << "Shard " << r.shard_index << " was run with a different shard count or expansion" << std::endl;
+            return false;
+        }
+    }
+
+    std::vector<int> shard_seen(first.shard_count, 0);
+    for(const ShardResult& r : results) {
+        if(r.shard_index >= first.shard_count || shard_seen[r.shard_index]++) {
+            std::cerr << "Shard " << r.shard_index << " is duplicate or out of range" << std::endl;
+            ok = false;
+        }
+        if(!r.proved) {
+            std::cerr << "Shard " << r.shard_index << " failed" << std::endl;
+            ok = false;
+        }
+    }
+    for(std::size_t i = 0; i < first.shard_count; ++i) {
+        if(!shard_seen[i]) {
+            std::cerr << "Shard " << i << " is missing" << std::endl;
+            ok = false;
+        }
+    }
+
+    std::vector<std::vector<double>> expansion = below45_shard_expansion(first.expansion);
+    std::vector<int> box_seen(expansion.size(), 0);
+    for(const ShardResult& r : results) {
+        if(r.total_boxes != expansion.size()) {
+            std::cerr << "Shard " << r.shard_index << " expanded into " << r.total_boxes
+                      << " boxes instead of " << expansion.size() << std::endl;
+            return false;
+        }
+        for(const ShardResult::Box& b : r.boxes) {
+            if(b.index >= expansion.size() || b.index % r.shard_count != r.shard_index ||
+               b.bounds != expansion[b.index])
+            {
+                std::cerr << "Shard " << r.shard_index << " handled box " << b.index
+                          << ", which does not match the expansion" << std::endl;
+                ok = false;
+            } else {
+                ++box_seen[b.index];
+            }
+        }
+    }
+    std::size_t missing = std::count(box_seen.begin(), box_seen.end(), 0);
+    if(missing != 0) {
+        std::cerr << missing << " boxes of the expansion were not handled by any shard" << std::endl;
+        ok = false;
+    }
+
+    std::uint64_t nodes = 0;
+    double total_seconds = 0.0, max_seconds = 0.0;
+    for(const ShardResult& r : results) {
+        nodes += r.nodes;
+        total_seconds += r.seconds;
+        max_seconds = (std::max)(max_seconds, r.seconds);
+    }
+    std::cout << results.size() << " shards, " << expansion.size() << " boxes, " << nodes << " nodes, "
+              << total_seconds << "s total, " << max_seconds << "s longest shard" << std::endl;
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    if(argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " RESULT_FILE..." << std::endl;
+        return 2;
+    }
+    ivarp::setup_floating_point_environment();
+    std::vector<ShardResult> results;
+    try {
+        for(int i = 1; i < argc; ++i) {
+            results.push_back(ShardResult::read(argv[i]));
+        }
+    } catch(const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    if(!merge_shards(results)) {
+        std::cerr << "The shards do NOT prove the below-45 case!" << std::endl;
+        return 1;
+    }
+    std::cout << "The shards together prove the below-45 case." << std::endl;
+    return 0;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "timeline.hpp"
+
+/**
+ * Static sharding: the initial boxes of a proof are split breadth-first
+ * (deterministically, using the split rule of the variable set) until there are
+ * at least `expansion` boxes; shard i of N proves the boxes whose index is i modulo N.
+ */
+struct ShardOptions {
+    std::size_t index = 0;
+    std::size_t count = 0;          //< 0 if sharding is disabled
+    std::size_t expansion = 4096;   //< minimum number of boxes to expand the initial boxes into
+    std::string result_file;        //< defaults to <proof>_shard_<i>_of_<N>.result
+    std::size_t threads = 1;        //< number of in-process shards proved concurrently (independent of index/count)
+
+    bool active() const noexcept {
+        return count != 0;
+    }
+
+    std::string result_file_for(const std::string& proof_name) const {
+        if(!result_file.empty()) {
+            return result_file;
+        }
+        return proof_name + "_shard_" + std::to_string(index) + "_of_" + std::to_string(count) + ".result";
+    }
+};
+
+inline ShardOptions& default_shard_options() noexcept {
+    static ShardOptions options;
+    return options;
+}
+
+/**
+ * Parse a shard specification of the form i/N with 0 <= i < N.
+ */
+inline bool parse_shard_spec(const std::string& spec, std::size_t& index, std::size_t& count) {
+    std::size_t slash = spec.find('/');
+    if(slash == std::string::npos || slash == 0 || slash + 1 == spec.size()) {
+        return false;
+    }
+    char* end;
+    unsigned long long i = std::strtoull(spec.c_str(), &end, 10);
+    if(end != spec.c_str() + slash) {
+        return false;
+    }
+    unsigned long long n = std::strtoull(spec.c_str() + slash + 1, &end, 10);
+    if(*end != '\0' || n == 0 || i >= n) {
+        return false;
+    }
+    index = std::size_t(i);
+    count = std::size_t(n);
+    return true;
+}
+
+template<typename VariableSet> struct ExpandedBox {
+    VariableSet domain;
+    std::uint64_t height;
+};
+
+/**
+ * Split the given initial boxes breadth-first until there are at least target boxes.
+ * The result only depends on the initial boxes and target.
+ * No propagators or checkers are run during the expansion, so the expanded boxes
+ * are generally not nodes of the sequential search: near the root, that search may
+ * narrow a box by propagation or refute it before the expansion height is reached.
+ * The expanded boxes still partition the initial boxes, which is all the shard
+ * merge relies on; the node counts of a sharded proof differ slightly from the
+ * sequential proof.
+ */
+template<typename VariableSet>
+    std::vector<ExpandedBox<VariableSet>> expand_breadth_first(const std::vector<VariableSet>& roots, std::size_t target)
+{
+    std::deque<ExpandedBox<VariableSet>> queue;
+    for(const VariableSet& r : roots) {
+        queue.push_back(ExpandedBox<VariableSet>{r, 0});
+    }
+    while(!queue.empty() && queue.size() < target) {
+        ExpandedBox<VariableSet> box = queue.front();
+        queue.pop_front();
+        box.domain.split([&] (VariableSet split_domain) {
+            queue.push_back(ExpandedBox<VariableSet>{std::move(split_domain), box.height + 1});
+        }, box.height);
+    }
+    return std::vector<ExpandedBox<VariableSet>>(queue.begin(), queue.end());
+}
+
+/**
+ * The bounds (lb_0, ub_0, lb_1, ub_1, ...) of an expanded box.
+ */
+template<typename VariableSet> std::vector<double> box_bounds(const VariableSet& vars) {
+    std::vector<double> result;
+    for(std::size_t i = 0; i < VariableSet::num_vars; ++i) {
+        result.push_back(vars.get_variable(i).lb());
+        result.push_back(vars.get_variable(i).ub());
+    }
+    return result;
+}
+
+/**
+ * The result of proving one shard; written by each shard and read by the merge tool.
+ * Bounds are written as hexadecimal floating-point numbers so they are reproduced exactly.
+ */
+struct ShardResult {
+    struct Box {
+        std::size_t index;
+        std::vector<double> bounds;
+    };
+
+    std::string proof_name;
+    std::size_t shard_index = 0;
+    std::size_t shard_count = 0;
+    std::size_t expansion = 0;
+    std::size_t total_boxes = 0;
+    bool proved = false;
+    std::uint64_t nodes = 0;
+    double seconds = 0.0;
+    std::vector<Box> boxes;
+
+    void write(const std::string& filename) const {
+        TimelineSpan span("write shard result", "io");
+        std::string tmp_name = filename + ".tmp";
+        {
+            std::ofstream output(tmp_name, std::ios::out | std::ios::trunc);
+            output << "proof " << proof_name << '\n'
+                   << "shard " << shard_index << ' ' << shard_count << '\n'
+                   << "expansion " << expansion << ' ' << total_boxes << '\n'
+                   << "result " << (proved ? "proved" : "failed") << '\n'
+                   << "nodes " << nodes << '\n'
+                   << "seconds " << seconds << '\n';
+            output << std::hexfloat;
+            for(const Box& b : boxes) {
+                output << "box " << b.index;
+                for(double d : b.bounds) {
+                    output << ' ' << d;
+                }
+                output << '\n';
+            }
+            if(!output) {
+                throw std::runtime_error("Could not write shard result file '" + filename + "'");
+            }
+        }
+        if(std::rename(tmp_name.c_str(), filename.c_str()) != 0) {
+            throw std::runtime_error("Could not write shard result file '" + filename + "'");
+        }
+    }
+
+    static ShardResult read(const std::string& filename) {
+        std::ifstream input(filename);
+        if(!input) {
+            throw std::runtime_error("Could not open shard result file '" + filename + "'");
+        }
+        ShardResult result;
+        std::string line;
+        while(std::getline(input, line)) {
+            std::istringstream fields(line);
+            std::string key;
+            fields >> key;
+            if(key == "proof") {
+                fields >> result.proof_name;
+            } else if(key == "shard") {
+                fields >> result.shard_index >> result.shard_count;
+            } else if(key == "expansion") {
+                fields >> result.expansion >> result.total_boxes;
+            } else if(key == "result") {
+                std::string r;
+                fields >> r;
+                result.proved = (r == "proved");
+            } else if(key == "nodes") {
+                fields >> result.nodes;
+            } else if(key == "seconds") {
+                fields >> result.seconds;
+            } else if(key == "box") {
+                Box box;
+                fields >> box.index;
+                std::string number;
+                while(fields >> number) {
+                    // operator>> does not parse hexfloats reliably, strtod does
+                    box.bounds.push_back(std::strtod(number.c_str(), nullptr));
+                }
+                result.boxes.push_back(std::move(box));
+            } else if(!key.empty()) {
+                throw std::runtime_error("Unexpected line in shard result file '" + filename + "': " + line);
+            }
+            if(fields.fail() && !fields.eof()) {
+                throw std::runtime_error("Malformed line in shard result file '" + filename + "': " + line);
+            }
+        }
+        return result;
+    }
+};
@@ -0,0 +1,298 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * Process-wide options for the execution timeline; if file is non-empty,
+ * provers record spans for each proof, for every node_sample_interval-th node,
+ * for constraint evaluations taking at least constraint_threshold_us microseconds
+ * and for I/O, and the timeline is written to file as Chrome trace-event JSON
+ * (viewable in chrome://tracing or the Perfetto UI) while the proofs run.
+ */
+struct TimelineOptions {
+    std::string file;
+    std::uint64_t node_sample_interval = 4096;
+    double constraint_threshold_us = 100.0;
+};
+
+inline TimelineOptions& default_timeline_options() noexcept {
+    static TimelineOptions options;
+    return options;
+}
+
+/**
+ * Collects complete ("X") events from all threads of the process and appends them to
+ * the timeline file in the JSON array variant of the trace-event format, in which the
+ * closing bracket is optional: a process that crashes, is killed or calls _exit still
+ * leaves a loadable timeline containing everything up to the last flush.
+ * Events are rare (sampled or above a threshold); they are formatted when recorded and
+ * written at least every flush_interval_us. The buffer is guarded by a spin flag instead
+ * of a mutex, so the handlers installed by install_timeline_signal_handlers can write the
+ * pending events using only async-signal-safe calls.
+ */
+class TimelineRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr double flush_interval_us = 1.0e6;
+
+    TimelineRecorder() : m_start(Clock::now()), m_pid(long(::getpid())) {}
+
+    TimelineRecorder(const TimelineRecorder&) = delete;
+    TimelineRecorder &operator=(const TimelineRecorder&) = delete;
+
+    ~TimelineRecorder() {
+        close();
+    }
+
+    bool active() const noexcept {
+        return !default_timeline_options().file.empty();
+    }
+
+    /**
+     * Microseconds since the recorder was created.
+     */
+    double now_us() const noexcept {
+        return std::chrono::duration<double, std::micro>(Clock::now() - m_start).count();
+    }
+
+    /**
+     * Record a span; args must be empty or the members of a JSON object,
+     * e.g., "\"id\": 5, \"depth\": 3".
+     */
+    void complete(const std::string& name, const char* category, double begin_us, double end_us,
+                  const std::string& args = {})
+    {
+        char number[64];
+        std::snprintf(number, sizeof(number), "%.3f, \"dur\": %.3f", begin_us, end_us - begin_us);
+        std::string event = "{\"name\": \"" + escape(name) + "\", \"cat\": \"" + category +
+                            "\", \"ph\": \"X\", \"ts\": " + number + ", \"pid\": " + std::to_string(m_pid) +
+                            ", \"tid\": " + std::to_string(thread_id());
+        if(!args.empty()) {
+            event += ", \"args\": {" + args + '}';
+        }
+        event += '}';
+        append(event);
+    }
+
+    /**
+     * Name the calling thread in the timeline.
+     */
+    void name_thread(const std::string& name) {
+        append("{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " + std::to_string(m_pid) +
+               ", \"tid\": " + std::to_string(thread_id()) + ", \"args\": {\"name\": \"" + escape(name) + "\"}}");
+    }
+
+    /**
+     * Write the pending events to the timeline file (if any).
+     */
+    void flush() {
+        BusyLock lock(m_busy);
+        write_pending();
+    }
+
+    /**
+     * Write the pending events and the closing bracket; later events are dropped.
+     */
+    void close() {
+        BusyLock lock(m_busy);
+        finish();
+    }
+
+    /**
+     * Like close, but may be called from a signal handler; does nothing if the
+     * interrupted code (or another thread) is modifying the buffer.
+     */
+    void close_from_signal() noexcept {
+        if(m_busy.exchange(true, std::memory_order_acquire)) {
+            return;
+        }
+        finish();
+        m_busy.store(false, std::memory_order_release);
+    }
+
+    static std::string escape(const std::string& s) {
+        std::string result;
+        for(char c : s) {
+            if(c == '"' || c == '\\') {
+                result += '\\';
+                result += c;
+            } else if(static_cast<unsigned char>(c) < 0x20) {
+                result += ' ';
+            } else {
+                result += c;
+            }
+        }
+        return result;
+    }
+
+private:
+    class BusyLock {
+    public:
+        explicit BusyLock(std::atomic<bool>& busy) noexcept : m_busy(busy) {
+            while(m_busy.exchange(true, std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+
+        BusyLock(const BusyLock&) = delete;
+        BusyLock &operator=(const BusyLock&) = delete;
+
+        ~BusyLock() {
+            m_busy.store(false, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<bool>& m_busy;
+    };
+
+    static std::uint32_t thread_id() noexcept {
+        static std::atomic<std::uint32_t> next{1};
+        thread_local std::uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    void append(const std::string& event) {
+        double now = now_us();
+        BusyLock lock(m_busy);
+        if(m_closed) {
+            return;
+        }
+        if(m_events != 0) {
+            m_pending += ",\n";
+        }
+        m_pending += event;
+        ++m_events;
+        if(now - m_last_flush_us >= flush_interval_us) {
+            m_last_flush_us = now;
+            write_pending();
+        }
+    }
+
+    // the following functions only use async-signal-safe calls and do not allocate
+    void write_all(const char* data, std::size_t size) noexcept {
+        while(size > 0) {
+            ssize_t w = ::write(m_fd, data, size);
+            if(w < 0 && errno == EINTR) {
+                continue;
+            }
+            if(w <= 0) {
+                return;
+            }
+            data += w;
+            size -= std::size_t(w);
+        }
+    }
+
+    void write_pending() noexcept {
+        if(m_pending.empty()) {
+            return;
+        }
+        if(m_fd < 0) {
+            const std::string& filename = default_timeline_options().file;
+            if(!filename.empty()) {
+                m_fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            }
+            if(m_fd < 0) {
+                m_pending.clear();
+                return;
+            }
+            write_all("[\n", 2);
+        }
+        write_all(m_pending.data(), m_pending.size());
+        m_pending.clear();
+    }
+
+    void finish() noexcept {
+        if(m_closed) {
+            return;
+        }
+        write_pending();
+        m_closed = true;
+        if(m_fd >= 0) {
+            write_all("\n]\n", 3);
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    Clock::time_point m_start;
+    long m_pid;
+    std::atomic<bool> m_busy{false};
+    std::string m_pending;
+    std::uint64_t m_events = 0;
+    double m_last_flush_us = 0.0;
+    int m_fd = -1;
+    bool m_closed = false;
+};
+
+inline TimelineRecorder& timeline() {
+    static TimelineRecorder recorder;
+    return recorder;
+}
+
+/**
+ * On termination signals and crashes, write the pending timeline events
+ * before the signal takes its default action.
+ */
+inline void install_timeline_signal_handlers() {
+    timeline();
+    for(int signal : {SIGTERM, SIGINT, SIGHUP, SIGABRT, SIGSEGV, SIGBUS}) {
+        std::signal(signal, [] (int s) {
+            timeline().close_from_signal();
+            std::signal(s, SIG_DFL);
+            std::raise(s);
+        });
+    }
+}
+
+/**
+ * Records a span from construction to destruction if the timeline is active.
+ */
+class TimelineSpan {
+public:
+    TimelineSpan(const char* name, const char* category) :
+        m_name(name), m_category(category),
+        m_begin(timeline().active() ? timeline().now_us() : -1.0)
+    {}
+
+    TimelineSpan(const TimelineSpan&) = delete;
+    TimelineSpan &operator=(const TimelineSpan&) = delete;
+
+    ~TimelineSpan() {
+        if(m_begin >= 0.0) {
+            timeline().complete(m_name, m_category, m_begin, timeline().now_us());
+        }
+    }
+
+private:
+    const char* m_name;
+    const char* m_category;
+    double m_begin;
+};
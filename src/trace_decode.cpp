@@ -0,0 +1,96 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <cstring>
+#include <iostream>
+#include <exception>
+#include "binary_trace.hpp"
+#include "trace_registry.hpp"
+
+static void print_generic_node(std::ostream& output, const TraceNode& node, const std::vector<double>& bounds) {
+    output << "NODE " << node.id << " [PARENT " << node.parent_id << "]\n";
+    for(std::size_t i = 0; i < bounds.size() / 2; ++i) {
+        output << "x_" << i << " ∈ " << ivarp::IDouble{bounds[2 * i], bounds[2 * i + 1]} << '\n';
+    }
+}
+
+static void print_outcome(std::ostream& output, const TraceNode& node, const TraceFileHeader& header, bool verbose) {
+    TraceOutcome outcome = static_cast<TraceOutcome>(node.outcome);
+    if(verbose) {
+        output << "DEPTH " << node.depth << ", OUTCOME " << trace_outcome_name(outcome);
+        if(node.deciding_constraint >= 0 && std::size_t(node.deciding_constraint) < header.constraint_names.size()) {
+            output << " BY '" << header.constraint_names[node.deciding_constraint] << "'";
+        }
+        output << '\n';
+    }
+    if(outcome == TraceOutcome::EMPTY_AFTER_PROPAGATION) {
+        output << "Empty after propagation!\n";
+    } else if(outcome == TraceOutcome::REFUTED) {
+        output << "Constraints violated!\n";
+    }
+}
+
+/**
+ * Render a binary trace written by the prover in the text form of the text trace.
+ * With --verbose, depth, outcome and deciding constraint of each node are printed as well.
+ */
+int main(int argc, char** argv) {
+    bool verbose = false;
+    const char* filename = nullptr;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--verbose") == 0) {
+            verbose = true;
+        } else if(!filename) {
+            filename = argv[i];
+        } else {
+            filename = nullptr;
+            break;
+        }
+    }
+    if(!filename) {
+        std::cerr << "Usage: " << argv[0] << " [--verbose] TRACE_FILE" << std::endl;
+        return 2;
+    }
+    ivarp::setup_floating_point_environment();
+    register_all_trace_renderers();
+    try {
+        BinaryTraceReader reader(filename);
+        const TraceFileHeader& header = reader.header();
+        auto renderer = trace_renderers().find(header.proof_name);
+        bool use_renderer = renderer != trace_renderers().end() && renderer->second.num_vars == header.num_vars;
+        if(!use_renderer) {
+            std::cerr << "No variable set registered for proof '" << header.proof_name
+                      << "', printing raw bounds" << std::endl;
+        }
+        while(reader.next()) {
+            TraceNode node = reader.node();
+            std::vector<double> bounds = reader.bounds();
+            if(use_renderer) {
+                std::cout << renderer->second.render(bounds.data(), node.id, node.parent_id) << '\n';
+            } else {
+                print_generic_node(std::cout, node, bounds);
+            }
+            print_outcome(std::cout, node, header, verbose);
+        }
+    } catch(const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "prover.hpp"
+
+/**
+ * Renders a node of a binary trace in the text form produced by tracing,
+ * given the bounds (lb_0, ub_0, lb_1, ub_1, ...) of the node.
+ */
+using TraceRenderer = std::function<std::string(const double* bounds, std::uint64_t id, std::uint64_t parent_id)>;
+
+struct TraceRendererEntry {
+    std::size_t num_vars;
+    TraceRenderer render;
+};
+
+inline std::map<std::string, TraceRendererEntry>& trace_renderers() {
+    static std::map<std::string, TraceRendererEntry> renderers;
+    return renderers;
+}
+
+/**
+ * Register the variable set used by the proof with the given name with the trace decoder.
+ * Variable sets with trace_string are rendered using it; others are rendered using operator<<.
+ */
+template<typename VariableSet> void register_trace_renderer(const std::string& proof_name) {
+    TraceRenderer render = [] (const double* bounds, std::uint64_t id, std::uint64_t parent_id) -> std::string {
+        VariableSet vars;
+        vars.assign_values(bounds);
+        if constexpr(Prover<VariableSet>::tracing_supported) {
+            return vars.trace_string(id, parent_id);
+        } else {
+            std::ostringstream output;
+            output << "NODE " << id << " [PARENT " << parent_id << "]\n" << vars;
+            return output.str();
+        }
+    };
+    trace_renderers()[proof_name] = TraceRendererEntry{VariableSet::num_vars, std::move(render)};
+}
+
+/**
+ * Register the variable sets of all proofs; defined in trace_registry.cpp.
+ */
+extern void register_all_trace_renderers();
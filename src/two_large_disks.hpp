@@ -18,9 +18,11 @@
 #pragma once
 
 #include <ivarp_ia/ivarp_ia.hpp>
+#include <tuple>
 #include "constraint.hpp"
 #include "rectangle_cover.hpp"
 #include "geometry.hpp"
+#include "generated/two_large_disks_kernels.hpp"
 
 template<typename VariableSet>
 struct TwoLargeDiskChecker {
@@ -53,52 +55,30 @@ struct TwoLargeDiskChecker {
             return {true, true};
         }
         IBool only_one_pocket = (x_u_left >= 2.0 * r1w);
-        pocket_height_right = 1.0 - x3;
+        pocket_height_right = 1.0 - 2.0 * r1h;
         pocket_height_left = x4 * x_u_left;
         pocket_height = (ivarp::max)(pocket_height_left, pocket_height_right);
         return !r1_can_cover_width || !r1_intersects_top || !only_one_pocket ||
                !rectangle_cover_works(x_u_right, pocket_height, remaining_weight, IDouble{0.0, r2.ub()});
     }
 
+    // the kernels are generated from kernels/two_large_disks.kernels
     IBool compute_r1_intersections() noexcept {
-        x0 = 0.5 * alpha;
-        x1 = ivarp::square(ivarp::cos(x0));
-        x3 = 2.0 * r1h;
-        x5 = r1w * x4;
-        x6 = ivarp::square(x4);
-        IDouble x7sq = r1sq - r1hsq - r1wsq*x6 + r1sq*x6 - x3*x5 + x3 + 2.0*x5 - 1.0;
-        IBool res = (x7sq >= 0.0);
+        IDouble discriminant = two_large_disks_top_discriminant(r1sq, r1hsq, r1wsq, r1w, r1h, x4);
+        IBool res = (discriminant >= 0.0);
         if(!possibly(res)) {
             return res;
         }
-        x7sq.restrict_lb(0.0);
-        x7 = ivarp::sqrt(x7sq);
-        x8 = r1w - r1h*x4 + x4;
-        x_u_right = x1 * (x8 - x7);
-        x_u_left = x1 * (x7 + x8);
+        discriminant.restrict_lb(0.0);
+        TwoLargeDisksTopIntersections top = two_large_disks_top_intersections(alpha, r1w, r1h, x4, discriminant);
+        x_u_right = top.right_x_u;
+        x_u_left = top.left_x_u;
         return res;
     }
 
     ivarp::IDouble alpha, cos_alpha, r1, r2, r1sq, r2sq, remaining_weight, r1w, r1wsq, r1hsq, r1h;
 
-    /*
-     * sympy.cse([right_x_u, left_x_u, pocket_height_right, pocket_height_left])
-     *
-     *   ([(x0, alpha/2),
-     *     (x1, cos(x0)**2),
-     *     (r1sq, r_1**2),
-     *     (x3, 2*r_1^h),
-     *     (x4, tan(x0)),
-     *     (x5, r_1^w*x4),
-     *     (x6, x4**2),
-     *     (x7, sqrt(-r_1^h**2 - r_1^w**2*x6 + r1sq*x6 + r1sq - x3*x5 + x3 + 2*x5 - 1)),
-     *     (x8, -r_1^h*x4 + r_1^w + x4)],
-     *    [x1*(-x7 + x8), # right_x_u
-     *     x1*(x7 + x8),  # left_x_u
-     *     1 - x3,        # pocket_height_right
-     *     x4*x_u])       # pocket_height_left
-     */
-    ivarp::IDouble x0, x1, x3, x4, x5, x6, x7, x8, x_u_right, x_u_left;
+    ivarp::IDouble x4, x_u_right, x_u_left;
     ivarp::IDouble pocket_height_right, pocket_height_left, pocket_height;
 };
 
@@ -185,8 +165,9 @@ private:
     IBool compute_second_top_intersection() {
         IDouble t0 = 2 * r2sq;
         IDouble t1 = 2 * alpha;
-        IDouble t2 = 2 * r2 * ivarp::sin(t1);
-        IDouble t3 = t0 * ivarp::cos(t1);
+        std::pair<IDouble, IDouble> sc_t1 = ivarp::sincos(t1);
+        IDouble t2 = 2 * r2 * sc_t1.first;
+        IDouble t3 = t0 * sc_t1.second;
         IDouble t4 = 8 * r1sq;
         IDouble v_x_sqrt_term_squared = (t0 - t2 - t3 + t4*cos_alpha - t4 + 1) / (t2 - t0 + t3 - 1);
         IBool result = (v_x_sqrt_term_squared >= 0.0);
@@ -254,8 +235,7 @@ private:
         remaining_rho = ivarp::sqrt(remaining_weight);
         b_r = 2.0 * remaining_rho * sin_alpha;
         IDouble ahalf = 0.5 * alpha;
-        cos_alpha_half = ivarp::cos(ahalf);
-        sin_alpha_half = ivarp::sin(ahalf);
+        std::tie(sin_alpha_half, cos_alpha_half) = ivarp::sincos(ahalf);
         s_w = (1.0 - b_r) * cos_alpha_half;
     }
 
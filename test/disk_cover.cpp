@@ -0,0 +1,244 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <doctest/doctest.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "disk_cover.hpp"
+
+using IDouble = ivarp::IDouble;
+using IBool = ivarp::IBool;
+
+namespace {
+
+struct Placement {
+    std::vector<Point> polygon;
+    std::vector<Circle> disks;
+
+    IBool covered_by(DiskCoverEngine& engine) const {
+        return engine.covers(polygon.data(), polygon.size(), disks.data(), disks.size());
+    }
+};
+
+Point point(double x, double y) {
+    return Point{IDouble(x), IDouble(y)};
+}
+
+/// The acute triangle (0,0), (1,0), (x,y) with the disks on the segments from the vertices
+/// to the circumcenter as diameters, radii scaled by factor; covered exactly for factor >= 1.
+Placement thales_triangle(IDouble x, IDouble y, double factor) {
+    Placement p;
+    p.polygon = {point(0.0, 0.0), point(1.0, 0.0), Point{x, y}};
+    Point center{IDouble(0.5), (square(x) + square(y) - x) / (2.0 * y)};
+    for(const Point& v : p.polygon) {
+        p.disks.push_back(Circle{center_of(v, center), factor * 0.5 * sqrt(squared_distance(v, center))});
+    }
+    return p;
+}
+
+/// The rectangle [0,2] x [0,1] with two disks of radius r through points just beyond its short sides.
+Placement rectangle_pair(IDouble r) {
+    Placement p;
+    p.polygon = {point(0.0, 0.0), point(2.0, 0.0), point(2.0, 1.0), point(0.0, 1.0)};
+    p.disks = {disk_through(point(-0.02, -0.02), point(-0.02, 1.02), r),
+               disk_through(point(2.02, 1.02), point(2.02, -0.02), r)};
+    return p;
+}
+
+/// The unit equilateral triangle with disks of radius r around its vertices.
+Placement vertex_disks(IDouble r) {
+    Placement p;
+    p.polygon = {point(0.0, 0.0), point(1.0, 0.0), Point{IDouble(0.5), 0.5 * sqrt(IDouble(3.0))}};
+    for(const Point& v : p.polygon) {
+        p.disks.push_back(Circle{v, r});
+    }
+    return p;
+}
+
+}
+
+DOCTEST_TEST_CASE("[disk_cover] covered polygons are recognized") {
+    DiskCoverEngine engine;
+    DOCTEST_CHECK(definitely(thales_triangle(IDouble(0.4), IDouble(0.8), 1.05).covered_by(engine)));
+    DOCTEST_CHECK(!engine.last_stats().rejected);
+    DOCTEST_CHECK(definitely(rectangle_pair(IDouble(0.75)).covered_by(engine)));
+    DOCTEST_CHECK(definitely(thales_triangle(IDouble(0.45, 0.46), IDouble(0.75, 0.76), 1.1).covered_by(engine)));
+
+    Placement one_disk;
+    one_disk.polygon = {point(0.0, 0.0), point(1.0, 0.0), point(0.0, 1.0)};
+    one_disk.disks = {Circle{point(0.5, 0.5), IDouble(0.75)}};
+    DOCTEST_CHECK(definitely(one_disk.covered_by(engine)));
+}
+
+DOCTEST_TEST_CASE("[disk_cover] uncovered polygons are recognized") {
+    DiskCoverEngine engine;
+    DOCTEST_CHECK(!possibly(thales_triangle(IDouble(0.4), IDouble(0.8), 0.97).covered_by(engine)));
+    DOCTEST_CHECK(!possibly(rectangle_pair(IDouble(0.7)).covered_by(engine)));
+
+    // the disks cover the edges, so only the quadtree can find the gap around the centroid
+    DOCTEST_CHECK(!possibly(vertex_disks(IDouble(0.55)).covered_by(engine)));
+    DOCTEST_CHECK(!engine.last_stats().edge_gap);
+    DOCTEST_CHECK(engine.last_stats().cells > 0);
+}
+
+DOCTEST_TEST_CASE("[disk_cover] tiny gaps at disk boundaries are never reported as covered") {
+    DiskCoverEngine engine;
+    IBool thales_gap = thales_triangle(IDouble(0.4), IDouble(0.8), 0.999).covered_by(engine);
+    DOCTEST_CHECK(!possibly(thales_gap));
+    DOCTEST_CHECK(engine.last_stats().edge_gap);
+    DOCTEST_CHECK(!definitely(thales_triangle(IDouble(0.4), IDouble(0.8), 1.0 - 1.0e-9).covered_by(engine)));
+    DOCTEST_CHECK(!definitely(rectangle_pair(IDouble(0.7213)).covered_by(engine)));
+    DOCTEST_CHECK(!definitely(vertex_disks(IDouble(0.5 - 1.0e-9)).covered_by(engine)));
+
+    // an interval radius straddling the threshold cannot be decided either way
+    IBool straddling = rectangle_pair(IDouble(0.72, 0.73)).covered_by(engine);
+    DOCTEST_CHECK(!definitely(straddling));
+    DOCTEST_CHECK(possibly(straddling));
+}
+
+DOCTEST_TEST_CASE("[disk_cover] unsupported problems are rejected as indeterminate") {
+    DiskCoverEngine engine;
+    Circle large{point(1.0, 1.0), IDouble(3.0)};
+
+    // an arrow-shaped quadrilateral with a reflex vertex at (1,1)
+    Placement non_convex;
+    non_convex.polygon = {point(0.0, 0.0), point(2.0, 0.0), point(2.0, 2.0), point(1.0, 1.0), point(0.0, 2.0)};
+    non_convex.disks = {large};
+    IBool result = non_convex.covered_by(engine);
+    DOCTEST_CHECK(!definitely(result));
+    DOCTEST_CHECK(possibly(result));
+    DOCTEST_CHECK(engine.last_stats().rejected);
+
+    Placement convex = non_convex;
+    convex.polygon.erase(convex.polygon.begin() + 3);
+    DOCTEST_CHECK(definitely(convex.covered_by(engine)));
+    DOCTEST_CHECK(!engine.last_stats().rejected);
+
+    Placement many_disks = convex;
+    many_disks.disks.assign(64, large);
+    DOCTEST_CHECK(definitely(many_disks.covered_by(engine)));
+    many_disks.disks.push_back(large);
+    result = many_disks.covered_by(engine);
+    DOCTEST_CHECK(!definitely(result));
+    DOCTEST_CHECK(possibly(result));
+    DOCTEST_CHECK(engine.last_stats().rejected);
+
+    Placement degenerate = convex;
+    degenerate.polygon.resize(2);
+    DOCTEST_CHECK(possibly(degenerate.covered_by(engine)));
+    DOCTEST_CHECK(engine.last_stats().rejected);
+
+    // a pentagram turns the same way at every vertex; the intersection of its edge half-planes
+    // is the inner pentagon, which the disks cover, but (0, 0.472) in the top tip is uncovered
+    const double pi = 3.14159265358979323846;
+    Point pentagon[5];
+    for(int k = 0; k < 5; ++k) {
+        double angle = 0.5 * pi + 0.4 * pi * k;
+        pentagon[k] = point(std::cos(angle), std::sin(angle));
+    }
+    Placement pentagram;
+    pentagram.polygon = {pentagon[0], pentagon[2], pentagon[4], pentagon[1], pentagon[3]};
+    pentagram.disks = {Circle{point(0.0, 0.0), IDouble(0.4)}};
+    for(std::size_t i = 0; i < 5; ++i) {
+        const Point& p = pentagram.polygon[i];
+        const Point& q = pentagram.polygon[(i + 1) % 5];
+        for(int j = 0; j < 9; ++j) {
+            double t = (j + 0.5) / 9.0;
+            pentagram.disks.push_back(Circle{Point{p.x + t * (q.x - p.x), p.y + t * (q.y - p.y)}, IDouble(0.15)});
+        }
+    }
+    result = pentagram.covered_by(engine);
+    DOCTEST_CHECK(!definitely(result));
+    DOCTEST_CHECK(possibly(result));
+    DOCTEST_CHECK(engine.last_stats().rejected);
+}
+
+DOCTEST_TEST_CASE("[disk_cover] a single disk covers a triangle iff it contains the vertices") {
+    DiskCoverEngine engine;
+    std::mt19937_64 rng(49);
+    std::uniform_real_distribution<double> coordinate(0.0, 1.0);
+    std::uniform_real_distribution<double> radius(0.2, 1.0);
+    int checked = 0;
+    while(checked < 500) {
+        Placement p;
+        p.polygon = {point(coordinate(rng), coordinate(rng)), point(coordinate(rng), coordinate(rng)),
+                     point(coordinate(rng), coordinate(rng))};
+        p.disks = {Circle{point(coordinate(rng), coordinate(rng)), IDouble(radius(rng))}};
+        const Point& a = p.polygon[0];
+        const Point& b = p.polygon[1];
+        const Point& c = p.polygon[2];
+        double twice_area = ((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)).lb();
+        if(std::abs(twice_area) < 0.1) {
+            continue;
+        }
+        double max_sqdist = 0.0;
+        for(const Point& v : p.polygon) {
+            max_sqdist = (std::max)(max_sqdist, squared_distance(v, p.disks[0].center).lb());
+        }
+        double rsq = square(p.disks[0].radius).lb();
+        if(std::abs(max_sqdist - rsq) < 0.05) {
+            continue;
+        }
+        ++checked;
+        IBool result = p.covered_by(engine);
+        if(max_sqdist < rsq) {
+            DOCTEST_CHECK(definitely(result));
+        } else {
+            DOCTEST_CHECK(!possibly(result));
+        }
+    }
+}
+
+DOCTEST_TEST_CASE("[disk_cover] the rectangle pair agrees with the chords on the middle line") {
+    DiskCoverEngine engine;
+    std::mt19937_64 rng(4949);
+    std::uniform_real_distribution<double> radius(0.6, 0.9);
+    int checked = 0;
+    while(checked < 200) {
+        double r = radius(rng);
+        Placement p = rectangle_pair(IDouble(r));
+
+        // by symmetry, the disks cover the rectangle iff the left one covers the segment x = 1, 0 <= y <= 1
+        IntersectionResult chord = line_circle_intersection(point(1.0, 0.0), point(0.0, 1.0), p.disks[0]);
+        if(possibly(chord.exists) && !definitely(chord.exists)) {
+            continue;
+        }
+        bool covered = false;
+        if(definitely(chord.exists)) {
+            IDouble y0 = ivarp::min(chord.first_on_line.y, chord.second_on_line.y);
+            IDouble y1 = ivarp::max(chord.first_on_line.y, chord.second_on_line.y);
+            double margin = (std::min)(-y0.ub(), y1.lb() - 1.0);
+            if(std::abs(margin) < 0.005) {
+                continue;
+            }
+            covered = (margin > 0.0);
+        }
+        ++checked;
+        IBool result = p.covered_by(engine);
+        if(covered) {
+            DOCTEST_CHECK(definitely(result));
+        } else {
+            DOCTEST_CHECK(!possibly(result));
+        }
+    }
+}
@@ -0,0 +1,252 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <doctest/doctest.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "generated/below_45_isoceles_derivatives_kernels.hpp"
+#include "generated/r1_in_center_kernels.hpp"
+#include "generated/two_large_disks_kernels.hpp"
+
+using IDouble = ivarp::IDouble;
+
+namespace {
+
+struct Range {
+    double lb, ub;
+};
+
+template<std::size_t N> using Inputs = std::array<IDouble, N>;
+using Outputs = std::vector<IDouble>;
+
+struct KernelCheck {
+    std::size_t comparisons = 0;    //< pairs of results compared
+    std::size_t defined = 0;        //< pairs of results that were both defined
+    std::size_t inconsistent = 0;   //< pairs of defined results that do not intersect
+};
+
+/**
+ * Record whether two results can enclose the same value; an undefined result
+ * is sound for every input, so only pairs of defined results are compared.
+ */
+void compare(KernelCheck& check, const Outputs& x, const Outputs& y) {
+    for(std::size_t i = 0; i < x.size(); ++i) {
+        ++check.comparisons;
+        if(possibly_undefined(x[i]) || possibly_undefined(y[i])) {
+            continue;
+        }
+        ++check.defined;
+        if(x[i].ub() < y[i].lb() || y[i].ub() < x[i].lb()) {
+            ++check.inconsistent;
+        }
+    }
+}
+
+/**
+ * The boxes a kernel is tested on: the boundary boxes, in which each input is its full
+ * declared range or one of its endpoints, and random boxes of widths from the full range
+ * down to 2^-30 of it.
+ */
+template<std::size_t N> std::vector<Inputs<N>> test_boxes(const std::array<Range, N>& ranges, std::mt19937_64& rng) {
+    std::vector<Inputs<N>> boxes;
+    std::size_t boundary = 1;
+    for(std::size_t i = 0; i < N; ++i) {
+        boundary *= 3;
+    }
+    for(std::size_t code = 0; code < boundary; ++code) {
+        Inputs<N> box;
+        std::size_t c = code;
+        for(std::size_t i = 0; i < N; ++i, c /= 3) {
+            const Range& r = ranges[i];
+            box[i] = (c % 3 == 0) ? IDouble(r.lb, r.ub) : IDouble(c % 3 == 1 ? r.lb : r.ub);
+        }
+        boxes.push_back(box);
+    }
+    std::uniform_real_distribution<double> unit(0.0, 1.0), log_width(-30.0, 0.0);
+    for(int k = 0; k < 300; ++k) {
+        Inputs<N> box;
+        for(std::size_t i = 0; i < N; ++i) {
+            const Range& r = ranges[i];
+            double w = (r.ub - r.lb) * std::exp2(log_width(rng));
+            double lb = r.lb + (r.ub - r.lb - w) * unit(rng);
+            box[i] = IDouble(lb, (std::min)(r.ub, lb + w));
+        }
+        boxes.push_back(box);
+    }
+    return boxes;
+}
+
+/// The corners of the box and a few random points in it, as point intervals.
+template<std::size_t N> std::vector<Inputs<N>> test_points(const Inputs<N>& box, std::mt19937_64& rng) {
+    std::vector<Inputs<N>> points;
+    for(std::size_t corner = 0; corner < (std::size_t(1) << N); ++corner) {
+        Inputs<N> p;
+        for(std::size_t i = 0; i < N; ++i) {
+            p[i] = IDouble((corner >> i) & 1 ? box[i].ub() : box[i].lb());
+        }
+        points.push_back(p);
+    }
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for(int k = 0; k < 4; ++k) {
+        Inputs<N> p;
+        for(std::size_t i = 0; i < N; ++i) {
+            double x = box[i].lb() + (box[i].ub() - box[i].lb()) * unit(rng);
+            p[i] = IDouble((std::min)(box[i].ub(), x));
+        }
+        points.push_back(p);
+    }
+    return points;
+}
+
+/**
+ * Compare a generated kernel with its reference translation on the test boxes: the generated result
+ * on a box must be consistent with the reference result on the box and at each test point in it,
+ * and the results of both on a point must be consistent.
+ */
+template<std::size_t N, typename Generated, typename Reference>
+KernelCheck check_kernel(const std::array<Range, N>& ranges, Generated&& generated, Reference&& reference) {
+    std::mt19937_64 rng(20221018);
+    KernelCheck check;
+    for(const Inputs<N>& box : test_boxes(ranges, rng)) {
+        Outputs on_box = generated(box);
+        compare(check, on_box, reference(box));
+        for(const Inputs<N>& p : test_points(box, rng)) {
+            Outputs at_point = reference(p);
+            compare(check, on_box, at_point);
+            compare(check, generated(p), at_point);
+        }
+    }
+    return check;
+}
+
+void require_consistent(const KernelCheck& check) {
+    DOCTEST_CHECK(check.inconsistent == 0);
+    // the inputs are drawn independently from their declared ranges, so some combinations
+    // are outside the domain of a kernel; a substantial part must still be compared
+    DOCTEST_CHECK(check.defined * 4 > check.comparisons);
+}
+
+const Range alpha_below_45{0.767944870877505, 0.785398163397448};
+const Range r_below_45{0.48, 0.5};
+
+}
+
+DOCTEST_TEST_CASE("[kernels] the below-45 derivative kernels agree with their reference translations") {
+    require_consistent(check_kernel(std::array<Range, 3>{alpha_below_45, r_below_45, r_below_45},
+        [] (const Inputs<3>& x) { return Outputs{diff_restweight_by_r1(x[0], x[1], x[2])}; },
+        [] (const Inputs<3>& x) { return Outputs{reference_kernels::diff_restweight_by_r1(x[0], x[1], x[2])}; }));
+    require_consistent(check_kernel(std::array<Range, 2>{alpha_below_45, r_below_45},
+        [] (const Inputs<2>& x) { return Outputs{diff_restweight_by_r2(x[0], x[1])}; },
+        [] (const Inputs<2>& x) { return Outputs{reference_kernels::diff_restweight_by_r2(x[0], x[1])}; }));
+    require_consistent(check_kernel(std::array<Range, 1>{alpha_below_45},
+        [] (const Inputs<1>& x) {
+            return Outputs{diff_restweight_by_alpha(x[0]), diff_restweight_by_alpha_with_derivatives(x[0]).value};
+        },
+        [] (const Inputs<1>& x) {
+            IDouble value = reference_kernels::diff_restweight_by_alpha(x[0]);
+            return Outputs{value, value};
+        }));
+}
+
+DOCTEST_TEST_CASE("[kernels] the derivative of diff_restweight_by_alpha encloses its difference quotients") {
+    std::mt19937_64 rng(50);
+    KernelCheck check;
+    for(const Inputs<1>& box : test_boxes(std::array<Range, 1>{alpha_below_45}, rng)) {
+        IDouble a = box[0];
+        if(!(a.lb() < a.ub())) {
+            continue;
+        }
+        // by the mean value theorem, the quotient is the derivative somewhere in the box
+        IDouble quotient = (reference_kernels::diff_restweight_by_alpha(IDouble(a.ub())) -
+                            reference_kernels::diff_restweight_by_alpha(IDouble(a.lb()))) /
+                           (IDouble(a.ub()) - IDouble(a.lb()));
+        compare(check, Outputs{diff_restweight_by_alpha_with_derivatives(a).d_value_d_alpha}, Outputs{quotient});
+    }
+    require_consistent(check);
+}
+
+DOCTEST_TEST_CASE("[kernels] the batch overloads compute the same results as the single-box kernels") {
+    std::mt19937_64 rng(5050);
+    std::vector<IDouble> alpha, r1, r2;
+    for(const Inputs<3>& box : test_boxes(std::array<Range, 3>{alpha_below_45, r_below_45, r_below_45}, rng)) {
+        alpha.push_back(box[0]);
+        r1.push_back(box[1]);
+        r2.push_back(box[2]);
+    }
+    const std::size_t n = alpha.size();
+    std::vector<IDouble> by_r1(n), by_r2(n), by_alpha(n);
+    diff_restweight_by_r1(alpha.data(), r1.data(), r2.data(), by_r1.data(), n);
+    diff_restweight_by_r2(alpha.data(), r2.data(), by_r2.data(), n);
+    diff_restweight_by_alpha(alpha.data(), by_alpha.data(), n);
+    auto same = [] (IDouble x, IDouble y) {
+        return possibly_undefined(x) == possibly_undefined(y) && (possibly_undefined(x) || (x.lb() == y.lb() && x.ub() == y.ub()));
+    };
+    for(std::size_t i = 0; i < n; ++i) {
+        DOCTEST_CHECK(same(by_r1[i], diff_restweight_by_r1(alpha[i], r1[i], r2[i])));
+        DOCTEST_CHECK(same(by_r2[i], diff_restweight_by_r2(alpha[i], r2[i])));
+        DOCTEST_CHECK(same(by_alpha[i], diff_restweight_by_alpha(alpha[i])));
+    }
+}
+
+DOCTEST_TEST_CASE("[kernels] the r1_in_center kernels agree with their reference translations") {
+    auto outputs = [] (const R1InCenterChi1& r) {
+        return Outputs{r.chi_1, r.sin_half_alpha, r.cos_half_alpha};
+    };
+    require_consistent(check_kernel(std::array<Range, 2>{Range{0.3449, 0.7854}, Range{0.0, 0.5}},
+        [&] (const Inputs<2>& x) { return outputs(r1_in_center_chi1(x[0], x[1])); },
+        [&] (const Inputs<2>& x) { return outputs(reference_kernels::r1_in_center_chi1(x[0], x[1])); }));
+
+    auto sizes = [] (const R1InCenterRemainingSizes& r) {
+        return Outputs{r.r1_squared, r.remaining_triangle_half_base, r.remaining_triangle_height,
+                       r.remaining_pocket_width, r.remaining_pocket_height};
+    };
+    std::array<Range, 5> ranges{Range{0.1716, 0.3827}, Range{0.9238, 0.9853}, Range{0.1741, 0.4143},
+                                Range{0.7071, 0.9412}, Range{0.0, 0.5}};
+    require_consistent(check_kernel(ranges,
+        [&] (const Inputs<5>& x) { return sizes(r1_in_center_remaining_sizes(x[0], x[1], x[2], x[3], x[4])); },
+        [&] (const Inputs<5>& x) {
+            return sizes(reference_kernels::r1_in_center_remaining_sizes(x[0], x[1], x[2], x[3], x[4]));
+        }));
+}
+
+DOCTEST_TEST_CASE("[kernels] the two_large_disks kernels agree with their reference translations") {
+    std::array<Range, 6> discriminant_ranges{Range{0.0, 0.25}, Range{0.0, 0.25}, Range{0.0, 2.1},
+                                             Range{0.1, 1.45}, Range{0.0, 0.5}, Range{0.1741, 0.4143}};
+    require_consistent(check_kernel(discriminant_ranges,
+        [] (const Inputs<6>& x) { return Outputs{two_large_disks_top_discriminant(x[0], x[1], x[2], x[3], x[4], x[5])}; },
+        [] (const Inputs<6>& x) {
+            return Outputs{reference_kernels::two_large_disks_top_discriminant(x[0], x[1], x[2], x[3], x[4], x[5])};
+        }));
+
+    auto outputs = [] (const TwoLargeDisksTopIntersections& r) {
+        return Outputs{r.right_x_u, r.left_x_u};
+    };
+    std::array<Range, 5> intersection_ranges{Range{0.3449, 0.7854}, Range{0.1, 1.45}, Range{0.0, 0.5},
+                                             Range{0.1741, 0.4143}, Range{0.0, 4.0}};
+    require_consistent(check_kernel(intersection_ranges,
+        [&] (const Inputs<5>& x) { return outputs(two_large_disks_top_intersections(x[0], x[1], x[2], x[3], x[4])); },
+        [&] (const Inputs<5>& x) {
+            return outputs(reference_kernels::two_large_disks_top_intersections(x[0], x[1], x[2], x[3], x[4]));
+        }));
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <doctest/doctest.hpp>
+#include <ostream>
+#include "basic_variable_set.hpp"
+#include "prover.hpp"
+
+using IDouble = ivarp::IDouble;
+using IBool = ivarp::IBool;
+
+namespace {
+
+struct UnitIntervalVariables : BasicVariableSet<UnitIntervalVariables, 1> {
+    using Super = BasicVariableSet<UnitIntervalVariables, 1>;
+    DECLARE_NAMED_VARIABLE(x, 0)
+
+    UnitIntervalVariables() : Super(+initial_values, +change_handlers) {}
+
+    template<typename Callback> void split(Callback&& cb, std::uint64_t depth) noexcept {
+        this->default_split(std::forward<Callback>(cb), depth);
+    }
+
+    void on_x_changed(bool, bool) {}
+
+    static constexpr Super::OnChangeHandler change_handlers[Super::num_vars] = {
+        &UnitIntervalVariables::on_x_changed
+    };
+
+    static const IDouble initial_values[Super::num_vars];
+};
+
+const IDouble UnitIntervalVariables::initial_values[UnitIntervalVariables::num_vars] = {{0.0, 1.0}};
+constexpr UnitIntervalVariables::OnChangeHandler UnitIntervalVariables::change_handlers[UnitIntervalVariables::num_vars];
+
+std::ostream& operator<<(std::ostream& out, const UnitIntervalVariables& vars) {
+    return out << "x: " << vars.get_x();
+}
+
+/**
+ * Refutes the upper half of the unit interval.
+ */
+struct RefuteUpperHalf : Constraint<UnitIntervalVariables> {
+    std::string name() const override { return "refute upper half"; }
+
+    IBool satisfied(const UnitIntervalVariables& vars) override {
+        return IBool{false, vars.get_x().lb() < 0.5};
+    }
+};
+
+/**
+ * Empties the lower half of the unit interval, reporting CHANGED_EMPTY
+ * like propagators that narrow a variable before they detect the empty box.
+ */
+struct EmptyLowerHalf : Constraint<UnitIntervalVariables> {
+    std::string name() const override { return "empty lower half"; }
+    bool can_propagate() const override { return true; }
+
+    IBool satisfied(const UnitIntervalVariables& vars) override {
+        return IBool{false, vars.get_x().ub() > 0.5};
+    }
+
+    PropagateResult propagate(UnitIntervalVariables& vars) override {
+        if(vars.get_x().ub() <= 0.5) {
+            vars.restrict_x_ub(0.25);
+            return PropagateResult::CHANGED_EMPTY;
+        }
+        return PropagateResult::UNCHANGED;
+    }
+};
+
+}
+
+DOCTEST_TEST_CASE("[hot subtrees] Leaves emptied with CHANGED_EMPTY are attributed to their propagator") {
+    Prover<UnitIntervalVariables> prover;
+    prover.emplace_constraint<RefuteUpperHalf>();
+    prover.emplace_constraint<EmptyLowerHalf>();
+    prover.add_variable_set(UnitIntervalVariables{});
+    prover.hot_subtrees(1);
+    // the upper half is taken from the stack (and refuted) first, then the lower half is emptied
+    DOCTEST_REQUIRE(prover.prove());
+    DOCTEST_REQUIRE(prover.stats().nodes == 3);
+    const auto& hottest = prover.hottest_subtrees();
+    DOCTEST_REQUIRE(hottest.size() == 2);
+    std::uint64_t decided_by[2] = {0, 0};
+    for(const auto& s : hottest) {
+        DOCTEST_REQUIRE(s.nodes == 1);
+        DOCTEST_REQUIRE(s.undecided == 0);
+        DOCTEST_REQUIRE(s.decided_by.size() == 2);
+        DOCTEST_REQUIRE(s.decided_by[0] + s.decided_by[1] == 1);
+        bool upper = (s.domain.get_x().lb() >= 0.5);
+        DOCTEST_CHECK(s.decided_by[upper ? 0 : 1] == 1);
+        decided_by[0] += s.decided_by[0];
+        decided_by[1] += s.decided_by[1];
+    }
+    DOCTEST_CHECK(decided_by[0] == 1);
+    DOCTEST_CHECK(decided_by[1] == 1);
+}
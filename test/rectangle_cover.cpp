@@ -0,0 +1,173 @@
+/*
+ * Copyright 2022 Phillip Keldenich, Algorithms Department, TU Braunschweig
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ * and associated documentation files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+ * LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+
+
+#include <ivarp_ia/ivarp_ia.hpp>
+#include <doctest/doctest.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "rectangle_cover.hpp"
+
+using IDouble = ivarp::IDouble;
+using IBool = ivarp::IBool;
+
+namespace {
+
+using Checker = impl::RectangleCoverChecker<void>;
+
+/**
+ * A rectangle with weight and radius r1; for width 1 and height lambda >= 1, lambda and r1
+ * are not rescaled by the checker. Overlapping width and height yield lambda.lb < 1.
+ */
+struct CoverBox {
+    IDouble width, height, weight, r1;
+};
+
+struct TableCheck {
+    std::size_t definite = 0;       //< boxes on which the tabulated check was definite
+    std::size_t contradicted = 0;   //< boxes on which the exact check contradicted it
+};
+
+IBool check_exact(const CoverBox& box) {
+    Checker checker(box.width, box.height, box.weight, box.r1);
+    return checker.check_exact();
+}
+
+bool contradicts(IBool tabulated, IBool exact) {
+    return (definitely(tabulated) && !possibly(exact)) || (!possibly(tabulated) && definitely(exact));
+}
+
+/**
+ * Compare the tabulated check with the exact one on the box and, since a definite
+ * answer holds for all values in the box, at its corners and at random points in it.
+ */
+void compare(TableCheck& check, const CoverBox& box, std::mt19937_64& rng) {
+    IBool tabulated = Checker(box.width, box.height, box.weight, box.r1).check_tabulated();
+    if(!definitely(tabulated) && possibly(tabulated)) {
+        return;
+    }
+    ++check.definite;
+    std::vector<CoverBox> points;
+    auto bound = [] (IDouble x, bool upper) {
+        return IDouble(upper ? x.ub() : x.lb());
+    };
+    for(int corner = 0; corner < 16; ++corner) {
+        points.push_back(CoverBox{bound(box.width, corner & 1), bound(box.height, corner & 2),
+                                  bound(box.weight, corner & 4), bound(box.r1, corner & 8)});
+    }
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto inside = [&] (IDouble x) {
+        return IDouble((std::min)(x.ub(), x.lb() + (x.ub() - x.lb()) * unit(rng)));
+    };
+    for(int k = 0; k < 4; ++k) {
+        points.push_back(CoverBox{inside(box.width), inside(box.height), inside(box.weight), inside(box.r1)});
+    }
+    bool contradicted = contradicts(tabulated, check_exact(box));
+    for(const CoverBox& p : points) {
+        contradicted |= contradicts(tabulated, check_exact(p));
+    }
+    check.contradicted += contradicted;
+}
+
+/// A weight interval around factor times the smaller of the weights required by Thm 1 and Lemma 3.
+IDouble weight_near_threshold(IDouble lambda, IDouble r1, double factor, double relative_width) {
+    IDouble l(0.5 * (lambda.lb() + lambda.ub())), r(0.5 * (r1.lb() + r1.ub()));
+    double required = (std::min)(Checker::thm1_weight(l).lb(), (l * Checker::lem3_factor(r)).lb());
+    double w = factor * required;
+    return IDouble(w, w * (1.0 + relative_width));
+}
+
+}
+
+DOCTEST_TEST_CASE("[rectangle_cover] the tabulated check never contradicts the exact check") {
+    std::mt19937_64 rng(48);
+    std::uniform_real_distribution<double> unit(0.0, 1.0), factor(0.8, 1.2), log_width(-30.0, -2.0);
+    const double resolution = impl::RectangleCoverTable<void>::resolution;
+    const double lambda_switch_lb = 1.035797111181671059654263444826938211917877197265625;
+    auto random_interval = [&] (double lb, double ub) {
+        double w = (ub - lb) * std::exp2(log_width(rng));
+        double x = lb + (ub - lb - w) * unit(rng);
+        return IDouble(x, x + w);
+    };
+
+    std::vector<IDouble> lambdas, radii;
+    for(int i = 0; i < 100; ++i) {
+        lambdas.push_back(random_interval(1.0, 5.2));
+        radii.push_back(random_interval(0.0, 4.2));
+    }
+    for(int i : {0, 1, 37, 1024, 2048, 4095, 4096}) {
+        // exactly on grid points, as points and as bounds of intervals
+        double g = 1.0 + i / resolution;
+        lambdas.push_back(IDouble(g));
+        lambdas.push_back(IDouble(g, (std::min)(5.0, g + 3.0 / resolution)));
+        radii.push_back(IDouble((g - 1.0)));
+    }
+    lambdas.push_back(IDouble(1.0, 1.0 + 1.0e-12));
+    lambdas.push_back(IDouble(4.99, 5.01));             // lambda.ub > 5
+    lambdas.push_back(IDouble(5.0, 5.0 + 1.0e-12));
+    lambdas.push_back(IDouble(lambda_switch_lb - 1.0e-4, lambda_switch_lb + 1.0e-4));
+    lambdas.push_back(IDouble(lambda_switch_lb - 1.0e-15, lambda_switch_lb + 1.0e-15));
+    lambdas.push_back(IDouble(lambda_switch_lb));
+    radii.push_back(IDouble(0.0));
+    radii.push_back(IDouble(4.0));
+    radii.push_back(IDouble(0.0, 1.0e-9));
+    radii.push_back(IDouble(3.999, 4.0));
+    radii.push_back(IDouble(3.999, 4.001));
+    radii.push_back(IDouble(0.375));
+    radii.push_back(IDouble(0.3, 0.5));
+
+    TableCheck check;
+    std::size_t boxes = 0;
+    for(IDouble lambda : lambdas) {
+        for(IDouble r1 : radii) {
+            for(double relative_width : {0.0, 1.0e-9, 1.0e-3, 0.1}) {
+                IDouble weight = weight_near_threshold(lambda, r1, factor(rng), relative_width);
+                compare(check, CoverBox{IDouble(1.0), lambda, weight, r1}, rng);
+                ++boxes;
+            }
+        }
+    }
+    // overlapping side lengths: the normalized lambda has lb < 1
+    for(IDouble r1 : radii) {
+        for(double f : {0.5, 1.0, 2.0}) {
+            IDouble weight = weight_near_threshold(IDouble(1.0, 1.002), r1, f, 1.0e-3);
+            compare(check, CoverBox{IDouble(1.0, 1.002), IDouble(1.001, 1.0015), weight, r1}, rng);
+        }
+    }
+    DOCTEST_CHECK(check.contradicted == 0);
+    DOCTEST_CHECK(check.definite * 2 > boxes);
+}
+
+DOCTEST_TEST_CASE("[rectangle_cover] the tabulated check is indeterminate outside the table") {
+    auto tabulated = [] (IDouble lambda, IDouble r1) {
+        return Checker(IDouble(1.0), lambda, IDouble(100.0), r1).check_tabulated();
+    };
+    IBool below = Checker(IDouble(1.0, 1.002), IDouble(1.001, 1.0015), IDouble(100.0), IDouble(0.5)).check_tabulated();
+    DOCTEST_CHECK(possibly(below));
+    DOCTEST_CHECK(!definitely(below));
+    IBool above = tabulated(IDouble(4.99, 5.01), IDouble(0.5));
+    DOCTEST_CHECK(possibly(above));
+    DOCTEST_CHECK(!definitely(above));
+    IBool large_r1 = tabulated(IDouble(2.0), IDouble(3.999, 4.001));
+    DOCTEST_CHECK(possibly(large_r1));
+    DOCTEST_CHECK(!definitely(large_r1));
+    DOCTEST_CHECK(definitely(tabulated(IDouble(5.0), IDouble(4.0))));
+    DOCTEST_CHECK(definitely(tabulated(IDouble(1.0), IDouble(0.0))));
+}